@@ -0,0 +1,8 @@
+#! /usr/bin/env python3
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/scratch/ns3-dev-maqr-onoff-debug', 'build/scratch/ns3-dev-maqr-ping-debug', 'build/scratch/ns3-dev-manet-routing-compare-debug', 'build/scratch/ns3-dev-aodv-debug', 'build/scratch/ns3-dev-vanet-routing-compare-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = []
+
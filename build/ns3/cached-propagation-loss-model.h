@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-loss-model.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the reception powers computed by another
+ * PropagationLossModel between nodes which do not move.
+ *
+ * The reception power given by the wrapped model (and the models
+ * chained to it) is stored for each source, destination and
+ * transmission power, provided that neither the source nor the
+ * destination was moving.  It is reused as long as the position epochs
+ * of both mobility models (see MobilityModel::GetPositionEpoch) are
+ * unchanged, which saves the distance and logarithm computations for
+ * static networks and parked vehicles.  Moving nodes are never cached.
+ *
+ * The wrapped model must be deterministic and depend only on the
+ * positions: caching a model drawing random variables, such as
+ * NakagamiPropagationLossModel, freezes its draws.  Such models may be
+ * chained to this one instead, with SetNext.  Like SpatialGridIndex,
+ * this relies on mobility models notifying a course change whenever
+ * their velocity changes, which ConstantAccelerationMobilityModel
+ * does not.
+ *
+ * The cache is an open addressing hash table of fixed size; when the
+ * few slots where an entry may go are all taken, the entry replaces
+ * the first of them.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the model whose results are cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  /**
+   * \returns the model whose results are cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+  /**
+   * \returns the number of reception powers found in the cache
+   */
+  uint64_t GetHits (void) const;
+  /**
+   * \returns the number of reception powers computed by the wrapped model
+   */
+  uint64_t GetMisses (void) const;
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel & operator = (const CachedPropagationLossModel &);
+
+  virtual void DoDispose (void);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual bool DoIsMonotonic (void) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /** A cached reception power. */
+  struct Entry
+  {
+    const MobilityModel *a;  //!< the source, or null if the slot is free
+    const MobilityModel *b;  //!< the destination
+    double txPowerDbm;       //!< the transmission power (dBm)
+    uint64_t aEpoch;         //!< the position epoch of the source
+    uint64_t bEpoch;         //!< the position epoch of the destination
+    double rxPowerDbm;       //!< the reception power (dBm)
+  };
+
+  /**
+   * \param a the source
+   * \param b the destination
+   * \param txPowerDbm the transmission power (dBm)
+   * \returns the hash of the key of an entry
+   */
+  static uint64_t Hash (const MobilityModel *a, const MobilityModel *b, double txPowerDbm);
+
+  Ptr<PropagationLossModel> m_model;    //!< the model whose results are cached
+  uint32_t m_size;                      //!< the number of slots
+  mutable std::vector<Entry> m_entries; //!< the slots, allocated on first use
+  mutable uint64_t m_hits;              //!< number of cache hits
+  mutable uint64_t m_misses;            //!< number of cache misses
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
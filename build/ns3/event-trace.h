@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::EventTrace declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief Read and write the sequence of Scheduler operations
+ * performed by a simulation.
+ *
+ * A trace records every Scheduler::Insert, Scheduler::RemoveNext and
+ * Scheduler::Remove issued by the simulator, together with the
+ * EventKey of the event concerned.  Replaying a trace against a
+ * Scheduler reproduces exactly the event list workload of the
+ * original simulation, without running any model code; see
+ * utils/bench-simulator.cc.
+ *
+ * The file starts with an 8-byte magic string, followed by one
+ * record per operation: the operation code on one byte, then the
+ * time stamp, context and uid, each stored as a variable length
+ * integer relative to the previous record.  Typical records take
+ * five to eight bytes.
+ */
+class EventTrace
+{
+public:
+  /** Scheduler operation. */
+  enum Operation
+  {
+    INSERT = 0,       //!< Scheduler::Insert
+    REMOVE_NEXT = 1,  //!< Scheduler::RemoveNext
+    REMOVE = 2        //!< Scheduler::Remove
+  };
+
+  /** Constructor. */
+  EventTrace ();
+  /** Destructor; closes the file. */
+  ~EventTrace ();
+
+  /**
+   * Create a trace file, truncating any existing one.
+   *
+   * \param [in] filename The file name.
+   * \returns \c true on success.
+   */
+  bool OpenWrite (const std::string &filename);
+  /**
+   * Open an existing trace file.
+   *
+   * \param [in] filename The file name.
+   * \returns \c true on success, \c false if the file could not be
+   *          opened or is not an event trace.
+   */
+  bool OpenRead (const std::string &filename);
+  /** Flush and close the file. */
+  void Close (void);
+  /**
+   * \returns \c true if a file is currently open.
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * Append one operation to the trace.
+   *
+   * \param [in] op The operation.
+   * \param [in] key The key of the event inserted or removed.
+   */
+  void Write (Operation op, const Scheduler::EventKey &key);
+  /**
+   * Read the next operation from the trace.
+   *
+   * \param [out] op The operation.
+   * \param [out] key The key of the event inserted or removed.
+   * \returns \c false at the end of the trace.
+   */
+  bool Read (Operation &op, Scheduler::EventKey &key);
+
+private:
+  /**
+   * Write a signed delta as a zigzag-encoded variable length integer.
+   * \param [in] v The value.
+   */
+  void WriteDelta (int64_t v);
+  /**
+   * Read a zigzag-encoded variable length integer.
+   * \param [out] v The value.
+   * \returns \c false on end of file.
+   */
+  bool ReadDelta (int64_t &v);
+
+  std::fstream m_file;                //!< The trace file.
+  Scheduler::EventKey m_last;         //!< Key of the previous record.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_HASH_TABLE_H
+#define FLOW_HASH_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+
+namespace ns3 {
+
+/**
+ * \ingroup flow-monitor
+ * \brief Mix the bits of a 64 bit value, as the finalizer of
+ * SplitMix64, so that keys made of consecutive identifiers spread over
+ * the slots of a FlowHashTable.
+ * \param x the value
+ * \returns the mixed value
+ */
+inline uint64_t
+FlowHashMix (uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/**
+ * \ingroup flow-monitor
+ * \brief A hash table with open addressing and linear probing, used by
+ * the flow monitor to look up the flows and the packets in flight
+ * without allocating a node per entry.
+ *
+ * The number of slots is a power of two, and is doubled when more than
+ * half of them are used.  An erased entry is filled by shifting back
+ * the following entries of its probe sequence, so that lookups never
+ * go through tombstones.  Inserting or erasing an entry invalidates
+ * the pointers returned by Find and Insert.
+ *
+ * \tparam Key the type of the keys, compared with operator==
+ * \tparam Value the type of the values, default constructible
+ * \tparam Hash the type of a function object returning the 64 bit hash
+ * of a key
+ */
+template <typename Key, typename Value, typename Hash>
+class FlowHashTable
+{
+public:
+  FlowHashTable ();
+
+  /**
+   * \param key the key
+   * \returns the value of the key, or 0 if the key is not in the table
+   */
+  Value * Find (const Key &key);
+  /**
+   * \param key the key
+   * \returns the value of the key, or 0 if the key is not in the table
+   */
+  const Value * Find (const Key &key) const;
+  /**
+   * Insert a key with a default constructed value, unless it is already
+   * in the table.
+   * \param key the key
+   * \returns the value of the key, and whether the key was inserted
+   */
+  std::pair<Value *, bool> Insert (const Key &key);
+  /**
+   * \param key the key
+   * \returns whether the key was in the table
+   */
+  bool Erase (const Key &key);
+  /**
+   * \returns the number of entries
+   */
+  uint32_t GetSize (void) const;
+  /**
+   * Erase all the entries and release the slots.
+   */
+  void Clear (void);
+
+private:
+  /// A slot of the table
+  struct Slot
+  {
+    Key key;      //!< the key
+    Value value;  //!< the value
+    bool used;    //!< whether the slot holds an entry
+  };
+
+  /**
+   * \param key the key
+   * \returns the slot of the key, or the empty slot where it would go
+   */
+  uint32_t Probe (const Key &key) const;
+  /**
+   * Double the number of slots and insert the entries again.
+   */
+  void Grow (void);
+
+  std::vector<Slot> m_slots;  //!< the slots
+  uint32_t m_mask;            //!< the number of slots minus one
+  uint32_t m_size;            //!< the number of entries
+  Hash m_hash;                //!< the hash function
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename Key, typename Value, typename Hash>
+FlowHashTable<Key, Value, Hash>::FlowHashTable ()
+  : m_mask (0),
+    m_size (0)
+{
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t
+FlowHashTable<Key, Value, Hash>::Probe (const Key &key) const
+{
+  uint32_t i = static_cast<uint32_t> (m_hash (key)) & m_mask;
+  while (m_slots[i].used && !(m_slots[i].key == key))
+    {
+      i = (i + 1) & m_mask;
+    }
+  return i;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value *
+FlowHashTable<Key, Value, Hash>::Find (const Key &key)
+{
+  if (m_size == 0)
+    {
+      return 0;
+    }
+  Slot &slot = m_slots[Probe (key)];
+  return slot.used ? &slot.value : 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value *
+FlowHashTable<Key, Value, Hash>::Find (const Key &key) const
+{
+  if (m_size == 0)
+    {
+      return 0;
+    }
+  const Slot &slot = m_slots[Probe (key)];
+  return slot.used ? &slot.value : 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+std::pair<Value *, bool>
+FlowHashTable<Key, Value, Hash>::Insert (const Key &key)
+{
+  if (2 * (m_size + 1) > m_slots.size ())
+    {
+      Grow ();
+    }
+  Slot &slot = m_slots[Probe (key)];
+  if (slot.used)
+    {
+      return std::make_pair (&slot.value, false);
+    }
+  slot.key = key;
+  slot.value = Value ();
+  slot.used = true;
+  m_size++;
+  return std::make_pair (&slot.value, true);
+}
+
+template <typename Key, typename Value, typename Hash>
+bool
+FlowHashTable<Key, Value, Hash>::Erase (const Key &key)
+{
+  if (m_size == 0)
+    {
+      return false;
+    }
+  uint32_t hole = Probe (key);
+  if (!m_slots[hole].used)
+    {
+      return false;
+    }
+  // Shift back the entries which cannot be found anymore past the hole
+  uint32_t i = hole;
+  while (true)
+    {
+      i = (i + 1) & m_mask;
+      if (!m_slots[i].used)
+        {
+          break;
+        }
+      uint32_t home = static_cast<uint32_t> (m_hash (m_slots[i].key)) & m_mask;
+      if (((i - home) & m_mask) >= ((i - hole) & m_mask))
+        {
+          m_slots[hole] = m_slots[i];
+          hole = i;
+        }
+    }
+  m_slots[hole].used = false;
+  m_slots[hole].value = Value ();
+  m_size--;
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t
+FlowHashTable<Key, Value, Hash>::GetSize (void) const
+{
+  return m_size;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashTable<Key, Value, Hash>::Clear (void)
+{
+  std::vector<Slot> ().swap (m_slots);
+  m_mask = 0;
+  m_size = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashTable<Key, Value, Hash>::Grow (void)
+{
+  std::vector<Slot> old;
+  old.swap (m_slots);
+  uint32_t n = old.empty () ? 16 : 2 * old.size ();
+  Slot empty;
+  empty.key = Key ();
+  empty.value = Value ();
+  empty.used = false;
+  m_slots.assign (n, empty);
+  m_mask = n - 1;
+  for (typename std::vector<Slot>::iterator i = old.begin (); i != old.end (); ++i)
+    {
+      if (i->used)
+        {
+          m_slots[Probe (i->key)] = *i;
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* FLOW_HASH_TABLE_H */
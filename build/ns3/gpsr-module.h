@@ -0,0 +1,15 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_GPSR
+    
+
+// Module headers:
+#include "gpsr-helper.h"
+#include "gpsr-packet.h"
+#include "gpsr-ptable.h"
+#include "gpsr-rqueue.h"
+#include "gpsr.h"
+#endif
@@ -0,0 +1,150 @@
+#ifndef GPSR_PTABLE_H
+#define GPSR_PTABLE_H
+
+#include <map>
+#include <vector>
+#include <cassert>
+#include <stdint.h>
+#include "ns3/ipv4.h"
+#include "ns3/timer.h"
+#include <sys/types.h>
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/mobility-model.h"
+#include "ns3/vector.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/arp-cache.h"
+#include "ns3/random-variable-stream.h"
+#include <complex>
+
+namespace ns3 {
+namespace gpsr {
+
+/*
+ * \ingroup gpsr
+ * \brief Position table used by GPSR
+ */
+class PositionTable
+{
+public:
+  /// c-tor
+  PositionTable ();
+
+  /**
+   * \brief Gets the last time the entry was updated
+   * \param id Ipv4Address to get time of update from
+   * \return Time of last update to the position
+   */
+  Time GetEntryUpdateTime (Ipv4Address id);
+
+  /**
+   * \brief Adds entry in position table, and the MAC address of the
+   * neighbor, if known, to the ARP caches
+   * \param id the address of the neighbor
+   * \param position the position of the neighbor
+   * \param mac the MAC address of the neighbor, 00:00:00:00:00:00 if unknown
+   */
+  void AddEntry (Ipv4Address id, Vector position, Mac48Address mac = Mac48Address ());
+
+  /**
+   * \brief Deletes entry in position table
+   */
+  void DeleteEntry (Ipv4Address id);
+
+  /**
+   * \brief Gets position from position table
+   * \param id Ipv4Address to get position from
+   * \return Position of that id or NULL if not known
+   */
+  Vector GetPosition (Ipv4Address id);
+
+  /**
+   * \brief Checks if a node is a neighbour
+   * \param id Ipv4Address of the node to check
+   * \return True if the node is neighbour, false otherwise
+   */
+  bool isNeighbour (Ipv4Address id);
+
+  /**
+   * \brief Gets the number of neighbours in the table
+   * \return The number of entries
+   */
+  uint32_t GetNNeighbours () const;
+
+  /**
+   * \brief remove entries with expired lifetime
+   */
+  void Purge ();
+
+  /**
+   * \brief clears all entries
+   */
+  void Clear ();
+
+  /**
+   * \brief Add ARP cache to which the MAC addresses of the neighbors are added
+   * \param a pointer to the ARP cache to add
+   */
+  void AddArpCache (Ptr<ArpCache> a);
+  /**
+   * \brief Don't use given ARP cache any more (interface is down)
+   * \param a pointer to the ARP cache to delete
+   */
+  void DelArpCache (Ptr<ArpCache> a);
+
+  /**
+   * \Get Callback to ProcessTxError
+   */
+  Callback<void, WifiMacHeader const &> GetTxErrorCallback () const
+  {
+    return m_txErrorCallback;
+  }
+
+  /**
+   * \brief Gets next hop according to GPSR protocol
+   * \param position the position of the destination node
+   * \param nodePos the position of the node that has the packet
+   * \return Ipv4Address of the next hop, Ipv4Address::GetZero () if no nighbour was found in greedy mode
+   */
+  Ipv4Address BestNeighbor (Vector position, Vector nodePos);
+
+  bool IsInSearch (Ipv4Address id);
+
+  bool HasPosition (Ipv4Address id);
+
+  static Vector GetInvalidPosition ()
+  {
+    return Vector (-1, -1, 0);
+  }
+
+  /**
+   * \brief Gets next hop according to GPSR recovery-mode protocol (right hand rule)
+   * \param previousHop the position of the node that sent the packet to this node
+   * \param nodePos the position of the destination node
+   * \return Ipv4Address of the next hop, Ipv4Address::GetZero () if no nighbour was found in greedy mode
+   */
+  Ipv4Address BestAngle (Vector previousHop, Vector nodePos);
+
+  //Gives angle between the vector CentrePos-Refpos to the vector CentrePos-node counterclockwise
+  double GetAngle (Vector centrePos, Vector refPos, Vector node);
+
+
+
+private:
+  Time m_entryLifeTime;
+  std::map<Ipv4Address, std::pair<Vector, Time> > m_table;
+  // TX error callback
+  Callback<void, WifiMacHeader const &> m_txErrorCallback;
+  // Process layer 2 TX error notification
+  void ProcessTxError (WifiMacHeader const&);
+  // ARP caches to which the MAC addresses of the neighbors are added
+  std::vector<Ptr<ArpCache> > m_arp;
+
+
+
+
+};
+
+}   // gpsr
+} // ns3
+#endif /* GPSR_PTABLE_H */
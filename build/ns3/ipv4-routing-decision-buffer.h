@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_ROUTING_DECISION_BUFFER_H
+#define IPV4_ROUTING_DECISION_BUFFER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+#include "ns3/ipv4-routing-decision.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4Helpers
+ * \brief Record the routing decisions of the nodes in a ring buffer of
+ * fixed size, and write them to a binary file.
+ *
+ * By default, the buffer keeps the last decisions, and Write dumps
+ * them.  After SetFile, the buffer is instead written to the file each
+ * time it is full, so that all the decisions are recorded with a
+ * bounded memory.  The layout of the file, in host byte order, is:
+ \verbatim
+   char     magic[8]       "NS3RTDEC"
+   uint32_t version        1
+   uint32_t recordSize     48
+   Record   records[]      in time order
+ \endverbatim
+ * where a record holds, in this order, the time (int64_t, ns), the
+ * packet uid (uint64_t), the value (double), the node id, destination,
+ * next hop and number of neighbors (uint32_t each), and the exploration
+ * flag (uint8_t), padded to 48 bytes.
+ */
+class Ipv4RoutingDecisionBuffer
+{
+public:
+  /**
+   * \param capacity the number of decisions kept in memory
+   */
+  Ipv4RoutingDecisionBuffer (uint32_t capacity = 65536);
+  /**
+   * Flush the buffer to the file, if SetFile was called.
+   */
+  ~Ipv4RoutingDecisionBuffer ();
+
+  /**
+   * Connect to the RoutingDecision trace sources matching a path.
+   * \param path the configuration path of the trace sources
+   * \returns true if any trace source was connected
+   */
+  bool Connect (std::string path);
+  /**
+   * Connect to the RoutingDecision trace sources of the routing
+   * protocols of all the nodes.
+   * \returns true if any trace source was connected
+   */
+  bool ConnectAll (void);
+
+  /**
+   * Write the decisions to a file each time the buffer is full, and
+   * when Flush is called or the buffer is destroyed.
+   * \param filename the name of the file, which is created
+   */
+  void SetFile (std::string filename);
+  /**
+   * Write the decisions in the buffer to the file set by SetFile, and
+   * empty the buffer.
+   */
+  void Flush (void);
+  /**
+   * Write the decisions in the buffer to a new file.
+   * \param filename the name of the file
+   */
+  void Write (std::string filename) const;
+
+  /**
+   * Record a decision; this is the trace sink.
+   * \param decision the decision
+   */
+  void Record (const Ipv4RoutingDecision &decision);
+
+  /**
+   * \returns the number of decisions in the buffer
+   */
+  uint32_t GetSize (void) const;
+  /**
+   * \param i the index of a decision in the buffer, from the oldest one
+   * \returns the decision
+   */
+  Ipv4RoutingDecision Get (uint32_t i) const;
+  /**
+   * \returns the number of decisions recorded since the creation of
+   * the buffer, including those written or overwritten
+   */
+  uint64_t GetNRecorded (void) const;
+
+private:
+  /// A decision, as stored in the buffer and the file
+  struct Entry
+  {
+    int64_t time;          //!< the time of the decision (ns)
+    uint64_t packetUid;    //!< the uid of the packet
+    double value;          //!< the value of the next hop
+    uint32_t node;         //!< the id of the deciding node
+    uint32_t destination;  //!< the destination of the packet
+    uint32_t nextHop;      //!< the chosen next hop
+    uint32_t nNeighbors;   //!< the number of neighbors
+    uint8_t exploration;   //!< whether the next hop was explored
+    uint8_t padding[7];    //!< padding, zero
+  };
+
+  /**
+   * Write the header of a file.
+   * \param os the file
+   */
+  static void WriteHeader (std::ostream &os);
+  /**
+   * Write the decisions in the buffer, from the oldest one.
+   * \param os the file
+   */
+  void WriteEntries (std::ostream &os) const;
+
+  std::vector<Entry> m_entries;  //!< the ring buffer
+  uint32_t m_first;              //!< the index of the oldest decision
+  uint32_t m_size;               //!< the number of decisions in the buffer
+  uint64_t m_nRecorded;          //!< the number of decisions recorded
+  std::ofstream m_file;          //!< the file set by SetFile
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ROUTING_DECISION_BUFFER_H */
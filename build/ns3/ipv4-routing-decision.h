@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_ROUTING_DECISION_H
+#define IPV4_ROUTING_DECISION_H
+
+#include <ostream>
+#include <stdint.h>
+#include "ns3/nstime.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4Routing
+ * \brief The choice of the next hop of a packet by a routing protocol.
+ *
+ * Routing protocols which pick the next hop of each packet themselves,
+ * such as MAQR, PARRoT and GPSR, report their decisions through a
+ * "RoutingDecision" trace source carrying this structure, so that they
+ * can be analysed without logging.  The protocols only fill it when the
+ * trace source is connected.  Ipv4RoutingDecisionBuffer records them.
+ */
+struct Ipv4RoutingDecision
+{
+  Time time;                 //!< the time of the decision
+  uint32_t node;             //!< the id of the deciding node
+  uint64_t packetUid;        //!< the uid of the packet, 0 if the route is looked up without one
+  Ipv4Address destination;   //!< the destination of the packet
+  Ipv4Address nextHop;       //!< the chosen next hop
+  /**
+   * The value the protocol ranked the next hop with: the Q value for
+   * the Q-learning protocols, the distance from the next hop to the
+   * destination (m) for GPSR.
+   */
+  double value;
+  /**
+   * Whether the next hop was chosen otherwise than by its value: a
+   * random exploration for the Q-learning protocols, the recovery mode
+   * for GPSR.
+   */
+  bool exploration;
+  uint32_t nNeighbors;       //!< the number of neighbors the hop was chosen among
+
+  /**
+   * TracedCallback signature for routing decisions.
+   * \param [in] decision the decision
+   */
+  typedef void (* TracedCallback)(const Ipv4RoutingDecision &decision);
+};
+
+/**
+ * \brief Stream insertion operator.
+ * \param os the stream
+ * \param decision the decision
+ * \returns a reference to the stream
+ */
+std::ostream & operator << (std::ostream &os, const Ipv4RoutingDecision &decision);
+
+} // namespace ns3
+
+#endif /* IPV4_ROUTING_DECISION_H */
@@ -0,0 +1,17 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_MAQR
+    
+
+// Module headers:
+#include "maqr-helper.h"
+#include "maqr-neighbor.h"
+#include "maqr-packet.h"
+#include "maqr-rl-learning.h"
+#include "maqr-routing-protocol.h"
+#include "maqr-rqueue.h"
+#include "maqr-rtable.h"
+#endif
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_TRACE_RECORDER_H
+#define MOBILITY_TRACE_RECORDER_H
+
+#include <string>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/node-container.h"
+#include "ns3/waypoint.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Record the trajectories of nodes to a waypoint trace.
+ *
+ * The trajectory of each node is recorded as the piecewise-linear
+ * sequence of its positions at each course change, which is exact for
+ * the mobility models moving at constant velocity between course
+ * changes, such as RandomWaypointMobilityModel.  Jumps are recorded as
+ * two waypoints with the same time.  The trace written by Write is
+ * indexed by node id, and ReplayMobilityHelper replays it in later runs
+ * without computing the mobility again.
+ *
+ * The recorder must outlive the simulation, until Write is called.
+ * Each node only updates its own trajectory, so that recording works
+ * with the multithreaded simulator.
+ */
+class MobilityTraceRecorder
+{
+public:
+  MobilityTraceRecorder ();
+
+  /**
+   * Record the trajectories of the nodes, from now on.
+   * \param c the nodes, which must have a mobility model
+   */
+  void Install (NodeContainer c);
+  /**
+   * Record the trajectories of all the nodes of the global
+   * ns3::NodeList which have a mobility model, from now on.
+   */
+  void InstallAll (void);
+
+  /**
+   * Write the trajectories recorded until now; typically called after
+   * Simulator::Run and before Simulator::Destroy.
+   * \param filename the name of the waypoint trace
+   */
+  void Write (std::string filename) const;
+
+private:
+  /**
+   * Record the course change of a node.
+   * \param model the mobility model of the node
+   */
+  void CourseChange (Ptr<const MobilityModel> model);
+
+  /// The trajectory recorded for a node
+  struct Trajectory
+  {
+    std::vector<Waypoint> waypoints; //!< the waypoints
+    Vector velocity;                 //!< the velocity since the last waypoint
+  };
+  std::vector<Trajectory> m_trajectories; //!< the trajectories, indexed by node id
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_TRACE_RECORDER_H */
@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 CTTC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Nicola Baldo <nbaldo@cttc.es>
+ */
+
+
+#ifndef MULTI_MODEL_SPECTRUM_CHANNEL_H
+#define MULTI_MODEL_SPECTRUM_CHANNEL_H
+
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/spatial-grid-index.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ns3 {
+
+
+/**
+ * \ingroup spectrum
+ * Container: SpectrumModelUid_t, SpectrumConverter
+ */
+typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
+
+/**
+ * \ingroup spectrum
+ * The Tx spectrum model information. This class is used to convert
+ * one spectrum model into another one.
+ */
+class TxSpectrumModelInfo
+{
+public:
+  /**
+   * Constructor.
+   * \param txSpectrumModel the Tx Spectrum model.
+   */
+  TxSpectrumModelInfo (Ptr<const SpectrumModel> txSpectrumModel);
+
+  Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
+  SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  /**
+   * For each Rx SpectrumModel, the last Tx PSD which was converted to
+   * it, and the result of the conversion.
+   */
+  std::map<SpectrumModelUid_t, std::pair<Ptr<SpectrumValue>, Ptr<SpectrumValue> > > m_convertedPsdMap;
+};
+
+
+/**
+ * \ingroup spectrum
+ * Container: SpectrumModelUid_t, TxSpectrumModelInfo
+ */
+typedef std::map<SpectrumModelUid_t, TxSpectrumModelInfo> TxSpectrumModelInfoMap_t;
+
+
+/**
+ * \ingroup spectrum
+ * The Rx spectrum model information. This class is used to convert
+ * one spectrum model into another one.
+ */
+class RxSpectrumModelInfo
+{
+public:
+  /**
+   * Constructor.
+   * \param rxSpectrumModel the Rx Spectrum model.
+   */
+  RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumModel);
+
+  Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
+  std::vector<Ptr<SpectrumPhy> > m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+};
+
+/**
+ * \ingroup spectrum
+ * Container: SpectrumModelUid_t, RxSpectrumModelInfo
+ */
+typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap_t;
+
+
+/**
+ * \ingroup spectrum
+ *
+ * This SpectrumChannel implementation can handle the presence of
+ * SpectrumPhy instances which can use
+ * different spectrum models, i.e.,  different SpectrumModel. 
+ *
+ * \note It is allowed for a receiving SpectrumPhy to switch to a
+ * different SpectrumModel during the simulation. The requirement
+ * for this to work is that, after the SpectrumPhy switched its
+ * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
+ * called again passing the pointer to that SpectrumPhy.
+ *
+ * The conversion of a Tx PSD to each Rx SpectrumModel is kept, and
+ * reused by the next transmissions with the same PSD values.
+ *
+ * When the MaxInterferenceDistance attribute is set, the signals are
+ * only passed to the receivers within that distance of the transmitter,
+ * which are found with a SpatialGridIndex of the receivers instead of
+ * visiting all of them.  Receivers without a MobilityModel always get
+ * the signals.  This trades the accuracy of the weak interference
+ * for speed in large scenarios.
+ */
+class MultiModelSpectrumChannel : public SpectrumChannel
+{
+
+public:
+  MultiModelSpectrumChannel ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+
+  // inherited from Channel
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+
+protected:
+  void DoDispose ();
+
+private:
+  /**
+   * This method checks if m_rxSpectrumModelInfoMap contains an entry
+   * for the given TX SpectrumModel. If such entry exists, it returns
+   * an iterator pointing to it. If not, it creates a new entry in
+   * m_txSpectrumMpodelInfoMap, and returns an iterator to it.
+   *
+   * \param txSpectrumModel The TX SpectrumModel  being considered
+   *
+   * \return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
+   */
+  TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+
+  /**
+   * Convert a Tx PSD to a Rx SpectrumModel, or reuse the previous
+   * conversion of the same PSD values.
+   *
+   * \param txInfo the Tx SpectrumModel info
+   * \param rxSpectrumModelUid the Rx SpectrumModel
+   * \param txPsd the Tx PSD
+   * \return the converted PSD, or a null pointer if the models are orthogonal
+   */
+  Ptr<SpectrumValue> ConvertTxPsd (TxSpectrumModelInfo &txInfo, SpectrumModelUid_t rxSpectrumModelUid,
+                                   Ptr<const SpectrumValue> txPsd);
+
+  /**
+   * Find the receivers of a Rx SpectrumModel within
+   * MaxInterferenceDistance of a transmitter.
+   *
+   * \param rxInfoIterator the Rx SpectrumModel info
+   * \param txPosition the position of the transmitter
+   * \param candidates the indices of the receivers in m_rxPhys, in
+   *        increasing order
+   */
+  void FindCandidates (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator,
+                       const Vector &txPosition, std::vector<std::size_t> &candidates);
+
+  /**
+   * Used internally to reschedule transmission after the propagation delay.
+   *
+   * \param params The signal parameters.
+   * \param receiver A pointer to the receiver SpectrumPhy.
+   */
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+  /**
+   * Data structure holding, for each TX SpectrumModel,  all the
+   * converters to any RX SpectrumModel, and all the corresponding
+   * SpectrumPhy instances.
+   *
+   */
+  TxSpectrumModelInfoMap_t m_txSpectrumModelInfoMap;
+
+
+  /**
+   * Data structure holding, for each RX spectrum model, all the
+   * corresponding SpectrumPhy instances.
+   */
+  RxSpectrumModelInfoMap_t m_rxSpectrumModelInfoMap;
+
+  /**
+   * Number of devices connected to the channel.
+   */
+  std::size_t m_numDevices;
+
+  /**
+   * Mobility models of the receivers of the current transmission, for
+   * one RX spectrum model at a time.
+   */
+  std::vector<Ptr<MobilityModel> > m_rxMobilities;
+
+  /**
+   * Propagation gain to each of m_rxMobilities (dB).
+   */
+  std::vector<double> m_propagationGainsDb;
+
+  /** The receivers of a Rx SpectrumModel, indexed by position. */
+  struct RxIndex
+  {
+    SpatialGridIndex index;             //!< the receivers with a MobilityModel
+    std::vector<std::size_t> indexed;   //!< the position in m_rxPhys of each indexed receiver
+    std::vector<std::size_t> unindexed; //!< the position in m_rxPhys of the other receivers
+  };
+
+  double m_maxInterferenceDistance;                  //!< the maximum distance of a receiver, or zero
+  Time m_indexRefreshInterval;                       //!< the refresh interval of the indices
+  std::map<SpectrumModelUid_t, RxIndex> m_rxIndices; //!< the index of each Rx SpectrumModel, built on use
+  std::vector<std::size_t> m_candidates;             //!< the receivers to consider for the current transmission
+  std::vector<uint32_t> m_inRange;                   //!< the indexed receivers which may be in range
+
+};
+
+
+
+}
+
+
+
+#endif /* MULTI_MODEL_SPECTRUM_CHANNEL_H */
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "system-mutex.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A conservative parallel simulator implementation, running on
+ * shared-memory threads of a single process.
+ *
+ * Events are partitioned by context, that is by node: the events of
+ * node \c n belong to partition `n % Threads`, and each partition has
+ * its own Scheduler and is run by its own thread.  Events without a
+ * context (Simulator::NO_CONTEXT), such as the ones scheduled from
+ * the main program before Simulator::Run, belong to a global partition
+ * and are always run alone, by the main thread.
+ *
+ * The simulation advances in windows.  At the start of each window,
+ * every partition may safely run all its events earlier than the
+ * smallest pending time stamp plus the lookahead, in parallel with
+ * the other partitions.  Events scheduled by a partition for another
+ * one, with Simulator::ScheduleWithContext, are buffered and handed
+ * over to their partition at the barrier closing the window, in a
+ * deterministic order.
+ *
+ * The lookahead must be a lower bound of the delay of every event
+ * scheduled across partitions; for wireless networks this is the
+ * propagation delay between the closest nodes of different partitions,
+ * for instance YansWifiChannel::GetLookahead or
+ * SpectrumChannel::GetLookahead for a given distance threshold.
+ * Events which arrive in a partition which has already run past their
+ * time stamp, because they are scheduled between nodes closer than the
+ * threshold, are delayed up to the current time of their partition.
+ * This bounds the timing error by the lookahead, which trades accuracy
+ * for parallelism; these late events are counted and reported with
+ * NS_LOG_WARN at the end of Run().
+ *
+ * Models run concurrently must not share mutable state across nodes.
+ * In particular, reference counts (SimpleRefCount) and the
+ * copy-on-write buffers of Packet are not atomic, so objects may only
+ * be handed over to another node through events, and must not be
+ * referenced by the sender afterwards; user trace sinks shared by
+ * several nodes must do their own locking.  Simulator::Stop() called
+ * from a node event takes effect at the end of the current window,
+ * whereas Simulator::Stop(delay) is exact.  Events can not be
+ * scheduled from threads other than the simulation threads.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Get the number of events which were delayed because they were
+   * scheduled across partitions with less than the lookahead.
+   *
+   * \returns The number of late events.
+   */
+  uint64_t GetLateEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event scheduled for another partition during a window. */
+  struct PendingEvent
+  {
+    /** Absolute time stamp. */
+    uint64_t ts;
+    /** The event context. */
+    uint32_t context;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+
+  /** The events of a set of nodes, and their execution state. */
+  struct Partition
+  {
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /** Events scheduled for other partitions, indexed by partition. */
+    std::vector<std::vector<PendingEvent> > outbox;
+    /** Next event unique id. */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** Execution context of the current event. */
+    uint32_t currentContext;
+    /** The event count. */
+    uint64_t eventCount;
+    /** Number of events inserted but not yet run. */
+    int unscheduledEvents;
+  };
+
+  /**
+   * Create the partitions, or move the existing events to new
+   * schedulers.
+   *
+   * \param [in] schedulerFactory The factory of the partition schedulers.
+   */
+  void CreatePartitions (ObjectFactory schedulerFactory);
+  /**
+   * Get the partition of a context.
+   *
+   * \param [in] context The event context.
+   * \returns The partition index.
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * Get the partition run by the current thread.
+   *
+   * \returns The current partition.
+   */
+  Partition & GetCurrentPartition (void) const;
+  /**
+   * Insert an event in a partition.
+   *
+   * \param [in] partition The partition.
+   * \param [in] ts The absolute time stamp.
+   * \param [in] context The event context.
+   * \param [in] event The event implementation.
+   * \returns The event uid.
+   */
+  uint32_t Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Run the next event of a partition.
+   *
+   * \param [in] partition The partition.
+   */
+  void ProcessOneEvent (Partition &partition);
+  /** Hand over the events buffered during the last window. */
+  void DeliverPendingEvents (void);
+  /**
+   * Run the events of a partition until the end of the window.
+   *
+   * \param [in] index The partition index.
+   * \param [in] windowEnd The first time stamp not in the window.
+   */
+  void ProcessPartition (uint32_t index, uint64_t windowEnd);
+  /** Main loop of the worker threads. */
+  void RunWorker (void);
+
+  /** The partitions; the last one holds the events without context. */
+  std::vector<Partition> m_partitions;
+  /** Number of partitions of nodes, and of threads. */
+  uint32_t m_threads;
+  /** The lookahead. */
+  Time m_lookahead;
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+  /** Whether partitions are currently run in parallel. */
+  bool m_parallel;
+  /** End of the current window. */
+  uint64_t m_windowEnd;
+  /** Number of late events. */
+  uint64_t m_lateEvents;
+
+  /** The worker threads. */
+  std::vector<Ptr<SystemThread> > m_workers;
+  /** Index of the next worker thread to start. */
+  std::atomic<uint32_t> m_nextWorker;
+  /** Incremented by the main thread to start a window. */
+  std::atomic<uint64_t> m_window;
+  /** Number of worker threads still running the current window. */
+  std::atomic<uint32_t> m_running;
+  /** Flag asking the worker threads to exit. */
+  std::atomic<bool> m_exit;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Mutex protecting the destroy events. */
+  SystemMutex m_destroyEventsMutex;
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
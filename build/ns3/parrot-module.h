@@ -0,0 +1,16 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_PARROT
+    
+
+// Module headers:
+#include "parrot-helper.h"
+#include "parrot-packet.h"
+#include "parrot-routing-protocol.h"
+#include "parrot-rtable.h"
+#include "pce.h"
+#include "pdc.h"
+#endif
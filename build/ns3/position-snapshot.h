@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef POSITION_SNAPSHOT_H
+#define POSITION_SNAPSHOT_H
+
+#include "ns3/vector.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Opt-in snapshot of the positions of all the mobility models,
+ * taken once per time quantum.
+ *
+ * Models which fan out a signal or a beacon to many nodes, such as the
+ * channels and the position-based routing protocols, query the
+ * position of the same mobility models many times per simulated
+ * millisecond, and each query of a moving model goes through a virtual
+ * call and a ConstantVelocityHelper::Update.  When a quantum is set,
+ * with the PositionSnapshotQuantum global value or SetQuantum,
+ * GetPosition instead returns the position recorded in a contiguous
+ * array at the start of the current quantum.  The positions of the
+ * models which may have moved are recorded again by a single sweep at
+ * the first query of every quantum; a model whose course changed
+ * (see MobilityModel::GetPositionEpoch) is recorded again at its next
+ * query, so that jumps and stops are seen at once.
+ *
+ * The position of a moving model is thus late by up to one quantum,
+ * i.e., off by up to its speed times the quantum: 1 ms at 30 m/s is
+ * 3 cm.  With the default quantum of zero, GetPosition simply returns
+ * MobilityModel::GetPosition.  The snapshot holds a reference to every
+ * model it recorded until Simulator::Destroy, which also reverts the
+ * quantum to the PositionSnapshotQuantum global value.  It is shared
+ * by all the nodes, and thus may not be used with
+ * MultithreadedSimulatorImpl.
+ */
+class PositionSnapshot
+{
+public:
+  /**
+   * Set the quantum until the next Simulator::Destroy.
+   * \param quantum the time between two snapshots, or zero to disable them
+   */
+  static void SetQuantum (Time quantum);
+  /**
+   * \returns the time between two snapshots, zero if disabled
+   */
+  static Time GetQuantum (void);
+  /**
+   * \param mobility a mobility model
+   * \returns the position of the model at the start of the current
+   * quantum, or its current position if the snapshots are disabled
+   */
+  static Vector GetPosition (Ptr<const MobilityModel> mobility);
+  /**
+   * \param a a mobility model
+   * \param b another mobility model
+   * \returns the distance between the positions returned by GetPosition (m)
+   */
+  static double GetDistance (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+};
+
+} // namespace ns3
+
+#endif /* POSITION_SNAPSHOT_H */
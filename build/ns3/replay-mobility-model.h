@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLAY_MOBILITY_MODEL_H
+#define REPLAY_MOBILITY_MODEL_H
+
+#include <stdint.h>
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "mobility-model.h"
+#include "waypoint-trace-file.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief Replay the piecewise-linear trajectory of a node from a
+ * waypoint trace.
+ *
+ * The trajectory of the node is the sequence of its waypoints in a
+ * WaypointTraceFile, typically recorded by MobilityTraceRecorder in an
+ * earlier run.  The position and velocity are computed on demand by a
+ * binary search over the waypoints, without drawing random numbers nor
+ * keeping any state but the current time, so that runs which replay the
+ * same trace see the very same positions.  The model stays at its first
+ * waypoint before the time of that waypoint, and at its last one after
+ * it.  Waypoints with equal times are a jump to the last of them.
+ *
+ * The course change listeners are notified at the time of each
+ * waypoint, by a single pending event per model.
+ */
+class ReplayMobilityModel : public MobilityModel
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  ReplayMobilityModel ();
+  virtual ~ReplayMobilityModel ();
+
+  /**
+   * Set the trajectory to replay.
+   * \param file the waypoint trace
+   * \param node the node id of the trajectory in the trace
+   */
+  void SetTrace (Ptr<const WaypointTraceFile> file, uint32_t node);
+
+private:
+  virtual void DoInitialize (void);
+  virtual void DoDispose (void);
+  virtual Vector DoGetPosition (void) const;
+  /**
+   * The position of this model comes from its trace, so that setting
+   * it is a fatal error.
+   * \param position the position to set.
+   */
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+
+  /**
+   * \returns the first waypoint later than the current time
+   */
+  const WaypointTraceFile::Record * FindNext (void) const;
+  /**
+   * Notify the course change listeners, and schedule the next
+   * notification at the time of the next waypoint.
+   */
+  void CourseChange (void);
+  /**
+   * Schedule the next course change notification.
+   */
+  void ScheduleCourseChange (void);
+
+  Ptr<const WaypointTraceFile> m_file;     //!< the trace, kept mapped while replaying
+  const WaypointTraceFile::Record *m_begin; //!< the first waypoint of the node
+  const WaypointTraceFile::Record *m_end;   //!< past the last waypoint of the node
+  EventId m_event;                          //!< the next course change notification
+};
+
+} // namespace ns3
+
+#endif /* REPLAY_MOBILITY_MODEL_H */
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WAYPOINT_TRACE_HELPER_H
+#define WAYPOINT_TRACE_HELPER_H
+
+#include <string>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+#include "ns3/waypoint-trace-file.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief Helper class which moves nodes along the waypoints of a
+ * binary waypoint trace.
+ *
+ * The trace (see WaypointTraceFile) is mapped in memory, and each node
+ * gets a WaypointMobilityModel which is fed only a few waypoints ahead
+ * of the current time: one event per node adds the next waypoints
+ * before the model runs out of them.  Unlike Ns2MobilityHelper, which
+ * parses the whole text trace and schedules all its movements up
+ * front, installing is thus immediate and the scheduler holds a number
+ * of events proportional to the number of nodes, whatever the length
+ * of the trace.  Traces are produced by
+ * Ns2MobilityHelper::WriteWaypointTrace, e.g. with the
+ * ns2-to-waypoint-trace program.
+ *
+ * The helper must be installed before the first waypoint of the trace,
+ * typically before Simulator::Run.
+ */
+class WaypointTraceHelper
+{
+public:
+  /**
+   * \param filename the name of the waypoint trace
+   */
+  WaypointTraceHelper (std::string filename);
+
+  /**
+   * \param n the number of waypoints added to a model at once, at least 2
+   */
+  void SetWaypointsAhead (uint32_t n);
+  /**
+   * \returns the number of nodes in the trace
+   */
+  uint32_t GetNNodes (void) const;
+
+  /**
+   * Configure the movement of all the nodes of the global
+   * ns3::NodeList whose id matches a node of the trace.
+   */
+  void Install (void) const;
+  /**
+   * \param begin an iterator which points to the start of the input
+   *        object array.
+   * \param end an iterator which points to the end of the input
+   *        object array.
+   *
+   * Configure the movement of all the input objects.  Each object is
+   * identified by its index in the input array.
+   */
+  template <typename T>
+  void Install (T begin, T end) const;
+
+private:
+  /**
+   * Configure the movement of an object.
+   * \param object the object
+   * \param id the node id of the object in the trace
+   */
+  void InstallObject (Ptr<Object> object, uint32_t id) const;
+
+  Ptr<const WaypointTraceFile> m_file; //!< the mapped trace
+  uint32_t m_waypointsAhead;           //!< the number of waypoints added at once
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename T>
+void
+WaypointTraceHelper::Install (T begin, T end) const
+{
+  uint32_t id = 0;
+  for (T i = begin; i != end; ++i, ++id)
+    {
+      InstallObject (*i, id);
+    }
+}
+
+} // namespace ns3
+
+#endif /* WAYPOINT_TRACE_HELPER_H */
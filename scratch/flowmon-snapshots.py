@@ -0,0 +1,115 @@
+from __future__ import division
+import sys
+import struct
+
+## Columns of a snapshot, in the order of the binary and CSV formats,
+## with their struct type code
+COLUMNS = [('flowId', 'I'), ('txPackets', 'I'), ('txBytes', 'Q'),
+           ('rxPackets', 'I'), ('rxBytes', 'Q'), ('lostPackets', 'I'),
+           ('timesForwarded', 'I'), ('delaySum', 'q'), ('jitterSum', 'q')]
+
+## Magic number starting a binary snapshot file
+MAGIC = b'NS3FLSNP'
+
+## Snapshot
+class Snapshot(object):
+    ## class variables
+    ## @var time
+    #  time of the snapshot (ns)
+    ## @var flows
+    #  FlowId -> dict of the increments of the counters of the flow since the previous snapshot
+    ## @var __slots_
+    #  class variable list
+    __slots_ = ['time', 'flows']
+    def __init__(self, time):
+        '''! The initializer.
+        @param self The object pointer.
+        @param time The time of the snapshot (ns).
+        '''
+        self.time = time
+        self.flows = {}
+
+def read_binary(file_obj):
+    '''! Read the snapshots of a binary file written by FlowMonitor::EnableSnapshots.
+    @param file_obj The file, opened in binary mode, past the magic number.
+    @return A generator of Snapshot objects.
+    '''
+    version, = struct.unpack('=I', file_obj.read(4))
+    if version != 1:
+        raise ValueError("unsupported snapshot version %i" % version)
+    while True:
+        header = file_obj.read(12)
+        if len(header) < 12:
+            return
+        time, n = struct.unpack('=qI', header)
+        snapshot = Snapshot(time)
+        columns = []
+        for name, code in COLUMNS:
+            size = struct.calcsize('=' + code) * n
+            data = file_obj.read(size)
+            if len(data) < size:
+                return
+            columns.append(struct.unpack('=%i%s' % (n, code), data))
+        for i in range(n):
+            snapshot.flows[columns[0][i]] = dict((name, columns[c][i]) for c, (name, code) in enumerate(COLUMNS))
+        yield snapshot
+
+def read_csv(file_obj):
+    '''! Read the snapshots of a CSV file written by FlowMonitor::EnableSnapshots.
+    @param file_obj The file, opened in binary mode, past the first line.
+    @return A generator of Snapshot objects.
+    '''
+    snapshot = None
+    for line in file_obj:
+        values = [int(v) for v in line.decode().strip().split(',')]
+        if snapshot is None or snapshot.time != values[0]:
+            if snapshot is not None:
+                yield snapshot
+            snapshot = Snapshot(values[0])
+        snapshot.flows[values[1]] = dict((name, values[c + 1]) for c, (name, code) in enumerate(COLUMNS))
+    if snapshot is not None:
+        yield snapshot
+
+def read_snapshots(path):
+    '''! Read the snapshots of a file in either format.
+    @param path The name of the file.
+    @return A generator of Snapshot objects, in time order.
+    '''
+    with open(path, 'rb') as file_obj:
+        start = file_obj.read(len(MAGIC))
+        if start == MAGIC:
+            for snapshot in read_binary(file_obj):
+                yield snapshot
+        else:
+            file_obj.seek(0)
+            file_obj.readline()
+            for snapshot in read_csv(file_obj):
+                yield snapshot
+
+def main(argv):
+    if len(argv) < 2:
+        print("usage: %s SNAPSHOT-FILE [FLOW-ID]" % argv[0])
+        return 1
+    flow = int(argv[2]) if len(argv) > 2 else None
+    previous = 0
+    print("time(s)\ttx(pkt)\trx(pkt)\tlost(pkt)\tthroughput(kbit/s)\tmean delay(ms)\tmean hops")
+    for snapshot in read_snapshots(argv[1]):
+        totals = dict((name, 0) for name, code in COLUMNS)
+        for flowId, counters in snapshot.flows.items():
+            if flow is None or flowId == flow:
+                for name, code in COLUMNS:
+                    totals[name] += counters[name]
+        interval = (snapshot.time - previous) * 1e-9
+        previous = snapshot.time
+        throughput = totals['rxBytes'] * 8e-3 / interval if interval > 0 else 0
+        if totals['rxPackets']:
+            delay = "%.2f" % (totals['delaySum'] * 1e-6 / totals['rxPackets'])
+            hops = "%.2f" % (totals['timesForwarded'] / totals['rxPackets'] + 1)
+        else:
+            delay = hops = "None"
+        print("%.3f\t%i\t%i\t%i\t%.2f\t%s\t%s" % (snapshot.time * 1e-9, totals['txPackets'], totals['rxPackets'],
+                                                 totals['lostPackets'], throughput, delay, hops))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
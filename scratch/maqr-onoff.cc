@@ -43,6 +43,10 @@ private:
   uint32_t m_protocol;
   bool m_pcap;
   uint32_t m_mobilityModel;
+  std::string m_recordMobility;
+  std::string m_replayMobility;
+  double m_flowSnapshotInterval;
+  bool m_routingDecisions;
 };
 
 RoutingExperiment::RoutingExperiment ()
@@ -53,7 +57,11 @@ RoutingExperiment::RoutingExperiment ()
     m_traceMobility (false),
     m_protocol (1), // MAQR
     m_pcap (false),
-    m_mobilityModel (1)
+    m_mobilityModel (1),
+    m_recordMobility (""),
+    m_replayMobility (""),
+    m_flowSnapshotInterval (0),
+    m_routingDecisions (false)
 {
 }
 
@@ -127,12 +135,24 @@ std::string RoutingExperiment::CommandSetup (int argc, char **argv)
   cmd.AddValue ("traceMobility", "Enable mobility tracing", m_traceMobility);
   cmd.AddValue ("protocol", "1=MAQR;2=AODV;3=OLSR;4=DSDV;5=PARROT", m_protocol);
   cmd.AddValue ("mobilityModel", "1=ConstantPosition;2=RandomWaypoint", m_mobilityModel);
+  cmd.AddValue ("recordMobility", "Record the trajectories of the nodes to this waypoint trace", m_recordMobility);
+  cmd.AddValue ("replayMobility", "Replay the trajectories of this waypoint trace instead of mobilityModel", m_replayMobility);
+  cmd.AddValue ("flowSnapshotInterval", "Write the flow statistics to <CSVfileName>.flowsnap every this many seconds (0 to disable)", m_flowSnapshotInterval);
+  cmd.AddValue ("routingDecisions", "Record the next hops chosen by MAQR or PARROT to <CSVfileName>.decisions", m_routingDecisions);
   cmd.Parse (argc, argv);
   return m_CSVfileName;
 }
 
 void RoutingExperiment::SetMobilityModel (int nWifis, ns3::NodeContainer &adhocNodes)
 {
+  if (!m_replayMobility.empty ())
+  {
+    // Trajectories recorded by an earlier run with recordMobility, so
+    // that all the protocols see the very same positions
+    ReplayMobilityHelper replay (m_replayMobility);
+    replay.Install (adhocNodes);
+    return;
+  }
   switch (m_mobilityModel)
   {
     case 1:
@@ -329,15 +349,47 @@ void RoutingExperiment::Run (int nSinks, double txp, std::string CSVfileName)
   Ptr<FlowMonitor> flowmon;
   FlowMonitorHelper flowmonHelper;
   flowmon = flowmonHelper.InstallAll ();
+  if (m_flowSnapshotInterval > 0)
+  {
+    flowmon->EnableSnapshots (m_CSVfileName + ".flowsnap", Seconds (m_flowSnapshotInterval));
+  }
+
+  Ipv4RoutingDecisionBuffer decisions;
+  if (m_routingDecisions)
+  {
+    decisions.SetFile (m_CSVfileName + ".decisions");
+    decisions.ConnectAll ();
+  }
 
 
   NS_LOG_INFO ("Run Simulation.");
 
   CheckThroughput ();
 
+  MobilityTraceRecorder recorder;
+  if (!m_recordMobility.empty ())
+  {
+    recorder.Install (adhocNodes);
+  }
+
   Simulator::Stop (Seconds (totalTime));
   Simulator::Run ();
 
+  if (!m_recordMobility.empty ())
+  {
+    recorder.Write (m_recordMobility);
+  }
+
+  if (m_flowSnapshotInterval > 0)
+  {
+    flowmon->WriteSnapshot ();
+  }
+
+  if (m_routingDecisions)
+  {
+    decisions.Flush ();
+  }
+
   flowmon->SerializeToXmlFile ((m_CSVfileName + ".xml").c_str(), true, true);
 
   Simulator::Destroy ();
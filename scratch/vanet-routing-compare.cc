@@ -1212,6 +1212,9 @@ private:
   std::string m_traceFile; ///< trace file 
   std::string m_logFile; ///< log file
   uint32_t m_mobility; ///< mobility
+  std::string m_recordMobility; ///< waypoint trace to record the trajectories to
+  std::string m_replayMobility; ///< waypoint trace to replay the trajectories from
+  MobilityTraceRecorder m_mobilityRecorder; ///< recorder of the trajectories
   uint32_t m_nNodes; ///< number of nodes
   double m_TotalSimTime; ///< total sim time
   std::string m_rate; ///< rate
@@ -1276,6 +1279,8 @@ VanetRoutingExperiment::VanetRoutingExperiment ()
     m_traceFile (""),
     m_logFile ("low99-ct-unterstrass-1day.filt.7.adj.log"),
     m_mobility (1),
+    m_recordMobility (""),
+    m_replayMobility (""),
     m_nNodes (156),
     m_TotalSimTime (300.01),
     m_rate ("2048bps"),
@@ -1630,20 +1635,24 @@ VanetRoutingExperiment::ConfigureDevices ()
   // to determine the total amount of
   // data transmitted, and then used to calculate
   // the MAC/PHY overhead beyond the app-data
+  // the three paths share their nodes and devices, so they are
+  // resolved together
+  std::vector<std::pair<Config::ConfigPath, CallbackBase> > connections;
   if (m_80211mode == 3)
     {
       // WAVE
-      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/State/Tx", MakeCallback (&WifiPhyStats::PhyTxTrace, m_wifiPhyStats));
-      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/PhyTxDrop", MakeCallback (&WifiPhyStats::PhyTxDrop, m_wifiPhyStats));
-      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/PhyRxDrop", MakeCallback (&WifiPhyStats::PhyRxDrop, m_wifiPhyStats)); 
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/State/Tx"), MakeCallback (&WifiPhyStats::PhyTxTrace, m_wifiPhyStats)));
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/PhyTxDrop"), MakeCallback (&WifiPhyStats::PhyTxDrop, m_wifiPhyStats)));
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/$ns3::WaveNetDevice/PhyEntities/*/PhyRxDrop"), MakeCallback (&WifiPhyStats::PhyRxDrop, m_wifiPhyStats)));
     }
   else
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/Phy/State/Tx", MakeCallback (&WifiPhyStats::PhyTxTrace, m_wifiPhyStats));
-      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxDrop", MakeCallback (&WifiPhyStats::PhyTxDrop, m_wifiPhyStats));
-      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop", MakeCallback (&WifiPhyStats::PhyRxDrop, m_wifiPhyStats)); 
-}
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/Phy/State/Tx"), MakeCallback (&WifiPhyStats::PhyTxTrace, m_wifiPhyStats)));
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxDrop"), MakeCallback (&WifiPhyStats::PhyTxDrop, m_wifiPhyStats)));
+      connections.push_back (std::make_pair (Config::ConfigPath ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop"), MakeCallback (&WifiPhyStats::PhyRxDrop, m_wifiPhyStats)));
     }
+  Config::ConnectAll (connections);
+}
 
 void
 VanetRoutingExperiment::ConfigureMobility ()
@@ -1754,6 +1763,10 @@ VanetRoutingExperiment::Run ()
 
   Simulator::Stop (Seconds (m_TotalSimTime));
   Simulator::Run ();
+  if (!m_recordMobility.empty ())
+    {
+      m_mobilityRecorder.Write (m_recordMobility);
+    }
   Simulator::Destroy ();
 }
 
@@ -2065,6 +2078,8 @@ VanetRoutingExperiment::CommandSetup (int argc, char **argv)
   cmd.AddValue ("traceFile", "Ns2 movement trace file", m_traceFile);
   cmd.AddValue ("logFile", "Log file", m_logFile);
   cmd.AddValue ("mobility", "1=trace;2=RWP", m_mobility);
+  cmd.AddValue ("recordMobility", "Record the trajectories of the nodes to this waypoint trace", m_recordMobility);
+  cmd.AddValue ("replayMobility", "Replay the trajectories of this waypoint trace instead of mobility", m_replayMobility);
   cmd.AddValue ("rate", "Rate", m_rate);
   cmd.AddValue ("phyModeB", "Phy mode 802.11b", m_phyModeB);
   cmd.AddValue ("speed", "Node speed (m/s)", m_nodeSpeed);
@@ -2164,7 +2179,16 @@ VanetRoutingExperiment::ConfigureDefaults ()
 void
 VanetRoutingExperiment::SetupAdhocMobilityNodes ()
 {
-  if (m_mobility == 1)
+  if (!m_replayMobility.empty ())
+    {
+      // Trajectories recorded by an earlier run with recordMobility, so
+      // that all the protocols see the very same positions
+      ReplayMobilityHelper replay (m_replayMobility);
+      replay.Install (m_adhocTxNodes);
+      // initially assume all nodes are moving
+      WaveBsmHelper::GetNodesMoving ().resize (m_nNodes, 1);
+    }
+  else if (m_mobility == 1)
     {
       // Create Ns2MobilityHelper with the specified trace log file as parameter
       Ns2MobilityHelper ns2 = Ns2MobilityHelper (m_traceFile);
@@ -2202,6 +2226,11 @@ VanetRoutingExperiment::SetupAdhocMobilityNodes ()
       WaveBsmHelper::GetNodesMoving ().resize (m_nNodes, 1);
     }
 
+  if (!m_recordMobility.empty ())
+    {
+      m_mobilityRecorder.InstallAll ();
+    }
+
   // Configure callback for logging
   Config::Connect ("/NodeList/*/$ns3::MobilityModel/CourseChange",
                    MakeBoundCallback (&VanetRoutingExperiment::CourseChange, &m_os));
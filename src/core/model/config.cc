@@ -25,8 +25,11 @@
 #include "names.h"
 #include "pointer.h"
 #include "log.h"
+#include "simple-ref-count.h"
+#include "callback.h"
 
 #include <sstream>
+#include <map>
 
 /**
  * \file
@@ -182,6 +185,8 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, when the matcher is built.
  */
 class ArrayMatcher
 {
@@ -201,6 +206,12 @@ public:
   bool Matches (std::size_t i) const;
 
 private:
+  /**
+   * Parse the alternatives of a Config path specification.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -211,75 +222,79 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Whether any index matches. */
+  bool m_any;
+  /** The ranges of matching indexes, bounds included. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_any = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      Parse (element.substr (0, tmp - 0));
+      Parse (element.substr (tmp + 1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
-          && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && StringToUint32 (upperBound, &max))
         {
-          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-          return true;
-        }
-      else
-        {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any)
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+      NS_LOG_DEBUG ("Array " << i << " matches *");
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (i >= range->first && i <= range->second)
+        {
+          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
   return false;
 }
@@ -296,22 +311,152 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 
 /**
  * \ingroup config-impl
- * Abstract class to parse Config paths into object references.
+ * An element of a parsed Config path, with the attributes which
+ * match it in each type of object met so far.
+ */
+class PathElement
+{
+public:
+  /** A pointer or vector attribute matching the element. */
+  struct Attribute
+  {
+    std::string name;                           //!< The attribute name.
+    Ptr<const AttributeAccessor> accessor;      //!< The attribute getter, or 0 if it cannot be read directly.
+    bool isVector;                              //!< Whether the attribute is an ObjectPtrContainer.
+  };
+
+  /**
+   * Construct from a Config path element.
+   *
+   * \param [in] item The Config path element.
+   */
+  PathElement (std::string item);
+  /**
+   * Find the attributes matching the element in a type.
+   *
+   * \param [in] tid The type of an object on the Config path.
+   * \returns The pointer and vector attributes of the type and its
+   *          parents which match the element, in the order of the
+   *          search of the attributes of a type.
+   */
+  const std::vector<Attribute> & GetAttributes (TypeId tid) const;
+
+  /** The Config path element. */
+  std::string m_item;
+  /** Whether the element names an aggregated object, with a leading '$'. */
+  bool m_getObject;
+  /** Whether the TypeId of an aggregated object was found. */
+  bool m_tidFound;
+  /** The TypeId of an aggregated object. */
+  TypeId m_tid;
+  /** The element, as an index of an object vector. */
+  ArrayMatcher m_matcher;
+
+private:
+  /** The matching attributes, by TypeId uid. */
+  mutable std::map<uint16_t, std::vector<Attribute> > m_attributes;
+};
+
+PathElement::PathElement (std::string item)
+  : m_item (item),
+    m_getObject (item.find ("$") == 0),
+    m_tidFound (false),
+    m_matcher (item)
+{
+  NS_LOG_FUNCTION (this << item);
+  if (m_getObject)
+    {
+      m_tidFound = TypeId::LookupByNameFailSafe (item.substr (1, item.size () - 1), &m_tid);
+    }
+}
+
+const std::vector<PathElement::Attribute> &
+PathElement::GetAttributes (TypeId tid) const
+{
+  NS_LOG_FUNCTION (this << tid);
+  std::map<uint16_t, std::vector<Attribute> >::const_iterator found = m_attributes.find (tid.GetUid ());
+  if (found != m_attributes.end ())
+    {
+      return found->second;
+    }
+  std::vector<Attribute> &attributes = m_attributes[tid.GetUid ()];
+  TypeId instanceTid = tid;
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = tid.GetAttribute (i);
+          if (info.name != m_item && m_item != "*")
+            {
+              continue;
+            }
+          Attribute attribute;
+          attribute.name = info.name;
+          attribute.isVector = false;
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) == 0)
+            {
+              if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) == 0)
+                {
+                  // this could be anything else and we don't know what to do with it.
+                  // So, we just ignore it.
+                  continue;
+                }
+              attribute.isVector = true;
+            }
+          // ObjectBase::GetAttribute reads the first attribute of this
+          // name in the hierarchy, and reports the errors.
+          struct TypeId::AttributeInformation first;
+          if (instanceTid.LookupAttributeByName (info.name, &first)
+              && (first.flags & TypeId::ATTR_GET) && first.accessor->HasGetter ())
+            {
+              attribute.accessor = first.accessor;
+            }
+          attributes.push_back (attribute);
+        }
+      nextTid = tid.GetParent ();
+    }
+  while (nextTid != tid);
+  return attributes;
+}
+
+/**
+ * \ingroup config-impl
+ * A node of the tree of the elements of one or more parsed Config
+ * paths, where the paths sharing their leading elements share the
+ * nodes of these elements.
+ */
+struct PathNode
+{
+  /** The element of this node, or 0 for the root of the tree. */
+  const PathElement *element;
+  /** The nodes of the elements which follow this one. */
+  std::vector<PathNode> children;
+  /** The indexes of the paths which end with this element. */
+  std::vector<std::size_t> ends;
+};
+
+/**
+ * \ingroup config-impl
+ * Class to resolve parsed Config paths into object references.
+ *
+ * The objects matched by the paths are collected per path.
  */
 class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from the tree of the elements of parsed Config paths.
    *
-   * \param [in] path The Config path.
+   * \param [in] tree The root of the tree.
+   * \param [in] nPaths The number of paths of the tree.
    */
-  Resolver (std::string path);
-  /** Destructor. */
-  virtual ~Resolver ();
+  Resolver (const PathNode &tree, std::size_t nPaths);
 
   /**
-   * Parse the stored Config path into an object reference,
+   * Parse the Config paths into object references,
    * beginning at the indicated root object.
    *
    * \param [in] root The object corresponding to the current position in
@@ -319,79 +464,55 @@ public:
    */
   void Resolve (Ptr<Object> root);
 
+  /** The objects matched by each path. */
+  std::vector<std::vector<Ptr<Object> > > m_objects;
+  /** The context of each matched object. */
+  std::vector<std::vector<std::string> > m_contexts;
+
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
-   * Parse the next element in the Config path.
+   * Handle the paths ending at a node, and the following elements.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] node The node of the current element.
+   * \param [in] root The object matched by the current element.
+   */
+  void DoResolve (const PathNode &node, Ptr<Object> root);
+  /**
+   * Parse the element of a node.
+   *
+   * \param [in] node The node of the element.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolveElement (const PathNode &node, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] node The node of the vector attribute, whose children
+   *                  are the indexes.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
-  /**
-   * Handle one object found on the path.
-   *
-   * \param [in] object The current object on the Config path.
-   */
-  void DoResolveOne (Ptr<Object> object);
+  void DoArrayResolve (const PathNode &node, const ObjectPtrContainerValue &vector);
   /**
    * Get the current Config path.
    *
    * \returns The current Config path.
    */
   std::string GetResolvedPath (void) const;
-  /**
-   * Handle one found object.
-   *
-   * \param [in] object The found object.
-   * \param [in] path The matching Config path context.
-   */
-  virtual void DoOne (Ptr<Object> object, std::string path) = 0;
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The root of the tree of the Config paths. */
+  const PathNode &m_tree;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (const PathNode &tree, std::size_t nPaths)
+  : m_objects (nPaths),
+    m_contexts (nPaths),
+    m_tree (tree)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
-}
-Resolver::~Resolver ()
-{
-  NS_LOG_FUNCTION (this);
-}
-void
-Resolver::Canonicalize (void)
-{
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
+  NS_LOG_FUNCTION (this << &tree << nPaths);
 }
 
 void
@@ -399,7 +520,7 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (m_tree, root);
 }
 
 std::string
@@ -416,39 +537,40 @@ Resolver::GetResolvedPath (void) const
 }
 
 void
-Resolver::DoResolveOne (Ptr<Object> object)
+Resolver::DoResolve (const PathNode &node, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << object);
+  NS_LOG_FUNCTION (this << &node << root);
 
-  NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
+  //
+  // If root is zero, we're beginning to see if we can use the object name
+  // service to resolve this path.  It is impossible to have a object name
+  // associated with the root of the object name service since that root
+  // is not an object.  This path must be referring to something in another
+  // namespace and it will have been found already since the name service
+  // is always consulted last.
+  //
+  if (root && !node.ends.empty ())
+    {
+      std::string context = GetResolvedPath ();
+      NS_LOG_DEBUG ("resolved=" << context);
+      for (std::vector<std::size_t>::const_iterator i = node.ends.begin (); i != node.ends.end (); i++)
+        {
+          m_objects[*i].push_back (root);
+          m_contexts[*i].push_back (context);
+        }
+    }
+  for (std::vector<PathNode>::const_iterator i = node.children.begin (); i != node.children.end (); i++)
+    {
+      DoResolveElement (*i, root);
+    }
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolveElement (const PathNode &node, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-
-  if (next == std::string::npos)
-    {
-      //
-      // If root is zero, we're beginning to see if we can use the object name
-      // service to resolve this path.  It is impossible to have a object name
-      // associated with the root of the object name service since that root
-      // is not an object.  This path must be referring to something in another
-      // namespace and it will have been found already since the name service
-      // is always consulted last.
-      //
-      if (root)
-        {
-          DoResolveOne (root);
-        }
-      return;
-    }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  NS_LOG_FUNCTION (this << &node << root);
+  const PathElement &element = *node.element;
+  const std::string &item = element.m_item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +581,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (node, root);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +601,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (node, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -496,82 +617,67 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (element.m_getObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject=" << tidString << " on path=" << GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      NS_LOG_DEBUG ("GetObject=" << item << " on path=" << GetResolvedPath ());
+      TypeId tid = element.m_tid;
+      if (!element.m_tidFound)
+        {
+          tid = TypeId::LookupByName (item.substr (1, item.size () - 1));
+        }
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject (" << tidString << ") failed on path=" << GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject (" << item << ") failed on path=" << GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (node, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
+      const std::vector<PathElement::Attribute> &attributes = element.GetAttributes (root->GetInstanceTypeId ());
       bool foundMatch = false;
-
-      do
+      for (std::vector<PathElement::Attribute>::const_iterator i = attributes.begin (); i != attributes.end (); i++)
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          if (!i->isVector)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              if (i->accessor == 0 || !i->accessor->Get (PeekPointer (root), pValue))
                 {
-                  continue;
+                  root->GetAttribute (i->name, pValue);
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
+                  continue;
                 }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
+              foundMatch = true;
+              m_workStack.push_back (i->name);
+              DoResolve (node, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              foundMatch = true;
+              ObjectPtrContainerValue vector;
+              if (i->accessor == 0 || !i->accessor->Get (PeekPointer (root), vector))
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  root->GetAttribute (i->name, vector);
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.push_back (i->name);
+              DoArrayResolve (node, vector);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
         }
-      while (nextTid != tid);
 
       if (!foundMatch)
         {
@@ -582,34 +688,82 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (const PathNode &node, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
-    {
-      return;
-    }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  NS_LOG_FUNCTION (this << &node << &container);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
-  ObjectPtrContainerValue::Iterator it;
-  for (it = container.Begin (); it != container.End (); ++it)
+  for (std::vector<PathNode>::const_iterator index = node.children.begin (); index != node.children.end (); index++)
     {
-      if (matcher.Matches ((*it).first))
+      const ArrayMatcher &matcher = index->element->m_matcher;
+      ObjectPtrContainerValue::Iterator it;
+      for (it = container.Begin (); it != container.End (); ++it)
         {
-          std::ostringstream oss;
-          oss << (*it).first;
-          m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
-          m_workStack.pop_back ();
+          if (matcher.Matches ((*it).first))
+            {
+              std::ostringstream oss;
+              oss << (*it).first;
+              m_workStack.push_back (oss.str ());
+              DoResolve (*index, (*it).second);
+              m_workStack.pop_back ();
+            }
         }
     }
 }
 
+/**
+ * \ingroup config-impl
+ * A parsed Config path.
+ */
+struct ConfigPath::Plan : public SimpleRefCount<ConfigPath::Plan>
+{
+  /**
+   * Parse the path to some objects.
+   *
+   * \param [in] root The Config path of the objects.
+   */
+  Plan (std::string root);
+
+  /** The full Config path. */
+  std::string m_path;
+  /** The Config path of the objects, up to the final slash. */
+  std::string m_root;
+  /** The name of the attribute or trace source, after the final slash. */
+  std::string m_leaf;
+  /** The elements of the path of the objects. */
+  std::vector<PathElement> m_elements;
+};
+
+ConfigPath::Plan::Plan (std::string root)
+  : m_path (root),
+    m_root (root)
+{
+  NS_LOG_FUNCTION (this << root);
+
+  // ensure that we start and end with a '/'
+  std::string path = root;
+  std::string::size_type tmp = path.find ("/");
+  if (tmp != 0)
+    {
+      // no slash at start
+      path = "/" + path;
+    }
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
+    {
+      // no slash at end
+      path = path + "/";
+    }
+
+  std::string::size_type start = 0;
+  std::string::size_type next = path.find ("/", 1);
+  while (next != std::string::npos)
+    {
+      m_elements.push_back (PathElement (path.substr (start + 1, next - (start + 1))));
+      start = next;
+      next = path.find ("/", start + 1);
+    }
+}
+
 /**
  * \ingroup config-impl
  * Config system implementation class.
@@ -633,6 +787,18 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Look up the objects matched by parsed Config paths, resolving
+   * their shared leading elements once.
+   *
+   * \param [in] plans The parsed Config paths.
+   * \returns The objects matched by each path.
+   */
+  std::vector<MatchContainer> LookupMatches (const std::vector<Ptr<ConfigPath::Plan> > &plans);
+  /** \copydoc Config::ConnectAllFailSafe() */
+  bool ConnectAllFailSafe (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections);
+  /** \copydoc Config::ConnectAll() */
+  void ConnectAll (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -751,21 +917,40 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
-  class LookupMatchesResolver : public Resolver
-  {
-public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
-    {
-    }
-    virtual void DoOne (Ptr<Object> object, std::string path)
+  return LookupMatches (std::vector<Ptr<ConfigPath::Plan> > (1, Create<ConfigPath::Plan> (path)))[0];
+}
+
+std::vector<MatchContainer>
+ConfigImpl::LookupMatches (const std::vector<Ptr<ConfigPath::Plan> > &plans)
+{
+  NS_LOG_FUNCTION (this << plans.size ());
+
+  // Merge the leading elements shared by the paths
+  PathNode tree;
+  tree.element = 0;
+  for (std::size_t i = 0; i < plans.size (); i++)
     {
-      m_objects.push_back (object);
-      m_contexts.push_back (path);
+      PathNode *node = &tree;
+      for (std::vector<PathElement>::const_iterator element = plans[i]->m_elements.begin ();
+           element != plans[i]->m_elements.end (); element++)
+        {
+          std::vector<PathNode>::iterator child = node->children.begin ();
+          while (child != node->children.end () && child->element->m_item != element->m_item)
+            {
+              child++;
+            }
+          if (child == node->children.end ())
+            {
+              PathNode newNode;
+              newNode.element = &*element;
+              child = node->children.insert (child, newNode);
+            }
+          node = &*child;
+        }
+      node->ends.push_back (i);
     }
-    std::vector<Ptr<Object> > m_objects;
-    std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+
+  Resolver resolver = Resolver (tree, plans.size ());
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -778,7 +963,49 @@ public:
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  std::vector<MatchContainer> containers;
+  for (std::size_t i = 0; i < plans.size (); i++)
+    {
+      containers.push_back (MatchContainer (resolver.m_objects[i], resolver.m_contexts[i], plans[i]->m_root));
+    }
+  return containers;
+}
+
+bool
+ConfigImpl::ConnectAllFailSafe (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (this << connections.size ());
+  std::vector<Ptr<ConfigPath::Plan> > plans;
+  for (std::size_t i = 0; i < connections.size (); i++)
+    {
+      plans.push_back (connections[i].first.m_plan);
+    }
+  std::vector<MatchContainer> containers = LookupMatches (plans);
+  bool ok = true;
+  for (std::size_t i = 0; i < connections.size (); i++)
+    {
+      ok &= containers[i].ConnectFailSafe (plans[i]->m_leaf, connections[i].second);
+    }
+  return ok;
+}
+
+void
+ConfigImpl::ConnectAll (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (this << connections.size ());
+  std::vector<Ptr<ConfigPath::Plan> > plans;
+  for (std::size_t i = 0; i < connections.size (); i++)
+    {
+      plans.push_back (connections[i].first.m_plan);
+    }
+  std::vector<MatchContainer> containers = LookupMatches (plans);
+  for (std::size_t i = 0; i < connections.size (); i++)
+    {
+      if (!containers[i].ConnectFailSafe (plans[i]->m_leaf, connections[i].second))
+        {
+          NS_FATAL_ERROR ("Could not connect callback to " << plans[i]->m_path);
+        }
+    }
 }
 
 void
@@ -967,6 +1194,124 @@ Ptr<Object> GetRootNamespaceObject (uint32_t i)
   return ConfigImpl::Get ()->GetRootNamespaceObject (i);
 }
 
+ConfigPath::ConfigPath ()
+  : m_plan (Create<Plan> (""))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ConfigPath::ConfigPath (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT_MSG (slash != std::string::npos, "Invalid Config path " << path);
+  m_plan = Create<Plan> (path.substr (0, slash));
+  m_plan->m_path = path;
+  m_plan->m_leaf = path.substr (slash + 1, path.size () - (slash + 1));
+}
+
+ConfigPath::ConfigPath (const ConfigPath &o)
+  : m_plan (o.m_plan)
+{
+  NS_LOG_FUNCTION (this << &o);
+}
+
+ConfigPath &
+ConfigPath::operator = (const ConfigPath &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  m_plan = o.m_plan;
+  return *this;
+}
+
+ConfigPath::~ConfigPath ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::string
+ConfigPath::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_plan->m_path;
+}
+
+std::string
+ConfigPath::GetLeaf (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_plan->m_leaf;
+}
+
+MatchContainer
+ConfigPath::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return ConfigImpl::Get ()->LookupMatches (std::vector<Ptr<Plan> > (1, m_plan))[0];
+}
+
+void
+ConfigPath::Set (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << &value);
+  LookupMatches ().Set (m_plan->m_leaf, value);
+}
+
+bool
+ConfigPath::SetFailSafe (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << &value);
+  return LookupMatches ().SetFailSafe (m_plan->m_leaf, value);
+}
+
+void
+ConfigPath::Connect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  if (!ConnectFailSafe (cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << m_plan->m_path);
+    }
+}
+
+bool
+ConfigPath::ConnectFailSafe (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  return LookupMatches ().ConnectFailSafe (m_plan->m_leaf, cb);
+}
+
+void
+ConfigPath::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  if (!ConnectWithoutContextFailSafe (cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << m_plan->m_path);
+    }
+}
+
+bool
+ConfigPath::ConnectWithoutContextFailSafe (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  return LookupMatches ().ConnectWithoutContextFailSafe (m_plan->m_leaf, cb);
+}
+
+void
+ConnectAll (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  ConfigImpl::Get ()->ConnectAll (connections);
+}
+
+bool
+ConnectAllFailSafe (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  return ConfigImpl::Get ()->ConnectAllFailSafe (connections);
+}
+
 } // namespace Config
 
 } // namespace ns3
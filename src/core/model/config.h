@@ -23,6 +23,7 @@
 #include "ptr.h"
 #include <string>
 #include <vector>
+#include <utility>
 
 /**
  * \file
@@ -314,6 +315,123 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, to be resolved many times.
+ *
+ * The path is split into its elements when the ConfigPath is built:
+ * the index expressions such as <tt>[0-3]|5</tt> are parsed, and the
+ * TypeId of the <tt>$ns3::Type</tt> elements are looked up.  While
+ * the path is resolved, the pointer and vector attributes matching
+ * each element are remembered for each type of object met, so that
+ * the attributes of every other object of the same type are not
+ * searched again.  Copies of a ConfigPath share these data, so that
+ * resolving a path again, or over thousands of nodes, mostly costs
+ * the walk through the objects.
+ *
+ * The methods behave as the Config functions of the same name called
+ * with the path.
+ */
+class ConfigPath
+{
+public:
+  /** Create an empty path, which matches the root namespace objects. */
+  ConfigPath ();
+  /**
+   * \param [in] path The path, whose last element names an attribute
+   *                  or a trace source.
+   */
+  ConfigPath (std::string path);
+  /**
+   * Copy constructor, which shares the parsed path.
+   * \param [in] o The ConfigPath to copy.
+   */
+  ConfigPath (const ConfigPath &o);
+  /**
+   * Assignment operator, which shares the parsed path.
+   * \param [in] o The ConfigPath to copy.
+   * \returns This ConfigPath.
+   */
+  ConfigPath & operator = (const ConfigPath &o);
+  ~ConfigPath ();
+
+  /** \returns The path. */
+  std::string GetPath (void) const;
+  /** \returns The name of the attribute or trace source of the path. */
+  std::string GetLeaf (void) const;
+  /**
+   * \returns A container of the objects which hold the attribute or the
+   *          trace source of the path.
+   */
+  MatchContainer LookupMatches (void) const;
+  /**
+   * \param [in] value The value to set in all matching attributes.
+   * \sa Config::Set
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \param [in] value The value to set in all matching attributes.
+   * \returns \c true if any matching attributes could be set.
+   * \sa Config::SetFailSafe
+   */
+  bool SetFailSafe (const AttributeValue &value) const;
+  /**
+   * \param [in] cb The sink to connect to the matching trace sources.
+   * \sa Config::Connect
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to connect to the matching trace sources.
+   * \returns \c true if any trace sources could be connected.
+   * \sa Config::ConnectFailSafe
+   */
+  bool ConnectFailSafe (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to connect to the matching trace sources.
+   * \sa Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to connect to the matching trace sources.
+   * \returns \c true if any trace sources could be connected.
+   * \sa Config::ConnectWithoutContextFailSafe
+   */
+  bool ConnectWithoutContextFailSafe (const CallbackBase &cb) const;
+
+private:
+  friend class ConfigImpl;
+  struct Plan;
+  /** The parsed path, shared by the copies. */
+  Ptr<Plan> m_plan;
+};
+
+/**
+ * \ingroup config
+ * Connect many sinks, each to the trace sources matched by its path,
+ * with a context, as Config::Connect does.
+ *
+ * The paths are resolved together: the objects matched by the leading
+ * elements shared by several paths, such as all the devices of all the
+ * nodes, are looked up only once.
+ * This method raises a fatal error if any path matches no trace
+ * source.
+ *
+ * \param [in] connections The paths, and the sink to connect to the
+ *                         trace sources matched by each path.
+ */
+void ConnectAll (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections);
+/**
+ * \ingroup config
+ * Connect many sinks, each to the trace sources matched by its path,
+ * as ConnectAll does, without raising an error.
+ *
+ * \param [in] connections The paths, and the sink to connect to the
+ *                         trace sources matched by each path.
+ * \returns \c true if every path could be connected to some trace
+ *          source.
+ */
+bool ConnectAllFailSafe (const std::vector<std::pair<ConfigPath, CallbackBase> > &connections);
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
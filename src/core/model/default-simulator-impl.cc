@@ -25,8 +25,11 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "string.h"
+#include "boolean.h"
 #include "assert.h"
 #include "log.h"
+#include "fatal-error.h"
 
 #include <cmath>
 
@@ -53,6 +56,19 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventTraceFile",
+                   "Record every event inserted in and removed from the "
+                   "event list to this file, for replay by bench-simulator. "
+                   "Recording is disabled if empty.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::SetEventTraceFile),
+                   MakeStringChecker ())
+    .AddAttribute ("EventPool",
+                   "Allocate events from a pool of recycled memory, "
+                   "instead of the heap.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::SetEventPool),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -72,7 +88,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
   m_eventCount = 0;
-  m_eventsWithContextEmpty = true;
+  m_eventsWithContext = 0;
   m_main = SystemThread::Self ();
 }
 
@@ -93,6 +109,7 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  m_eventTrace.Close ();
   SimulatorImpl::DoDispose ();
 }
 void
@@ -128,6 +145,34 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
   m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetEventTraceFile (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_eventTrace.Close ();
+  if (filename != "" && !m_eventTrace.OpenWrite (filename))
+    {
+      NS_FATAL_ERROR ("Cannot open event trace file " << filename);
+    }
+}
+
+void
+DefaultSimulatorImpl::SetEventPool (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  EventImpl::EnablePool (enable);
+}
+
+void
+DefaultSimulatorImpl::InsertEvent (const Scheduler::Event &ev)
+{
+  if (m_eventTrace.IsOpen ())
+    {
+      m_eventTrace.Write (EventTrace::INSERT, ev.key);
+    }
+  m_events->Insert (ev);
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId (void) const
@@ -139,6 +184,10 @@ void
 DefaultSimulatorImpl::ProcessOneEvent (void)
 {
   Scheduler::Event next = m_events->RemoveNext ();
+  if (m_eventTrace.IsOpen ())
+    {
+      m_eventTrace.Write (EventTrace::REMOVE_NEXT, next.key);
+    }
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
@@ -163,30 +212,37 @@ DefaultSimulatorImpl::IsFinished (void) const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  if (m_eventsWithContext.load (std::memory_order_relaxed) == 0)
     {
       return;
     }
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap (eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  // Take the whole stack at once, other threads keep pushing on
+  // a new empty one.
+  EventWithContext *batch = m_eventsWithContext.exchange (0, std::memory_order_acquire);
+  // The stack holds the most recent event first: reverse it, so that
+  // events are inserted in the order they were scheduled.
+  EventWithContext *events = 0;
+  while (batch != 0)
+    {
+      EventWithContext *next = batch->next;
+      batch->next = events;
+      events = batch;
+      batch = next;
+    }
+  while (events != 0)
     {
-      EventWithContext event = eventsWithContext.front ();
-      eventsWithContext.pop_front ();
       Scheduler::Event ev;
-      ev.impl = event.event;
-      ev.key.m_ts = m_currentTs + event.timestamp;
-      ev.key.m_context = event.context;
+      ev.impl = events->event;
+      ev.key.m_ts = m_currentTs + events->timestamp;
+      ev.key.m_context = events->context;
       ev.key.m_uid = m_uid;
       m_uid++;
       m_unscheduledEvents++;
-      m_events->Insert (ev);
+      InsertEvent (ev);
+      EventWithContext *next = events->next;
+      delete events;
+      events = next;
     }
 }
 
@@ -242,7 +298,7 @@ DefaultSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
   ev.key.m_uid = m_uid;
   m_uid++;
   m_unscheduledEvents++;
-  m_events->Insert (ev);
+  InsertEvent (ev);
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -261,20 +317,22 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       ev.key.m_uid = m_uid;
       m_uid++;
       m_unscheduledEvents++;
-      m_events->Insert (ev);
+      InsertEvent (ev);
     }
   else
     {
-      EventWithContext ev;
-      ev.context = context;
+      EventWithContext *ev = new EventWithContext;
+      ev->context = context;
       // Current time added in ProcessEventsWithContext()
-      ev.timestamp = delay.GetTimeStep ();
-      ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back (ev);
-        m_eventsWithContextEmpty = false;
-      }
+      ev->timestamp = delay.GetTimeStep ();
+      ev->event = event;
+      ev->next = m_eventsWithContext.load (std::memory_order_relaxed);
+      while (!m_eventsWithContext.compare_exchange_weak (ev->next, ev,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed))
+        {
+          // ev->next was updated to the current top of the stack, retry.
+        }
     }
 }
 
@@ -290,7 +348,7 @@ DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
   ev.key.m_uid = m_uid;
   m_uid++;
   m_unscheduledEvents++;
-  m_events->Insert (ev);
+  InsertEvent (ev);
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -351,6 +409,10 @@ DefaultSimulatorImpl::Remove (const EventId &id)
   event.key.m_context = id.GetContext ();
   event.key.m_uid = id.GetUid ();
   m_events->Remove (event);
+  if (m_eventTrace.IsOpen ())
+    {
+      m_eventTrace.Write (EventTrace::REMOVE, event.key);
+    }
   event.impl->Cancel ();
   // whenever we remove an event from the event list, we have to unref it.
   event.impl->Unref ();
@@ -24,11 +24,12 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-trace.h"
 #include "system-thread.h"
-#include "system-mutex.h"
 
 #include "ptr.h"
 
+#include <atomic>
 #include <list>
 
 /**
@@ -86,8 +87,33 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+  /**
+   * Insert an event in the event list, recording it in the event
+   * trace if enabled.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertEvent (const Scheduler::Event &ev);
+  /**
+   * Start recording the scheduler operations to a file.
+   *
+   * \param [in] filename The file name; empty to stop recording.
+   */
+  void SetEventTraceFile (std::string filename);
+  /**
+   * Enable or disable the allocation of events from the event pool.
+   *
+   * \param [in] enable \c true to use the pool.
+   * \see EventImpl::EnablePool
+   */
+  void SetEventPool (bool enable);
 
-  /** Wrap an event with its execution context. */
+  /**
+   * Wrap an event with its execution context.
+   *
+   * These are the nodes of an intrusive lock-free stack, which other
+   * threads push on and the main thread drains in one batch.
+   */
   struct EventWithContext
   {
     /** The event context. */
@@ -96,18 +122,14 @@ private:
     uint64_t timestamp;
     /** The event implementation. */
     EventImpl *event;
+    /** The event pushed before this one. */
+    EventWithContext *next;
   };
-  /** Container type for the events from a different context. */
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
-  EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * The most recent event scheduled from a different thread, or 0 if
+   * all events with context have been moved to the primary event queue.
    */
-  bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
-  SystemMutex m_eventsWithContextMutex;
+  std::atomic<EventWithContext *> m_eventsWithContext;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
@@ -136,6 +158,8 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+  /** Recording of the scheduler operations, if enabled. */
+  EventTrace m_eventTrace;
 };
 
 } // namespace ns3
@@ -20,6 +20,8 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include <atomic>
+#include <new>
 
 /**
  * \file
@@ -27,6 +29,64 @@
  * ns3::EventImpl definitions.
  */
 
+namespace {
+
+/** Granularity of the event pool size classes, in bytes. */
+const std::size_t g_eventPoolGranularity = 16;
+/** Number of event pool size classes; larger events use the heap. */
+const std::size_t g_eventPoolClasses = 16;
+/** Number of events allocated at once when a free list is empty. */
+const std::size_t g_eventPoolChunk = 64;
+
+/**
+ * Header in front of every event, recording where it was allocated
+ * from.  The union keeps the event itself suitably aligned.
+ */
+union EventHeader
+{
+  std::size_t sizeClass;    //!< Pool size class, or 0 if allocated from the heap.
+  std::max_align_t align;   //!< Alignment of the event following the header.
+};
+
+/** A free event in the pool. */
+struct EventFreeBlock
+{
+  EventFreeBlock *next;     //!< Next free event of the same size class.
+};
+
+/**
+ * Free lists of the event pool, indexed by size class.
+ *
+ * Lists are per thread so that events scheduled from other threads
+ * (e.g. by emulation devices) do not need any locking; an event freed
+ * by another thread than the one which allocated it simply moves to
+ * the free list of that thread.  Pool memory is never returned to the
+ * heap.
+ */
+thread_local EventFreeBlock *g_eventFreeLists[g_eventPoolClasses + 1];
+
+/** Whether new events are allocated from the pool. */
+std::atomic<bool> g_eventPoolEnabled (false);
+
+/**
+ * Allocate a new chunk of events for a size class.
+ * \param [in] sizeClass The size class.
+ */
+void
+RefillEventFreeList (std::size_t sizeClass)
+{
+  std::size_t blockSize = sizeClass * g_eventPoolGranularity;
+  char *chunk = static_cast<char *> (::operator new (g_eventPoolChunk * blockSize));
+  for (std::size_t i = 0; i < g_eventPoolChunk; ++i)
+    {
+      EventFreeBlock *block = reinterpret_cast<EventFreeBlock *> (chunk + i * blockSize);
+      block->next = g_eventFreeLists[sizeClass];
+      g_eventFreeLists[sizeClass] = block;
+    }
+}
+
+} // unnamed namespace
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
@@ -66,4 +126,66 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void *
+EventImpl::operator new (std::size_t size)
+{
+  // Do not add function logging here, events are allocated on every
+  // Simulator::Schedule.
+  std::size_t total = size + sizeof (EventHeader);
+  std::size_t sizeClass = (total + g_eventPoolGranularity - 1) / g_eventPoolGranularity;
+  EventHeader *header;
+  if (!g_eventPoolEnabled.load (std::memory_order_relaxed)
+      || sizeClass > g_eventPoolClasses)
+    {
+      header = static_cast<EventHeader *> (::operator new (total));
+      header->sizeClass = 0;
+    }
+  else
+    {
+      if (g_eventFreeLists[sizeClass] == 0)
+        {
+          RefillEventFreeList (sizeClass);
+        }
+      EventFreeBlock *block = g_eventFreeLists[sizeClass];
+      g_eventFreeLists[sizeClass] = block->next;
+      header = reinterpret_cast<EventHeader *> (block);
+      header->sizeClass = sizeClass;
+    }
+  return header + 1;
+}
+
+void
+EventImpl::operator delete (void *p)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  EventHeader *header = static_cast<EventHeader *> (p) - 1;
+  std::size_t sizeClass = header->sizeClass;
+  if (sizeClass == 0)
+    {
+      ::operator delete (header);
+    }
+  else
+    {
+      EventFreeBlock *block = reinterpret_cast<EventFreeBlock *> (header);
+      block->next = g_eventFreeLists[sizeClass];
+      g_eventFreeLists[sizeClass] = block;
+    }
+}
+
+void
+EventImpl::EnablePool (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+  g_eventPoolEnabled.store (enable, std::memory_order_relaxed);
+}
+
+bool
+EventImpl::IsPoolEnabled (void)
+{
+  return g_eventPoolEnabled.load (std::memory_order_relaxed);
+}
+
 } // namespace ns3
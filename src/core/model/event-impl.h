@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -66,6 +67,39 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate memory for an event.
+   *
+   * If the event pool is enabled, and the event is small enough,
+   * the memory is recycled from a per-thread free list of events of
+   * the same size class instead of the global heap.
+   *
+   * \param [in] size The size of the event object.
+   * \returns The allocated memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event, back to the event pool if it
+   * was allocated from it.
+   *
+   * \param [in] p The event memory.
+   */
+  static void operator delete (void *p);
+  /**
+   * Enable or disable the event pool for subsequent allocations.
+   *
+   * Events already allocated are released where they came from, so
+   * the pool can be toggled at any time.  This is usually set through
+   * the DefaultSimulatorImpl::EventPool attribute.
+   *
+   * \param [in] enable \c true to allocate events from the pool.
+   */
+  static void EnablePool (bool enable);
+  /**
+   * \returns \c true if events are allocated from the event pool.
+   */
+  static bool IsPoolEnabled (void);
+
 protected:
   /**
    * Implementation for Invoke().
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-trace.h"
+#include "log.h"
+#include "abort.h"
+#include <cstring>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::EventTrace implementation.
+ */
+
+namespace {
+
+/** Magic string at the start of an event trace file. */
+const char g_eventTraceMagic[8] = { 'n', 's', '3', 'e', 'v', 't', 'r', '1' };
+
+} // unnamed namespace
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventTrace");
+
+EventTrace::EventTrace ()
+{
+  NS_LOG_FUNCTION (this);
+  m_last.m_ts = 0;
+  m_last.m_uid = 0;
+  m_last.m_context = 0;
+}
+
+EventTrace::~EventTrace ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+EventTrace::OpenWrite (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open ())
+    {
+      return false;
+    }
+  m_file.write (g_eventTraceMagic, sizeof (g_eventTraceMagic));
+  m_last.m_ts = 0;
+  m_last.m_uid = 0;
+  m_last.m_context = 0;
+  return m_file.good ();
+}
+
+bool
+EventTrace::OpenRead (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!m_file.is_open ())
+    {
+      return false;
+    }
+  char magic[sizeof (g_eventTraceMagic)];
+  m_file.read (magic, sizeof (magic));
+  if (!m_file.good ()
+      || std::memcmp (magic, g_eventTraceMagic, sizeof (magic)) != 0)
+    {
+      NS_LOG_WARN ("Not an event trace: " << filename);
+      Close ();
+      return false;
+    }
+  m_last.m_ts = 0;
+  m_last.m_uid = 0;
+  m_last.m_context = 0;
+  return true;
+}
+
+void
+EventTrace::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+bool
+EventTrace::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+EventTrace::WriteDelta (int64_t v)
+{
+  uint64_t zigzag = (static_cast<uint64_t> (v) << 1) ^ static_cast<uint64_t> (v >> 63);
+  char buffer[10];
+  uint32_t n = 0;
+  while (zigzag >= 0x80)
+    {
+      buffer[n++] = static_cast<char> ((zigzag & 0x7f) | 0x80);
+      zigzag >>= 7;
+    }
+  buffer[n++] = static_cast<char> (zigzag);
+  m_file.write (buffer, n);
+}
+
+bool
+EventTrace::ReadDelta (int64_t &v)
+{
+  uint64_t zigzag = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int c = m_file.get ();
+      if (c == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      zigzag |= static_cast<uint64_t> (c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        {
+          v = static_cast<int64_t> (zigzag >> 1) ^ -static_cast<int64_t> (zigzag & 1);
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+EventTrace::Write (Operation op, const Scheduler::EventKey &key)
+{
+  m_file.put (static_cast<char> (op));
+  WriteDelta (static_cast<int64_t> (key.m_ts - m_last.m_ts));
+  // Contexts are mostly node ids or NO_CONTEXT, which becomes 0
+  // once offset by one, so they are stored as is rather than as deltas.
+  WriteDelta (static_cast<int32_t> (key.m_context + 1));
+  WriteDelta (static_cast<int64_t> (key.m_uid) - static_cast<int64_t> (m_last.m_uid));
+  m_last = key;
+}
+
+bool
+EventTrace::Read (Operation &op, Scheduler::EventKey &key)
+{
+  int c = m_file.get ();
+  if (c == std::char_traits<char>::eof ())
+    {
+      return false;
+    }
+  NS_ABORT_MSG_IF (c > REMOVE, "Corrupted event trace, unknown operation " << c);
+  op = static_cast<Operation> (c);
+  int64_t ts, context, uid;
+  if (!ReadDelta (ts) || !ReadDelta (context) || !ReadDelta (uid))
+    {
+      NS_LOG_WARN ("Truncated event trace");
+      return false;
+    }
+  key.m_ts = m_last.m_ts + ts;
+  key.m_context = static_cast<uint32_t> (context) - 1;
+  key.m_uid = static_cast<uint32_t> (m_last.m_uid + uid);
+  m_last = key;
+  return true;
+}
+
+} // namespace ns3
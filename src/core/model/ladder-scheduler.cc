@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "uinteger.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+    .AddAttribute ("Threshold",
+                   "Largest number of events in a bucket which are "
+                   "sorted directly, instead of being spawned in to "
+                   "a new rung.",
+                   TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&LadderScheduler::m_threshold),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxRungs",
+                   "Maximum number of rungs in the ladder.",
+                   TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&LadderScheduler::m_maxRungs),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (0),
+    m_topMax (0),
+    m_topStart (0),
+    m_qSize (0),
+    m_threshold (50),
+    m_maxRungs (8)
+{
+  NS_LOG_FUNCTION (this);
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::size_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  // Rungs are ordered from the coarsest to the finest, and the current
+  // bucket of each rung starts after every time stamp held by the finer
+  // ones, so the first rung whose current bucket starts at or before ts
+  // is the one covering it.
+  std::size_t i;
+  for (i = 0; i < m_rungs.size (); i++)
+    {
+      if (ts >= m_rungs[i].m_current)
+        {
+          break;
+        }
+    }
+  return i;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      else
+        {
+          m_topMin = std::min (m_topMin, ts);
+          m_topMax = std::max (m_topMax, ts);
+        }
+      m_top.push_back (ev);
+    }
+  else
+    {
+      std::size_t i = FindRung (ts);
+      if (i < m_rungs.size ())
+        {
+          Rung &rung = m_rungs[i];
+          // The last bucket of a rung extends up to the start of the
+          // enclosing tier.
+          std::size_t bucket = std::min<uint64_t> ((ts - rung.m_start) / rung.m_width,
+                                                   rung.m_buckets.size () - 1);
+          rung.m_buckets[bucket].push_back (ev);
+          rung.m_nEvents++;
+        }
+      else
+        {
+          InsertBottom (ev);
+        }
+    }
+  m_qSize++;
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  // Filling Bottom does not change the logical content of the queue.
+  const_cast<LadderScheduler *> (this)->FillBottom ();
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  FillBottom ();
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_qSize--;
+  NS_LOG_DEBUG ("remove ts=" << ev.key.m_ts <<
+                ", key=" << ev.key.m_uid <<
+                ", from bottom, size=" << m_bottom.size ());
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  bool found = false;
+  if (ts >= m_topStart)
+    {
+      found = RemoveFromBucket (m_top, ev);
+    }
+  else
+    {
+      std::size_t i = FindRung (ts);
+      if (i < m_rungs.size ())
+        {
+          Rung &rung = m_rungs[i];
+          std::size_t bucket = std::min<uint64_t> ((ts - rung.m_start) / rung.m_width,
+                                                   rung.m_buckets.size () - 1);
+          found = RemoveFromBucket (rung.m_buckets[bucket], ev);
+          if (found)
+            {
+              rung.m_nEvents--;
+            }
+        }
+      else
+        {
+          Bucket::iterator it = std::find (m_bottom.begin (), m_bottom.end (), ev);
+          if (it != m_bottom.end ())
+            {
+              m_bottom.erase (it);
+              found = true;
+            }
+        }
+    }
+  NS_ASSERT_MSG (found, "Event " << ev.key.m_uid << " not found");
+  if (found)
+    {
+      m_qSize--;
+    }
+}
+
+bool
+LadderScheduler::RemoveFromBucket (Bucket &bucket, const Scheduler::Event &ev)
+{
+  for (Bucket::iterator it = bucket.begin (); it != bucket.end (); ++it)
+    {
+      if (it->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == it->impl);
+          *it = bucket.back ();
+          bucket.pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+LadderScheduler::FillBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_bottom.empty ())
+    {
+      Bucket events;
+      uint64_t minTs;
+      uint64_t maxTs;
+      if (m_rungs.empty ())
+        {
+          NS_ASSERT (!m_top.empty ());
+          events.swap (m_top);
+          minTs = m_topMin;
+          maxTs = m_topMax;
+          m_topStart = maxTs + 1;
+          NS_LOG_DEBUG ("transfer " << events.size () << " events from top, " <<
+                        "new top start=" << m_topStart);
+        }
+      else
+        {
+          Rung &rung = m_rungs.back ();
+          if (rung.m_nEvents == 0)
+            {
+              m_rungs.pop_back ();
+              continue;
+            }
+          while (rung.m_buckets[rung.m_currentBucket].empty ())
+            {
+              rung.m_currentBucket++;
+              rung.m_current += rung.m_width;
+            }
+          events.swap (rung.m_buckets[rung.m_currentBucket]);
+          rung.m_nEvents -= events.size ();
+          rung.m_currentBucket++;
+          rung.m_current += rung.m_width;
+          NS_LOG_DEBUG ("transfer " << events.size () << " events from rung " <<
+                        m_rungs.size () - 1 << ", width=" << rung.m_width);
+          if (rung.m_currentBucket == rung.m_buckets.size ())
+            {
+              // The last bucket has been transferred: later events
+              // belong to the enclosing tier.
+              NS_ASSERT (rung.m_nEvents == 0);
+              m_rungs.pop_back ();
+            }
+          minTs = events.front ().key.m_ts;
+          maxTs = minTs;
+          for (Bucket::const_iterator it = events.begin (); it != events.end (); ++it)
+            {
+              minTs = std::min (minTs, it->key.m_ts);
+              maxTs = std::max (maxTs, it->key.m_ts);
+            }
+        }
+
+      if (events.size () > m_threshold
+          && m_rungs.size () < m_maxRungs
+          && minTs != maxTs)
+        {
+          SpawnRung (events, minTs, maxTs);
+        }
+      else
+        {
+          SortIntoBottom (events);
+        }
+    }
+}
+
+void
+LadderScheduler::SpawnRung (Bucket &events, uint64_t minTs, uint64_t maxTs)
+{
+  NS_LOG_FUNCTION (this << events.size () << minTs << maxTs);
+  m_rungs.push_back (Rung ());
+  Rung &rung = m_rungs.back ();
+  rung.m_start = minTs;
+  rung.m_width = (maxTs - minTs) / events.size () + 1;
+  rung.m_current = minTs;
+  rung.m_currentBucket = 0;
+  rung.m_nEvents = events.size ();
+  rung.m_buckets.resize (events.size ());
+  for (Bucket::const_iterator it = events.begin (); it != events.end (); ++it)
+    {
+      std::size_t bucket = (it->key.m_ts - rung.m_start) / rung.m_width;
+      rung.m_buckets[bucket].push_back (*it);
+    }
+  NS_LOG_DEBUG ("spawn rung " << m_rungs.size () - 1 << ", start=" << rung.m_start <<
+                ", width=" << rung.m_width << ", buckets=" << rung.m_buckets.size ());
+}
+
+void
+LadderScheduler::SortIntoBottom (Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  NS_ASSERT (m_bottom.empty ());
+  m_bottom.swap (events);
+  std::sort (m_bottom.begin (), m_bottom.end (), std::greater<Scheduler::Event> ());
+}
+
+void
+LadderScheduler::InsertBottom (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  Bucket::iterator it = std::upper_bound (m_bottom.begin (), m_bottom.end (), ev,
+                                          std::greater<Scheduler::Event> ());
+  m_bottom.insert (it, ev);
+  if (m_bottom.size () > m_threshold
+      && m_rungs.size () < m_maxRungs
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      Bucket events;
+      events.swap (m_bottom);
+      SpawnRung (events, events.back ().key.m_ts, events.front ().key.m_ts);
+    }
+}
+
+} // namespace ns3
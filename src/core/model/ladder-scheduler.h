@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the Ladder Queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The event list is split in three tiers, each one covering a
+ * disjoint range of time stamps:
+ *
+ * - Top: an unsorted `std::vector` holding every event at or after
+ *   \c m_topStart.  Far-future events are only appended here.
+ * - Ladder: a stack of rungs, each one an array of unsorted buckets of
+ *   uniform width.  When the next bucket of the innermost rung holds
+ *   too many events it is spawned into a finer rung, instead of being
+ *   sorted.
+ * - Bottom: a small sorted `std::vector` holding the earliest events,
+ *   from which RemoveNext() pops.
+ *
+ * Unlike the CalendarScheduler, bucket widths are derived from the
+ * actual spread of the events being transferred, so that a burst of
+ * events a few nanoseconds apart (such as the Receive events scheduled
+ * by a wireless channel for every PHY in range) is spread across a
+ * finer rung rather than sorted as a whole.  Events sharing the
+ * exact same time stamp cannot be split further and are sorted
+ * directly in Bottom.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket; sorted insert in a bounded Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | ~Constant       | Possible transfer of a bucket to Bottom
+ * Remove()     | Linear          | Search within Top, a bucket or Bottom
+ * RemoveNext() | ~Constant       | Possible transfer of a bucket to Bottom
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 9 x `sizeof (*)`<br/>(72 bytes)  | three `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Ladder bucket type: an unsorted vector of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** One rung of the ladder. */
+  struct Rung
+  {
+    uint64_t m_start;               //!< Time stamp at the start of the first bucket.
+    uint64_t m_width;               //!< Duration of each bucket, in dimensionless time units.
+    uint64_t m_current;             //!< Time stamp at the start of the current bucket.
+    std::size_t m_currentBucket;    //!< Index of the current bucket.
+    std::size_t m_nEvents;          //!< Number of events in this rung.
+    std::vector<Bucket> m_buckets;  //!< The buckets.
+  };
+
+  /**
+   * Make sure Bottom holds the earliest events, transferring events
+   * from the Ladder or from Top as needed.
+   *
+   * This method cannot be invoked if the list is empty.
+   */
+  void FillBottom (void);
+  /**
+   * Append a new rung at the bottom of the ladder, and distribute
+   * events into it.
+   *
+   * \param [in] events The events to distribute; all time stamps must
+   *             be smaller than the current bucket of the innermost rung.
+   * \param [in] minTs The smallest time stamp in \p events.
+   * \param [in] maxTs The largest time stamp in \p events.
+   */
+  void SpawnRung (Bucket &events, uint64_t minTs, uint64_t maxTs);
+  /**
+   * Sort events in to Bottom.
+   *
+   * \param [in] events The events to add to Bottom; all time stamps must
+   *             be smaller than the current bucket of the innermost rung.
+   */
+  void SortIntoBottom (Bucket &events);
+  /**
+   * Insert an event in Bottom, keeping it sorted, and spawn a new rung
+   * from Bottom if it grew too large.
+   *
+   * \param [in] ev The event to insert.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Find the rung covering a time stamp.
+   *
+   * \param [in] ts The dimensionless time stamp.
+   * \returns The index of the rung holding \p ts, or the number of
+   *          rungs if \p ts belongs in Bottom.
+   */
+  std::size_t FindRung (uint64_t ts) const;
+  /**
+   * Remove an event from an unsorted bucket.
+   *
+   * \param [in,out] bucket The bucket to search.
+   * \param [in] ev The event to remove.
+   * \returns \c true if the event was found.
+   */
+  static bool RemoveFromBucket (Bucket &bucket, const Scheduler::Event &ev);
+
+  /** Top: unsorted far-future events. */
+  Bucket m_top;
+  /** Smallest time stamp in Top. */
+  uint64_t m_topMin;
+  /** Largest time stamp in Top. */
+  uint64_t m_topMax;
+  /** Events at or after this time stamp go in Top. */
+  uint64_t m_topStart;
+  /** The rungs, from the coarsest (index 0) to the finest. */
+  std::vector<Rung> m_rungs;
+  /** Bottom: earliest events sorted in *decreasing* order. */
+  Bucket m_bottom;
+  /** Number of events in queue. */
+  uint32_t m_qSize;
+  /** Largest number of events sorted directly in to Bottom. */
+  uint32_t m_threshold;
+  /** Maximum number of rungs in the ladder. */
+  uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -0,0 +1,636 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "simulator.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ptr.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+#include "fatal-error.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace {
+
+/**
+ * Index of the partition run by the current thread, or -1 outside of
+ * the parallel windows, when the main thread runs the global partition.
+ */
+thread_local int32_t g_currentPartition = -1;
+
+} // unnamed namespace
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Threads",
+                   "Number of threads, and of partitions of nodes. "
+                   "0 means one per hardware thread.",
+                   TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_threads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lookahead",
+                   "Smallest delay of the events scheduled across "
+                   "partitions, which bounds the duration of the "
+                   "windows run in parallel.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker (Seconds (0)))
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_threads (0),
+    m_stop (false),
+    m_parallel (false),
+    m_windowEnd (0),
+    m_lateEvents (0),
+    m_nextWorker (0),
+    m_window (0),
+    m_running (0),
+    m_exit (false)
+{
+  NS_LOG_FUNCTION (this);
+  m_main = SystemThread::Self ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Partition>::iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+    {
+      while (!p->events->IsEmpty ())
+        {
+          Scheduler::Event next = p->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (std::size_t i = 0; i < p->outbox.size (); ++i)
+        {
+          for (std::size_t j = 0; j < p->outbox[i].size (); ++j)
+            {
+              p->outbox[i][j].event->Unref ();
+            }
+        }
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  CreatePartitions (schedulerFactory);
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  if (m_partitions.empty ())
+    {
+      if (m_threads == 0)
+        {
+          m_threads = std::max (1U, std::thread::hardware_concurrency ());
+        }
+      // One partition per thread, plus the global partition.
+      m_partitions.resize (m_threads + 1);
+      for (std::vector<Partition>::iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+        {
+          p->events = schedulerFactory.Create<Scheduler> ();
+          p->outbox.resize (m_partitions.size ());
+          // uids are allocated from 4, as in DefaultSimulatorImpl.
+          p->uid = 4;
+          p->currentUid = 0;
+          p->currentTs = 0;
+          p->currentContext = Simulator::NO_CONTEXT;
+          p->eventCount = 0;
+          p->unscheduledEvents = 0;
+        }
+      NS_LOG_INFO ("Created " << m_threads << " partitions");
+      return;
+    }
+
+  for (std::vector<Partition>::iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!p->events->IsEmpty ())
+        {
+          scheduler->Insert (p->events->RemoveNext ());
+        }
+      p->events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return m_threads;
+    }
+  return context % m_threads;
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  MultithreadedSimulatorImpl *self = const_cast<MultithreadedSimulatorImpl *> (this);
+  if (g_currentPartition < 0)
+    {
+      return self->m_partitions.back ();
+    }
+  return self->m_partitions[g_currentPartition];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition.uid;
+  partition.uid++;
+  partition.unscheduledEvents++;
+  partition.events->Insert (ev);
+  return ev.key.m_uid;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (std::vector<Partition>::const_iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+    {
+      if (!p->events->IsEmpty ())
+        {
+          return false;
+        }
+      for (std::size_t i = 0; i < p->outbox.size (); ++i)
+        {
+          if (!p->outbox[i].empty ())
+            {
+              return false;
+            }
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition &partition)
+{
+  Scheduler::Event next = partition.events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition.currentTs);
+  partition.unscheduledEvents--;
+  partition.eventCount++;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition.currentTs = next.key.m_ts;
+  partition.currentContext = next.key.m_context;
+  partition.currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPartition (uint32_t index, uint64_t windowEnd)
+{
+  Partition &partition = m_partitions[index];
+  while (!partition.events->IsEmpty ()
+         && partition.events->PeekNext ().key.m_ts < windowEnd)
+    {
+      ProcessOneEvent (partition);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DeliverPendingEvents (void)
+{
+  // Events are delivered by destination, then by source partition,
+  // then in the order they were scheduled, so that the uids they are
+  // given do not depend on the thread interleaving.
+  for (std::size_t dst = 0; dst < m_partitions.size (); ++dst)
+    {
+      Partition &destination = m_partitions[dst];
+      for (std::size_t src = 0; src < m_partitions.size (); ++src)
+        {
+          std::vector<PendingEvent> &pending = m_partitions[src].outbox[dst];
+          for (std::vector<PendingEvent>::const_iterator i = pending.begin (); i != pending.end (); ++i)
+            {
+              uint64_t ts = i->ts;
+              if (ts < destination.currentTs)
+                {
+                  NS_LOG_LOGIC ("late event for context " << i->context <<
+                                " delayed by " << destination.currentTs - ts);
+                  ts = destination.currentTs;
+                  m_lateEvents++;
+                }
+              Insert (destination, ts, i->context, i->event);
+            }
+          pending.clear ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWorker (void)
+{
+  uint32_t index = m_nextWorker.fetch_add (1) + 1;
+  NS_ASSERT (index < m_threads);
+  g_currentPartition = index;
+  uint64_t window = 0;
+  while (true)
+    {
+      while (m_window.load (std::memory_order_acquire) == window)
+        {
+          std::this_thread::yield ();
+        }
+      window++;
+      if (m_exit.load (std::memory_order_relaxed))
+        {
+          break;
+        }
+      ProcessPartition (index, m_windowEnd);
+      m_running.fetch_sub (1, std::memory_order_release);
+    }
+  g_currentPartition = -1;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  m_stop = false;
+
+  // Partition 0 is run by the main thread itself.
+  m_nextWorker = 0;
+  m_window = 0;
+  m_exit = false;
+  for (uint32_t i = 1; i < m_threads; ++i)
+    {
+      Ptr<SystemThread> worker = Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::RunWorker, this));
+      worker->Start ();
+      m_workers.push_back (worker);
+    }
+
+  const uint64_t never = std::numeric_limits<uint64_t>::max ();
+  uint64_t lookahead = std::max<int64_t> (m_lookahead.GetTimeStep (), 1);
+  Partition &global = m_partitions.back ();
+  while (!m_stop)
+    {
+      DeliverPendingEvents ();
+
+      uint64_t next = never;
+      for (uint32_t i = 0; i < m_threads; ++i)
+        {
+          if (!m_partitions[i].events->IsEmpty ())
+            {
+              next = std::min (next, m_partitions[i].events->PeekNext ().key.m_ts);
+            }
+        }
+      uint64_t globalNext = global.events->IsEmpty () ? never : global.events->PeekNext ().key.m_ts;
+      if (next == never && globalNext == never)
+        {
+          break;
+        }
+
+      if (globalNext <= next)
+        {
+          // Events without context may touch any node: run them alone.
+          while (!m_stop && !global.events->IsEmpty ()
+                 && global.events->PeekNext ().key.m_ts == globalNext)
+            {
+              ProcessOneEvent (global);
+            }
+          continue;
+        }
+
+      m_windowEnd = std::min (next < never - lookahead ? next + lookahead : never, globalNext);
+      NS_LOG_LOGIC ("window [" << next << ", " << m_windowEnd << ")");
+      m_parallel = true;
+      m_running.store (m_threads - 1, std::memory_order_relaxed);
+      m_window.fetch_add (1, std::memory_order_release);
+      g_currentPartition = 0;
+      ProcessPartition (0, m_windowEnd);
+      g_currentPartition = -1;
+      while (m_running.load (std::memory_order_acquire) != 0)
+        {
+          std::this_thread::yield ();
+        }
+      m_parallel = false;
+    }
+
+  m_exit = true;
+  m_window.fetch_add (1, std::memory_order_release);
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_workers.begin (); i != m_workers.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_workers.clear ();
+
+  // Now () is the time of the last event run by any partition.
+  for (uint32_t i = 0; i < m_threads; ++i)
+    {
+      global.currentTs = std::max (global.currentTs, m_partitions[i].currentTs);
+    }
+  if (m_lateEvents > 0)
+    {
+      NS_LOG_WARN (m_lateEvents << " events scheduled across partitions "
+                   "with less than the lookahead were delayed");
+    }
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  if (!m_stop)
+    {
+      for (std::vector<Partition>::const_iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+        {
+          NS_ASSERT (p->unscheduledEvents == 0);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  // Stop from the global partition, so that it happens exactly at
+  // the requested time, once every partition is there.
+  Simulator::ScheduleWithContext (Simulator::NO_CONTEXT, delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (g_currentPartition >= 0 || SystemThread::Equals (m_main),
+                 "Simulator::Schedule Thread-unsafe invocation!");
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+  Partition &partition = GetCurrentPartition ();
+  uint64_t ts = partition.currentTs + delay.GetTimeStep ();
+  uint32_t uid = Insert (partition, ts, partition.currentContext, event);
+  return EventId (event, ts, partition.currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  if (g_currentPartition < 0 && !SystemThread::Equals (m_main))
+    {
+      NS_FATAL_ERROR ("MultithreadedSimulatorImpl does not support scheduling "
+                      "events from other threads than the simulation ones");
+    }
+
+  Partition &current = GetCurrentPartition ();
+  uint64_t ts = current.currentTs + delay.GetTimeStep ();
+  uint32_t target = GetPartition (context);
+  if (!m_parallel || &m_partitions[target] == &current)
+    {
+      Insert (m_partitions[target], ts, context, event);
+    }
+  else
+    {
+      PendingEvent pending;
+      pending.ts = ts;
+      pending.context = context;
+      pending.event = event;
+      current.outbox[target].push_back (pending);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (TimeStep (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  CriticalSection cs (m_destroyEventsMutex);
+  EventId id (Ptr<EventImpl> (event, false), GetCurrentPartition ().currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (GetCurrentPartition ().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrentPartition ().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition &owner = m_partitions[GetPartition (id.GetContext ())];
+  if (m_parallel && &owner != &GetCurrentPartition ())
+    {
+      // The event list of another partition cannot be modified while
+      // it runs: leave the event there, cancelled.
+      id.PeekEventImpl ()->Cancel ();
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  owner.events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  owner.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (const_cast<SystemMutex &> (m_destroyEventsMutex));
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  const Partition &owner = m_partitions[GetPartition (id.GetContext ())];
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < owner.currentTs
+      || (id.GetTs () == owner.currentTs && id.GetUid () <= owner.currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrentPartition ().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (std::vector<Partition>::const_iterator p = m_partitions.begin (); p != m_partitions.end (); ++p)
+    {
+      count += p->eventCount;
+    }
+  return count;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetLateEventCount (void) const
+{
+  return m_lateEvents;
+}
+
+} // namespace ns3
@@ -31,6 +31,7 @@
 #include <cmath>
 #include <ostream>
 #include <set>
+#include <unordered_set>
 
 /**
  * \file
@@ -639,20 +640,22 @@ private:
    *
    *  \internal
    *
-   *  We use a std::set so we can remove the record easily when
-   *  ~Time() is called.
+   *  We use a hash set so we can record each Time and remove the record
+   *  when ~Time() is called in constant time: every Time created
+   *  while setting up a simulation goes through it, until
+   *  Simulator::Run ().
    *
    *  We don't use Ptr<Time>, because we would have to bloat every Time
    *  instance with SimpleRefCount<Time>.
    *
-   *  Seems like this should be std::set< Time * const >, but
+   *  Seems like this should be std::unordered_set< Time * const >, but
    *  [Stack Overflow](http://stackoverflow.com/questions/5526019/compile-errors-stdset-with-const-members)
    *  says otherwise, quoting the standard:
    *
    *  > & sect;23.1/3 states that std::set key types must be assignable
    *  > and copy constructable; clearly a const type will not be assignable.
    */
-  typedef std::set< Time * > MarkedTimes;
+  typedef std::unordered_set< Time * > MarkedTimes;
   /**
    *  Record of outstanding Time objects which will need conversion
    *  when the resolution is set.
@@ -82,20 +82,30 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
   // loop over the inheritance tree back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
   TypeId tid = GetInstanceTypeId ();
+  // The environment is looked up once per object, not once per attribute
+  const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+  bool hasEnvVar = envVar != 0 && std::strlen (envVar) > 0;
   do
     {
       // loop over all attributes in object type
       NS_LOG_DEBUG ("construct tid=" << tid.GetName () << ", params=" << tid.GetAttributeN ());
       for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
         {
-          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          // Keep only what is needed to set the attribute, rather than a
+          // copy of its names and help: setting it may register new
+          // TypeIds, after which the information cannot be peeked at.
+          const struct TypeId::AttributeInformation &info = tid.PeekAttribute (i);
+          Ptr<const AttributeAccessor> accessor = info.accessor;
+          Ptr<const AttributeChecker> checker = info.checker;
+          Ptr<const AttributeValue> initialValue = info.initialValue;
+          uint32_t flags = info.flags;
           NS_LOG_DEBUG ("try to construct \"" << tid.GetName () << "::" <<
                         info.name << "\"");
           // is this attribute stored in this AttributeConstructionList instance ?
-          Ptr<AttributeValue> value = attributes.Find (info.checker);
+          Ptr<AttributeValue> value = attributes.Find (checker);
           // See if this attribute should not be set here in the
           // constructor.
-          if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+          if (!(flags & TypeId::ATTR_CONSTRUCT))
             {
               // Handle this attribute if it should not be
               // set here.
@@ -117,17 +127,15 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
           if (value != 0)
             {
               // We have a matching attribute value.
-              if (DoSet (info.accessor, info.checker, *value))
+              if (DoSet (accessor, checker, *value))
                 {
-                  NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                                info.name << "\"");
+                  NS_LOG_DEBUG ("construct \"" << tid.GetAttributeFullName (i) << "\"");
                   continue;
                 }
             }
 
           // No matching attribute value so we try to look at the env var.
-          const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
-          if (envVar != 0 && std::strlen (envVar) > 0)
+          if (hasEnvVar)
             {
               std::string env = envVar;
               std::string::size_type cur = 0;
@@ -143,10 +151,10 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
                       std::string envval = tmp.substr (equal + 1, tmp.size () - equal - 1);
                       if (name == tid.GetAttributeFullName (i))
                         {
-                          if (DoSet (info.accessor, info.checker, StringValue (envval)))
+                          if (DoSet (accessor, checker, StringValue (envval)))
                             {
-                              NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                                            info.name << "\" from env var");
+                              NS_LOG_DEBUG ("construct \"" << tid.GetAttributeFullName (i) <<
+                                            "\" from env var");
                               break;
                             }
                         }
@@ -156,9 +164,9 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             }
 
           // No matching attribute value so we try to set the default value.
-          DoSet (info.accessor, info.checker, *info.initialValue);
-          NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                        info.name << "\" from initial value.");
+          DoSet (accessor, checker, *initialValue);
+          NS_LOG_DEBUG ("construct \"" << tid.GetAttributeFullName (i) <<
+                        "\" from initial value.");
         }
       tid = tid.GetParent ();
     }
@@ -172,6 +180,11 @@ ObjectBase::DoSet (Ptr<const AttributeAccessor> accessor,
                    const AttributeValue &value)
 {
   NS_LOG_FUNCTION (this << accessor << checker << &value);
+  if (checker->Check (value))
+    {
+      // The value is used as is, there is no need for a copy
+      return accessor->Set (this, value);
+    }
   Ptr<AttributeValue> v = checker->CreateValidValue (value);
   if (v == 0)
     {
@@ -323,6 +323,22 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
     }
 }
 
+/** The last stream created by a thread, before its substream was selected. */
+struct LastStream
+{
+  uint32_t seed;      //!< The seed of the stream.
+  uint64_t stream;    //!< The stream number.
+  double state[6];    //!< The state of the stream.
+  bool valid;         //!< Whether a stream was created.
+};
+
+/**
+ * The last stream created by the calling thread: streams are mostly
+ * numbered in sequence, and each one can be derived from the previous
+ * one rather than from the seed.
+ */
+thread_local struct LastStream g_lastStream = { 0, 0, { 0, 0, 0, 0, 0, 0 }, false };
+
 } // namespace MRG32k3a
 
 // *NS_CHECK_STYLE_ON*
@@ -373,11 +389,32 @@ RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
     {
       NS_FATAL_ERROR ("invalid Seed " << seedNumber);
     }
+  if (g_lastStream.valid && g_lastStream.seed == seedNumber
+      && g_lastStream.stream + 1 == stream)
+    {
+      // The next stream starts 2^127 steps after the last one, which
+      // costs one product instead of one per bit set in the stream
+      for (int i = 0; i < 6; ++i)
+        {
+          m_currentState[i] = g_lastStream.state[i];
+        }
+      AdvanceNthBy (1, 127, m_currentState);
+    }
+  else
+    {
+      for (int i = 0; i < 6; ++i)
+        {
+          m_currentState[i] = seedNumber;
+        }
+      AdvanceNthBy (stream, 127, m_currentState);
+    }
+  g_lastStream.seed = seedNumber;
+  g_lastStream.stream = stream;
   for (int i = 0; i < 6; ++i)
     {
-      m_currentState[i] = seedNumber;
+      g_lastStream.state[i] = m_currentState[i];
     }
-  AdvanceNthBy (stream, 127, m_currentState);
+  g_lastStream.valid = true;
   AdvanceNthBy (substream, 76, m_currentState);
 }
 
@@ -317,7 +317,7 @@ Time::ClearMarkedTimes ()
   if (g_markingTimes)
     {
       NS_LOG_LOGIC ("clearing MarkedTimes");
-      g_markingTimes->erase (g_markingTimes->begin (), g_markingTimes->end ());
+      g_markingTimes->clear ();
       g_markingTimes = 0;
     }
 }  // Time::ClearMarkedTimes
@@ -410,7 +410,7 @@ Time::ConvertTimes (const enum Unit unit)
   // Body of ClearMarkedTimes
   // Assert above already guarantees g_markingTimes != 0
   NS_LOG_LOGIC ("clearing MarkedTimes");
-  g_markingTimes->erase (g_markingTimes->begin (), g_markingTimes->end ());
+  g_markingTimes->clear ();
   g_markingTimes = 0;
 
 }  // Time::ConvertTimes ()
@@ -51,7 +51,9 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * \brief TypeId information manager
  *
  * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * are performed by maps to the vector index.  Each record also keeps the
+ * hashed names of its Attributes and TraceSources, which are compared
+ * before the names when looking them up.
  *
  * \internal
  * <b>Hash Chaining</b>
@@ -229,6 +231,13 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Get Attribute information by index, without copying it.
+   * \param [in] uid The id.
+   * \param [in] i Index into attribute array
+   * \returns The information associated to attribute whose index is \pname{i}.
+   */
+  const struct TypeId::AttributeInformation & PeekAttribute (uint16_t uid, std::size_t i) const;
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -264,6 +273,26 @@ public:
    * \returns Detailed information about the requested trace source.
    */
   struct TypeId::TraceSourceInformation GetTraceSource (uint16_t uid, std::size_t i) const;
+  /**
+   * Find an Attribute in a type id or its parents.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \param [out] owner The id of the type which registered the Attribute.
+   * \param [out] i The index of the Attribute in \pname{owner}.
+   * \returns \c true if the Attribute was found.
+   */
+  bool FindAttribute (uint16_t uid, const std::string &name,
+                      uint16_t *owner, std::size_t *i) const;
+  /**
+   * Find a TraceSource in a type id or its parents.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \param [out] owner The id of the type which registered the TraceSource.
+   * \param [out] i The index of the TraceSource in \pname{owner}.
+   * \returns \c true if the TraceSource was found.
+   */
+  bool FindTraceSource (uint16_t uid, const std::string &name,
+                        uint16_t *owner, std::size_t *i) const;
   /**
    * Check if this TypeId should not be listed in documentation.
    * \param [in] uid The id.
@@ -288,10 +317,10 @@ private:
   bool HasAttribute (uint16_t uid, std::string name);
   /**
    * Hashing function.
-   * \param [in] name The type id name.
+   * \param [in] name The type id, Attribute or TraceSource name.
    * \returns The hashed value of \pname{name}.
    */
-  static TypeId::hash_t Hasher (const std::string name);
+  static TypeId::hash_t Hasher (const std::string &name);
 
   /** The information record about a single type id. */
   struct IidInformation
@@ -316,6 +345,10 @@ private:
     std::vector<struct TypeId::AttributeInformation> attributes;
     /** The container of TraceSources. */
     std::vector<struct TypeId::TraceSourceInformation> traceSources;
+    /** The hashed names of the Attributes, in the same order. */
+    std::vector<TypeId::hash_t> attributeHashes;
+    /** The hashed names of the TraceSources, in the same order. */
+    std::vector<TypeId::hash_t> traceSourceHashes;
     /** Support level/deprecation. */
     TypeId::SupportLevel supportLevel;
     /** Support message. */
@@ -361,7 +394,7 @@ private:
 
 //static
 TypeId::hash_t
-IidManager::Hasher (const std::string name)
+IidManager::Hasher (const std::string &name)
 {
   static ns3::Hasher hasher ( Create<Hash::Function::Murmur3> () );
   return hasher.clear ().GetHash32 (name);
@@ -617,30 +650,42 @@ IidManager::HasAttribute (uint16_t uid,
                           std::string name)
 {
   NS_LOG_FUNCTION (IID << uid << name);
-  struct IidInformation *information  = LookupInformation (uid);
+  uint16_t owner;
+  std::size_t i;
+  bool found = FindAttribute (uid, name, &owner, &i);
+  NS_LOG_LOGIC (IIDL << found);
+  return found;
+}
+
+bool
+IidManager::FindAttribute (uint16_t uid, const std::string &name,
+                           uint16_t *owner, std::size_t *i) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  TypeId::hash_t hash = Hasher (name);
+  uint16_t tid = uid;
   while (true)
     {
-      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = information->attributes.begin ();
-           i != information->attributes.end (); ++i)
+      struct IidInformation *information = LookupInformation (tid);
+      const std::vector<TypeId::hash_t> &hashes = information->attributeHashes;
+      for (std::size_t j = 0; j < hashes.size (); j++)
         {
-          if (i->name == name)
+          // Compare the names only when the hashes match
+          if (hashes[j] == hash && information->attributes[j].name == name)
             {
-              NS_LOG_LOGIC (IIDL << true);
+              *owner = tid;
+              *i = j;
               return true;
             }
         }
-      struct IidInformation *parent = LookupInformation (information->parent);
-      if (parent == information)
+      if (information->parent == tid || information->parent == 0)
         {
-          // top of inheritance tree
-          NS_LOG_LOGIC (IIDL << false);
+          // top of inheritance tree, or no parent set yet
           return false;
         }
       // check parent
-      information = parent;
+      tid = information->parent;
     }
-  NS_LOG_LOGIC (IIDL << false);
-  return false;
 }
 
 void
@@ -681,6 +726,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  information->attributeHashes.push_back (Hasher (name));
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void
@@ -715,35 +761,56 @@ IidManager::GetAttribute (uint16_t uid, std::size_t i) const
   return information->attributes[i];
 }
 
+const struct TypeId::AttributeInformation &
+IidManager::PeekAttribute (uint16_t uid, std::size_t i) const
+{
+  NS_LOG_FUNCTION (IID << uid << i);
+  struct IidInformation *information = LookupInformation (uid);
+  NS_ASSERT (i < information->attributes.size ());
+  return information->attributes[i];
+}
+
 bool
 IidManager::HasTraceSource (uint16_t uid,
                             std::string name)
 {
   NS_LOG_FUNCTION (IID << uid << name);
-  struct IidInformation *information  = LookupInformation (uid);
+  uint16_t owner;
+  std::size_t i;
+  bool found = FindTraceSource (uid, name, &owner, &i);
+  NS_LOG_LOGIC (IIDL << found);
+  return found;
+}
+
+bool
+IidManager::FindTraceSource (uint16_t uid, const std::string &name,
+                             uint16_t *owner, std::size_t *i) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  TypeId::hash_t hash = Hasher (name);
+  uint16_t tid = uid;
   while (true)
     {
-      for (std::vector<struct TypeId::TraceSourceInformation>::const_iterator i = information->traceSources.begin ();
-           i != information->traceSources.end (); ++i)
+      struct IidInformation *information = LookupInformation (tid);
+      const std::vector<TypeId::hash_t> &hashes = information->traceSourceHashes;
+      for (std::size_t j = 0; j < hashes.size (); j++)
         {
-          if (i->name == name)
+          // Compare the names only when the hashes match
+          if (hashes[j] == hash && information->traceSources[j].name == name)
             {
-              NS_LOG_LOGIC (IIDL << true);
+              *owner = tid;
+              *i = j;
               return true;
             }
         }
-      struct IidInformation *parent = LookupInformation (information->parent);
-      if (parent == information)
+      if (information->parent == tid || information->parent == 0)
         {
-          // top of inheritance tree
-          NS_LOG_LOGIC (IIDL << false);
+          // top of inheritance tree, or no parent set yet
           return false;
         }
       // check parent
-      information = parent;
+      tid = information->parent;
     }
-  NS_LOG_LOGIC (IIDL << false);
-  return false;
 }
 
 void
@@ -773,6 +840,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  information->traceSourceHashes.push_back (Hasher (name));
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -883,40 +951,26 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do
+  uint16_t owner;
+  std::size_t i;
+  if (!IidManager::Get ()->FindAttribute (m_tid, name, &owner, &i))
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return false;
+    }
+  struct TypeId::AttributeInformation tmp = IidManager::Get ()->GetAttribute (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp.supportMsg);
     }
-  while (nextTid != tid);
-  return false;
+  *info = tmp;
+  return true;
 }
 
 TypeId
@@ -1086,6 +1140,12 @@ TypeId::GetAttribute (std::size_t i) const
   NS_LOG_FUNCTION (this << i);
   return IidManager::Get ()->GetAttribute (m_tid, i);
 }
+const struct TypeId::AttributeInformation &
+TypeId::PeekAttribute (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  return IidManager::Get ()->PeekAttribute (m_tid, i);
+}
 std::string
 TypeId::GetAttributeFullName (std::size_t i) const
 {
@@ -1137,41 +1197,26 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do
+  uint16_t owner;
+  std::size_t i;
+  if (!IidManager::Get ()->FindTraceSource (m_tid, name, &owner, &i))
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return 0;
+    }
+  struct TypeId::TraceSourceInformation tmp = IidManager::Get ()->GetTraceSource (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "TraceSource '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("TraceSource '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp.supportMsg);
     }
-  while (nextTid != tid);
-  return 0;
+  *info = tmp;
+  return tmp.accessor;
 }
 
 Ptr<const TraceSourceAccessor>
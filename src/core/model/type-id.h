@@ -258,6 +258,16 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (std::size_t i) const;
+  /**
+   * Get Attribute information by index, without copying it.
+   *
+   * The reference is only valid until the next TypeId or Attribute
+   * is registered, which may happen while an object is constructed.
+   *
+   * \param [in] i Index into attribute array
+   * \returns The information associated to attribute whose index is \pname{i}.
+   */
+  const struct TypeId::AttributeInformation & PeekAttribute (std::size_t i) const;
   /**
    * Get the Attribute name by index.
    *
@@ -840,6 +840,137 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test the parsed Config paths and the connection of many paths at once.
+ */
+class ConfigPathTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ConfigPathTestCase ();
+  /** Destructor. */
+  virtual ~ConfigPathTestCase ()
+  {}
+
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_path = path;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+};
+
+ConfigPathTestCase::ConfigPathTestCase ()
+  : TestCase ("Check the parsed Config paths and ConnectAll")
+{}
+
+void
+ConfigPathTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  //
+  // The other test cases leave their root objects registered, with
+  // objects under NodeA and NodesB: use NodeB and NodesA instead.
+  //
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  root->SetNodeB (b);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  b->SetNodeA (a);
+
+  //
+  // Mix objects of two types in the vector, so that the attributes are
+  // looked up in both types.
+  //
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<ConfigTestObject> object;
+      if (i % 2 == 0)
+        {
+          object = CreateObject<ConfigTestObject> ();
+        }
+      else
+        {
+          object = CreateObject<DerivedConfigTestObject> ();
+        }
+      a->AddNodeA (object);
+      objects.push_back (object);
+    }
+
+  Config::ConfigPath path ("/NodeB/NodeA/NodesA/[0-1]|3/A");
+  NS_TEST_ASSERT_MSG_EQ (path.GetPath (), "/NodeB/NodeA/NodesA/[0-1]|3/A", "Wrong path");
+  NS_TEST_ASSERT_MSG_EQ (path.GetLeaf (), "A", "Wrong leaf");
+  Config::MatchContainer matches = path.LookupMatches ();
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 3, "Wrong number of matches");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (2), "/NodeB/NodeA/NodesA/3/", "Wrong matched path");
+
+  //
+  // Resolve the path twice, the second time with the attributes found
+  // the first time.
+  //
+  for (int8_t value = -11; value >= -12; value--)
+    {
+      Config::ConfigPath copy = path;
+      copy.Set (IntegerValue (value));
+      for (uint32_t i = 0; i < objects.size (); i++)
+        {
+          objects[i]->GetAttribute ("A", iv);
+          NS_TEST_ASSERT_MSG_EQ (iv.Get (), (i == 2 || i == 4) ? 10 : value, "Wrong attribute \"A\" of object " << i);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (Config::ConfigPath ("/NodeB/NodeA/NodesA/*/Z").SetFailSafe (IntegerValue (1)), false,
+                         "Set an attribute which does not exist");
+
+  //
+  // Connect two paths sharing their leading elements, with contexts.
+  //
+  std::vector<std::pair<Config::ConfigPath, CallbackBase> > connections;
+  connections.push_back (std::make_pair (Config::ConfigPath ("/NodeB/NodeA/NodesA/0|1/Source"),
+                                         MakeCallback (&ConfigPathTestCase::TraceWithPath, this)));
+  connections.push_back (std::make_pair (Config::ConfigPath ("/NodeB/NodeA/NodesA/[3-4]/Source"),
+                                         MakeCallback (&ConfigPathTestCase::TraceWithPath, this)));
+  Config::ConnectAll (connections);
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      m_newValue = 0;
+      m_path = "";
+      objects[i]->SetAttribute ("Source", IntegerValue (-10 - (int16_t)i));
+      if (i == 2)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 2 fired unexpectedly");
+        }
+      else
+        {
+          std::ostringstream oss;
+          oss << "/NodeB/NodeA/NodesA/" << i << "/Source";
+          NS_TEST_ASSERT_MSG_EQ (m_newValue, -10 - (int16_t)i, "Trace " << i << " did not fire as expected");
+          NS_TEST_ASSERT_MSG_EQ (m_path, oss.str (), "Trace " << i << " did not provide expected context");
+        }
+    }
+
+  connections.push_back (std::make_pair (Config::ConfigPath ("/NodeB/NodeA/NodesA/7/Source"),
+                                         MakeCallback (&ConfigPathTestCase::TraceWithPath, this)));
+  NS_TEST_ASSERT_MSG_EQ (Config::ConnectAllFailSafe (connections), false, "Connected a path without objects");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +989,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new ConfigPathTestCase);
 }
 
 /**
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that the MultithreadedSimulatorImpl runs the same events as
+ * the DefaultSimulatorImpl, when nodes exchange events with at least
+ * the lookahead as delay.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] threads Number of threads.
+   * \param [in] lookahead Lookahead, in ns; events across nodes are
+   *             scheduled with a delay of at least 1 us.
+   */
+  MultithreadedSimulatorTestCase (uint32_t threads, uint64_t lookahead);
+
+private:
+  virtual void DoRun (void);
+
+  /** Events run by a node: (time stamp, value) */
+  typedef std::vector<std::pair<int64_t, uint32_t> > Log;
+
+  /**
+   * Run the scenario with a simulator implementation.
+   *
+   * \param [in] impl The simulator implementation.
+   * \returns The events run by each node.
+   */
+  std::vector<Log> RunScenario (Ptr<SimulatorImpl> impl);
+  /**
+   * Event run by a node, which schedules an event on another node.
+   *
+   * \param [in] node The node.
+   * \param [in] value The event value.
+   */
+  void Handle (uint32_t node, uint32_t value);
+  /**
+   * Event run by a node, which schedules nothing.
+   *
+   * \param [in] node The node.
+   * \param [in] value The event value.
+   */
+  void Leaf (uint32_t node, uint32_t value);
+
+  uint32_t m_threads;            //!< Number of threads.
+  uint64_t m_lookahead;          //!< Lookahead, in ns.
+  std::vector<Log> m_logs;       //!< Events run by each node.
+  std::vector<uint8_t> m_badContext; //!< Whether a node ran an event with another context.
+};
+
+/** Number of nodes in the scenario. */
+static const uint32_t g_nodes = 16;
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (uint32_t threads, uint64_t lookahead)
+  : TestCase ("Check MultithreadedSimulatorImpl with " +
+              std::to_string (threads) + " threads and a lookahead of " +
+              std::to_string (lookahead) + " ns"),
+    m_threads (threads),
+    m_lookahead (lookahead)
+{}
+
+void
+MultithreadedSimulatorTestCase::Handle (uint32_t node, uint32_t value)
+{
+  if (Simulator::GetContext () != node)
+    {
+      m_badContext[node] = 1;
+    }
+  m_logs[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), value));
+  uint32_t next = (node * 7 + value) % g_nodes;
+  Simulator::ScheduleWithContext (next, NanoSeconds (1000 + (value * 37 + node) % 13000),
+                                  &MultithreadedSimulatorTestCase::Handle, this, next, value + 1);
+  if (value % 3 == 0)
+    {
+      Simulator::Schedule (NanoSeconds (100 + node), &MultithreadedSimulatorTestCase::Leaf, this, node, value);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::Leaf (uint32_t node, uint32_t value)
+{
+  if (Simulator::GetContext () != node)
+    {
+      m_badContext[node] = 1;
+    }
+  m_logs[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), value + 1000000));
+}
+
+std::vector<MultithreadedSimulatorTestCase::Log>
+MultithreadedSimulatorTestCase::RunScenario (Ptr<SimulatorImpl> impl)
+{
+  Simulator::SetImplementation (impl);
+  m_logs.assign (g_nodes, Log ());
+  m_badContext.assign (g_nodes, 0);
+  for (uint32_t i = 0; i < g_nodes; ++i)
+    {
+      Simulator::ScheduleWithContext (i, NanoSeconds (10 * i), &MultithreadedSimulatorTestCase::Handle, this, i, 0);
+    }
+  Simulator::Stop (MilliSeconds (2));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (2), "Simulation did not stop on time");
+  Simulator::Destroy ();
+  for (uint32_t i = 0; i < g_nodes; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t) m_badContext[i], 0, "Node " << i << " ran an event with a bad context");
+      // Events of a node at the same time may run in a different order.
+      std::sort (m_logs[i].begin (), m_logs[i].end ());
+    }
+  return m_logs;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  std::vector<Log> expected = RunScenario (CreateObject<DefaultSimulatorImpl> ());
+
+  ObjectFactory factory ("ns3::MultithreadedSimulatorImpl");
+  factory.Set ("Threads", UintegerValue (m_threads));
+  factory.Set ("Lookahead", TimeValue (NanoSeconds (m_lookahead)));
+  Ptr<MultithreadedSimulatorImpl> impl = factory.Create<MultithreadedSimulatorImpl> ();
+  std::vector<Log> logs = RunScenario (impl);
+
+  uint32_t events = 0;
+  for (uint32_t i = 0; i < g_nodes; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (logs[i].size (), expected[i].size (), "Node " << i << " ran a different number of events");
+      for (uint32_t j = 0; j < logs[i].size (); ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (logs[i][j].first, expected[i][j].first, "Node " << i << " event " << j << " ran at a different time");
+          NS_TEST_ASSERT_MSG_EQ (logs[i][j].second, expected[i][j].second, "Node " << i << " ran a different event");
+        }
+      events += logs[i].size ();
+    }
+  NS_TEST_EXPECT_MSG_GT (events, 1000, "Too few events were run");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLateEventCount (), 0, "No event should be late");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that events scheduled across partitions with less than the
+ * lookahead are delayed, but never run in the past.
+ */
+class MultithreadedSimulatorLateEventsTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorLateEventsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Event run by a node, which schedules an event on the next node.
+   *
+   * \param [in] node The node.
+   * \param [in] count Number of events left in the chain.
+   */
+  void Handle (uint32_t node, uint32_t count);
+  /** Event keeping node 1 busy until 500 us. */
+  void Busy (void);
+
+  std::vector<int64_t> m_lastTs;  //!< Last time stamp seen by each node.
+  bool m_pastEvent;               //!< Whether an event ran in the past of its node.
+  uint32_t m_events;              //!< Number of events in the chain run.
+};
+
+MultithreadedSimulatorLateEventsTestCase::MultithreadedSimulatorLateEventsTestCase ()
+  : TestCase ("Check MultithreadedSimulatorImpl late events")
+{}
+
+void
+MultithreadedSimulatorLateEventsTestCase::Handle (uint32_t node, uint32_t count)
+{
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  if (now < m_lastTs[node])
+    {
+      m_pastEvent = true;
+    }
+  m_lastTs[node] = now;
+  m_events++;
+  if (count > 0)
+    {
+      uint32_t next = (node + 1) % 2;
+      Simulator::ScheduleWithContext (next, NanoSeconds (10), &MultithreadedSimulatorLateEventsTestCase::Handle, this, next, count - 1);
+    }
+}
+
+void
+MultithreadedSimulatorLateEventsTestCase::Busy (void)
+{
+  m_lastTs[1] = Simulator::Now ().GetTimeStep ();
+  if (Simulator::Now () < MicroSeconds (500))
+    {
+      Simulator::Schedule (MicroSeconds (1), &MultithreadedSimulatorLateEventsTestCase::Busy, this);
+    }
+}
+
+void
+MultithreadedSimulatorLateEventsTestCase::DoRun (void)
+{
+  ObjectFactory factory ("ns3::MultithreadedSimulatorImpl");
+  factory.Set ("Threads", UintegerValue (2));
+  factory.Set ("Lookahead", TimeValue (MicroSeconds (100)));
+  Ptr<MultithreadedSimulatorImpl> impl = factory.Create<MultithreadedSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+
+  m_lastTs.assign (2, 0);
+  m_pastEvent = false;
+  m_events = 0;
+  Simulator::ScheduleWithContext (0, MicroSeconds (1), &MultithreadedSimulatorLateEventsTestCase::Handle, this, 0, 10);
+  Simulator::ScheduleWithContext (1, MicroSeconds (1), &MultithreadedSimulatorLateEventsTestCase::Busy, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_events, 11, "Events were lost");
+  NS_TEST_EXPECT_MSG_EQ (m_pastEvent, false, "An event ran in the past");
+  NS_TEST_EXPECT_MSG_GT (impl->GetLateEventCount (), 0, "Events should have been late");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The MultithreadedSimulatorImpl test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorTestCase (1, 1000), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (2, 1000), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (4, 1000), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (4, 0), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorLateEventsTestCase (), TestCase::QUICK);
+  }
+} g_multithreadedSimulatorTestSuite; ///< the test suite
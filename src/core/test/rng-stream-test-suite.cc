@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/rng-stream.h"
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Test for the creation of RngStream.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup randomvariable-tests
+ * Check that the streams created in sequence, which are derived from
+ * the previous stream, are the same as the streams created alone.
+ */
+class RngStreamSequenceTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamSequenceTestCase ();
+  /** Destructor. */
+  virtual ~RngStreamSequenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamSequenceTestCase::RngStreamSequenceTestCase ()
+  : TestCase ("Check the streams created in sequence")
+{}
+
+RngStreamSequenceTestCase::~RngStreamSequenceTestCase ()
+{}
+
+void
+RngStreamSequenceTestCase::DoRun (void)
+{
+  const uint32_t seed = 3;
+  const uint64_t first = 1000;
+  const uint32_t count = 16;
+  const uint32_t values = 4;
+
+  // Streams first..first+count-1, each derived from the previous one
+  std::vector<double> sequence;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      RngStream stream (seed, first + i, 2);
+      for (uint32_t j = 0; j < values; j++)
+        {
+          sequence.push_back (stream.RandU01 ());
+        }
+    }
+
+  // The same streams in reverse order, each computed from the seed
+  for (uint32_t i = count; i > 0; i--)
+    {
+      RngStream stream (seed, first + i - 1, 2);
+      for (uint32_t j = 0; j < values; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (stream.RandU01 (), sequence[(i - 1) * values + j],
+                                 "Stream " << first + i - 1 << " differs from the stream created in sequence");
+        }
+    }
+
+  // A stream of another seed is not derived from the last stream
+  RngStream last (seed, first, 2);
+  RngStream otherSeed (seed + 1, first + 1, 2);
+  double value = otherSeed.RandU01 ();
+  RngStream unrelated (seed, first + count, 2);
+  RngStream alone (seed + 1, first + 1, 2);
+  NS_TEST_EXPECT_MSG_EQ (alone.RandU01 (), value, "Stream of another seed derived from the last stream");
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test suite for the creation of RngStream.
+ */
+class RngStreamTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  RngStreamTestSuite ();
+};
+
+RngStreamTestSuite::RngStreamTestSuite ()
+  : TestSuite ("rng-stream", UNIT)
+{
+  AddTestCase (new RngStreamSequenceTestCase, TestCase::QUICK);
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * RngStreamTestSuite instance variable.
+ */
+static RngStreamTestSuite g_rngStreamTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -23,7 +23,13 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/event-trace.h"
+#include "ns3/simulator-impl.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +471,226 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  uint32_t Rand (void);
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_seed;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that bursts of close events are ordered with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory),
+    m_seed (1)
+{}
+
+uint32_t
+SchedulerOrderTestCase::Rand (void)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return (m_seed >> 8);
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  uint32_t uid = 0;
+  uint64_t now = 0;
+  std::vector<Scheduler::Event> pending;
+
+  // Bursts of events a few ns apart, as scheduled by a wireless channel
+  // for each receiver, some of them sharing the same time stamp.
+  for (uint32_t burst = 0; burst < 50; burst++)
+    {
+      uint64_t base = Rand () % 1000000;
+      for (uint32_t i = 0; i < 100; i++)
+        {
+          Scheduler::Event ev = { 0, { base + Rand () % 8, uid++, 0 } };
+          scheduler->Insert (ev);
+          pending.push_back (ev);
+        }
+    }
+  // Remove some of them again.
+  for (uint32_t i = 0; i < pending.size (); i += 7)
+    {
+      scheduler->Remove (pending[i]);
+    }
+  uint32_t expected = pending.size () - (pending.size () + 6) / 7;
+
+  // Drain the queue, scheduling new bursts in the future as we go.
+  Scheduler::EventKey last = { 0, 0, 0 };
+  uint32_t removed = 0;
+  uint32_t inserted = 0;
+  while (!scheduler->IsEmpty ())
+    {
+      Scheduler::Event peek = scheduler->PeekNext ();
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (peek.key.m_uid, ev.key.m_uid, "PeekNext and RemoveNext disagree");
+      if (removed > 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((last < ev.key), true, "Events out of order");
+        }
+      last = ev.key;
+      now = ev.key.m_ts;
+      removed++;
+      if (inserted < 5000 && (Rand () % 4) == 0)
+        {
+          uint64_t base = now + Rand () % 1000;
+          for (uint32_t i = 0; i < 20; i++)
+            {
+              Scheduler::Event next = { 0, { base + Rand () % 4, uid++, 0 } };
+              scheduler->Insert (next);
+              inserted++;
+            }
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (removed, expected + inserted, "Wrong number of events");
+}
+
+class EventTraceTestCase : public TestCase
+{
+public:
+  EventTraceTestCase ();
+  virtual void DoRun (void);
+  void Nop (void);
+};
+
+EventTraceTestCase::EventTraceTestCase ()
+  : TestCase ("Check that DefaultSimulatorImpl records the event list operations")
+{}
+
+void
+EventTraceTestCase::Nop (void)
+{}
+
+void
+EventTraceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("simulator-event-trace.bin");
+  ObjectFactory factory ("ns3::DefaultSimulatorImpl");
+  factory.Set ("EventTraceFile", StringValue (filename));
+  Simulator::SetImplementation (factory.Create<SimulatorImpl> ());
+
+  EventId a = Simulator::Schedule (MicroSeconds (10), &EventTraceTestCase::Nop, this);
+  EventId b = Simulator::Schedule (MicroSeconds (20), &EventTraceTestCase::Nop, this);
+  Simulator::ScheduleWithContext (7, MicroSeconds (30), &EventTraceTestCase::Nop, this);
+  Simulator::Remove (b);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  EventTrace::Operation ops[] = {
+    EventTrace::INSERT,
+    EventTrace::INSERT,
+    EventTrace::INSERT,
+    EventTrace::REMOVE,
+    EventTrace::REMOVE_NEXT,
+    EventTrace::REMOVE_NEXT
+  };
+  uint64_t ts[] = {
+    static_cast<uint64_t> (MicroSeconds (10).GetTimeStep ()),
+    static_cast<uint64_t> (MicroSeconds (20).GetTimeStep ()),
+    static_cast<uint64_t> (MicroSeconds (30).GetTimeStep ()),
+    static_cast<uint64_t> (MicroSeconds (20).GetTimeStep ()),
+    static_cast<uint64_t> (MicroSeconds (10).GetTimeStep ()),
+    static_cast<uint64_t> (MicroSeconds (30).GetTimeStep ())
+  };
+  uint32_t contexts[] = {
+    Simulator::NO_CONTEXT, Simulator::NO_CONTEXT, 7, Simulator::NO_CONTEXT, Simulator::NO_CONTEXT, 7
+  };
+  uint32_t uids[] = {
+    a.GetUid (), b.GetUid (), b.GetUid () + 1, b.GetUid (), a.GetUid (), b.GetUid () + 1
+  };
+
+  EventTrace trace;
+  NS_TEST_ASSERT_MSG_EQ (trace.OpenRead (filename), true, "Cannot open event trace");
+  EventTrace::Operation op;
+  Scheduler::EventKey key;
+  for (uint32_t i = 0; i < sizeof (ops) / sizeof (ops[0]); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (trace.Read (op, key), true, "Event trace too short");
+      NS_TEST_EXPECT_MSG_EQ (op, ops[i], "Wrong operation in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (key.m_ts, ts[i], "Wrong time stamp in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (key.m_context, contexts[i], "Wrong context in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (key.m_uid, uids[i], "Wrong uid in record " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (trace.Read (op, key), false, "Event trace too long");
+}
+
+class EventPoolTestCase : public TestCase
+{
+public:
+  EventPoolTestCase ();
+  virtual void DoRun (void);
+  void Count (uint64_t a, uint64_t b, uint64_t c, uint64_t d);
+  void Reschedule (uint32_t n);
+  uint64_t m_sum;
+  uint32_t m_count;
+};
+
+EventPoolTestCase::EventPoolTestCase ()
+  : TestCase ("Check that events allocated from the event pool are run and released")
+{}
+
+void
+EventPoolTestCase::Count (uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+  m_sum += a + b + c + d;
+  m_count++;
+}
+
+void
+EventPoolTestCase::Reschedule (uint32_t n)
+{
+  m_count++;
+  if (n > 0)
+    {
+      Simulator::Schedule (NanoSeconds (1), &EventPoolTestCase::Reschedule, this, n - 1);
+    }
+}
+
+void
+EventPoolTestCase::DoRun (void)
+{
+  m_sum = 0;
+  m_count = 0;
+  ObjectFactory factory ("ns3::DefaultSimulatorImpl");
+  factory.Set ("EventPool", BooleanValue (true));
+  Simulator::SetImplementation (factory.Create<SimulatorImpl> ());
+  NS_TEST_ASSERT_MSG_EQ (EventImpl::IsPoolEnabled (), true, "Event pool not enabled");
+
+  std::vector<EventId> ids;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i), &EventPoolTestCase::Count, this, 1, 2, 3, 4));
+    }
+  for (uint32_t i = 0; i < ids.size (); i += 2)
+    {
+      Simulator::Remove (ids[i]);
+    }
+  Simulator::Schedule (MicroSeconds (1), &EventPoolTestCase::Reschedule, this, 1000);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_count, 500 + 1001, "Wrong number of events run");
+  NS_TEST_EXPECT_MSG_EQ (m_sum, 500 * 10, "Wrong event arguments");
+
+  // Events allocated from the pool are released to it even once disabled.
+  factory.Set ("EventPool", BooleanValue (true));
+  Simulator::SetImplementation (factory.Create<SimulatorImpl> ());
+  EventId pooled = Simulator::Schedule (MicroSeconds (1), &EventPoolTestCase::Count, this, 1, 2, 3, 4);
+  EventImpl::EnablePool (false);
+  Simulator::Schedule (MicroSeconds (2), &EventPoolTestCase::Count, this, 1, 2, 3, 4);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 500 + 1001 + 2, "Wrong number of events run");
+  NS_TEST_EXPECT_MSG_EQ (EventImpl::IsPoolEnabled (), false, "Event pool still enabled");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +709,17 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+
+    AddTestCase (new EventTraceTestCase (), TestCase::QUICK);
+    AddTestCase (new EventPoolTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
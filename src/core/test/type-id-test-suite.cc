@@ -30,6 +30,7 @@
 #include "ns3/test.h"
 #include "ns3/log.h"
 #include "ns3/unused.h"
+#include "ns3/trace-source-accessor.h"
 
 using namespace std;
 
@@ -334,6 +335,84 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+//----------------------------
+//
+// Test the lookups of the Attributes and TraceSources by name
+
+class LookupByNameTestCase : public TestCase
+{
+public:
+  LookupByNameTestCase ();
+  virtual ~LookupByNameTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+LookupByNameTestCase::LookupByNameTestCase ()
+  : TestCase ("Check the lookups of all the Attributes and TraceSources by name")
+{}
+
+LookupByNameTestCase::~LookupByNameTestCase ()
+{}
+
+void
+LookupByNameTestCase::DoRun (void)
+{
+  cerr << suite << endl;
+  cerr << suite << GetName () << endl;
+
+  uint16_t nids = TypeId::GetRegisteredN ();
+  for (uint16_t i = 0; i < nids; ++i)
+    {
+      const TypeId tid = TypeId::GetRegistered (i);
+      // Every supported Attribute and TraceSource of the type and of its
+      // parents must be found, in the type which registered it
+      TypeId owner = tid;
+      while (true)
+        {
+          for (std::size_t j = 0; j < owner.GetAttributeN (); ++j)
+            {
+              struct TypeId::AttributeInformation expected = owner.GetAttribute (j);
+              if (expected.supportLevel != TypeId::SUPPORTED)
+                {
+                  continue;
+                }
+              struct TypeId::AttributeInformation ainfo;
+              NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (expected.name, &ainfo), true,
+                                     "lookup " << tid.GetName () << "::" << expected.name);
+              NS_TEST_ASSERT_MSG_EQ (ainfo.checker, expected.checker,
+                                     "wrong Attribute " << tid.GetName () << "::" << expected.name);
+            }
+          for (std::size_t j = 0; j < owner.GetTraceSourceN (); ++j)
+            {
+              struct TypeId::TraceSourceInformation expected = owner.GetTraceSource (j);
+              if (expected.supportLevel != TypeId::SUPPORTED)
+                {
+                  continue;
+                }
+              struct TypeId::TraceSourceInformation tinfo;
+              Ptr<const TraceSourceAccessor> acc = tid.LookupTraceSourceByName (expected.name, &tinfo);
+              NS_TEST_ASSERT_MSG_EQ (acc, expected.accessor,
+                                     "lookup " << tid.GetName () << "::" << expected.name);
+            }
+          if (!owner.HasParent () || owner.GetParent ().GetUid () == 0)
+            {
+              break;
+            }
+          owner = owner.GetParent ();
+        }
+
+      struct TypeId::AttributeInformation ainfo;
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("NoSuchAttribute", &ainfo), false,
+                             "lookup of a missing Attribute in " << tid.GetName ());
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName ("NoSuchTraceSource"), 0,
+                             "lookup of a missing TraceSource in " << tid.GetName ());
+    }
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -394,6 +473,33 @@ LookupTimeTestCase::DoRun (void)
   stop = clock ();
   Report ("hash", stop - start);
 
+  // Look up the last Attribute of every type, which is the last one
+  // compared in that type
+  std::vector<std::pair<TypeId, std::string> > attributes;
+  for (uint16_t i = 0; i < nids; ++i)
+    {
+      const TypeId tid = TypeId::GetRegistered (i);
+      std::size_t n = tid.GetAttributeN ();
+      if (n > 0 && tid.GetAttribute (n - 1).supportLevel == TypeId::SUPPORTED)
+        {
+          attributes.push_back (std::make_pair (tid, tid.GetAttribute (n - 1).name));
+        }
+    }
+  struct TypeId::AttributeInformation info;
+  start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS / 10; ++j)
+    {
+      for (std::size_t i = 0; i < attributes.size (); ++i)
+        {
+          attributes[i].first.LookupAttributeByName (attributes[i].second, &info);
+        }
+    }
+  stop = clock ();
+  cout << suite << "Lookup time: by attribute name: "
+       << "ticks: " << stop - start
+       << "\tper: " << 1E6 * double (stop - start) / (double (attributes.size ()) * (REPETITIONS / 10) * double (CLOCKS_PER_SEC))
+       << " microsec/lookup"
+       << endl;
 }
 
 void
@@ -447,6 +553,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new LookupByNameTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
@@ -22,10 +22,13 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/abort.h"
 #include <fstream>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
+// width of the time buckets in which the tracked packets are checked for losses
+#define LOSS_BUCKET_WIDTH (Seconds (1))
 
 namespace ns3 {
 
@@ -33,6 +36,26 @@ NS_LOG_COMPONENT_DEFINE ("FlowMonitor");
 
 NS_OBJECT_ENSURE_REGISTERED (FlowMonitor);
 
+/// The magic number starting a binary snapshot file
+static const char SNAPSHOT_MAGIC[8] = {'N', 'S', '3', 'F', 'L', 'S', 'N', 'P'};
+/// The version of the binary snapshot format
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * Write a column of a binary snapshot.
+ * \param os the snapshot file
+ * \param column the values of the column
+ */
+template <typename T>
+static void
+WriteSnapshotColumn (std::ostream &os, const std::vector<T> &column)
+{
+  if (!column.empty ())
+    {
+      os.write (reinterpret_cast<const char *> (&column[0]), column.size () * sizeof (T));
+    }
+}
+
 TypeId 
 FlowMonitor::GetTypeId (void)
 {
@@ -80,7 +103,8 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_enabled (false),
+    m_snapshotFormat (SNAPSHOT_BINARY)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -91,6 +115,12 @@ FlowMonitor::DoDispose (void)
   NS_LOG_FUNCTION (this);
   Simulator::Cancel (m_startEvent);
   Simulator::Cancel (m_stopEvent);
+  Simulator::Cancel (m_snapshotEvent);
+  if (m_snapshotStream.is_open ())
+    {
+      m_snapshotStream.close ();
+    }
+  m_lastSnapshot.clear ();
   for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin ();
       iter != m_classifiers.end ();
       iter ++)
@@ -102,9 +132,23 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_trackedPackets.Clear ();
+  m_lossBuckets.clear ();
   Object::DoDispose ();
 }
 
+uint64_t
+FlowMonitor::GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId)
+{
+  return (static_cast<uint64_t> (flowId) << 32) | packetId;
+}
+
+int64_t
+FlowMonitor::GetLossBucket (Time time)
+{
+  return time.GetTimeStep () / LOSS_BUCKET_WIDTH.GetTimeStep ();
+}
+
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
@@ -146,7 +190,13 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  uint64_t key = GetTrackedPacketKey (flowId, packetId);
+  std::pair<TrackedPacket *, bool> insert = m_trackedPackets.Insert (key);
+  TrackedPacket &tracked = *insert.first;
+  if (insert.second || GetLossBucket (tracked.lastSeenTime) != GetLossBucket (now))
+    {
+      m_lossBuckets[GetLossBucket (now)].push_back (key);
+    }
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
@@ -175,19 +225,24 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
-  if (tracked == m_trackedPackets.end ())
+  uint64_t key = GetTrackedPacketKey (flowId, packetId);
+  TrackedPacket *tracked = m_trackedPackets.Find (key);
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
       return;
     }
 
-  tracked->second.timesForwarded++;
-  tracked->second.lastSeenTime = Simulator::Now ();
+  Time now = Simulator::Now ();
+  if (GetLossBucket (tracked->lastSeenTime) != GetLossBucket (now))
+    {
+      m_lossBuckets[GetLossBucket (now)].push_back (key);
+    }
+  tracked->timesForwarded++;
+  tracked->lastSeenTime = now;
 
-  Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
+  Time delay = (now - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 }
 
@@ -201,8 +256,9 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked == m_trackedPackets.end ())
+  uint64_t key = GetTrackedPacketKey (flowId, packetId);
+  TrackedPacket *tracked = m_trackedPackets.Find (key);
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
@@ -210,7 +266,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     }
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
+  Time delay = (now - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
   FlowStats &stats = GetStatsForFlow (flowId);
@@ -249,12 +305,12 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
+  stats.timesForwarded += tracked->timesForwarded;
 
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  m_trackedPackets.Erase (key); // we don't need to track this packet anymore
 }
 
 void
@@ -281,14 +337,12 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked != m_trackedPackets.end ())
+  // we don't need to track this packet anymore
+  // FIXME: this will not necessarily be true with broadcast/multicast
+  if (m_trackedPackets.Erase (GetTrackedPacketKey (flowId, packetId)))
     {
-      // we don't need to track this packet anymore
-      // FIXME: this will not necessarily be true with broadcast/multicast
-      NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
+      NS_LOG_DEBUG ("ReportDrop: removed tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
     }
 }
 
@@ -305,22 +359,44 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
   NS_LOG_FUNCTION (this << maxDelay.As (Time::S));
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // only the buckets starting before now - maxDelay may hold lost packets
+  int64_t lastBucket = GetLossBucket (now - maxDelay);
+  std::map<int64_t, std::vector<uint64_t> >::iterator bucket = m_lossBuckets.begin ();
+  while (bucket != m_lossBuckets.end () && bucket->first <= lastBucket)
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      std::vector<uint64_t> &keys = bucket->second;
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < keys.size (); i++)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          TrackedPacket *tracked = m_trackedPackets.Find (keys[i]);
+          if (tracked == 0 || GetLossBucket (tracked->lastSeenTime) != bucket->first)
+            {
+              // the packet was received, dropped, or seen again later
+              continue;
+            }
+          if (now - tracked->lastSeenTime >= maxDelay)
+            {
+              // packet is considered lost, add it to the loss statistics
+              FlowStatsContainerI flow = m_flowStats.find (static_cast<FlowId> (keys[i] >> 32));
+              NS_ASSERT (flow != m_flowStats.end ());
+              flow->second.lostPackets++;
+
+              // we won't track it anymore
+              m_trackedPackets.Erase (keys[i]);
+            }
+          else
+            {
+              keys[kept++] = keys[i];
+            }
+        }
+      keys.resize (kept);
+      if (keys.empty ())
+        {
+          m_lossBuckets.erase (bucket++);
         }
       else
         {
-          iter++;
+          bucket++;
         }
     }
 }
@@ -522,6 +598,120 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
   os.close ();
 }
 
+void
+FlowMonitor::EnableSnapshots (std::string fileName, Time interval, SnapshotFormat format)
+{
+  NS_LOG_FUNCTION (this << fileName << interval.As (Time::S) << format);
+  NS_ABORT_MSG_IF (interval <= Seconds (0), "The snapshot interval must be positive");
+  Simulator::Cancel (m_snapshotEvent);
+  if (m_snapshotStream.is_open ())
+    {
+      m_snapshotStream.close ();
+    }
+  m_snapshotStream.open (fileName.c_str (), std::ios::out | std::ios::binary);
+  NS_ABORT_MSG_IF (!m_snapshotStream, "Could not open snapshot file " << fileName);
+  m_snapshotFormat = format;
+  m_snapshotInterval = interval;
+  if (format == SNAPSHOT_BINARY)
+    {
+      m_snapshotStream.write (SNAPSHOT_MAGIC, sizeof (SNAPSHOT_MAGIC));
+      m_snapshotStream.write (reinterpret_cast<const char *> (&SNAPSHOT_VERSION), sizeof (SNAPSHOT_VERSION));
+    }
+  else
+    {
+      m_snapshotStream << "time,flowId,txPackets,txBytes,rxPackets,rxBytes,"
+                       << "lostPackets,timesForwarded,delaySum,jitterSum\n";
+    }
+  m_snapshotEvent = Simulator::Schedule (interval, &FlowMonitor::PeriodicSnapshot, this);
+}
 
-} // namespace ns3
+void
+FlowMonitor::PeriodicSnapshot ()
+{
+  WriteSnapshot ();
+  m_snapshotEvent = Simulator::Schedule (m_snapshotInterval, &FlowMonitor::PeriodicSnapshot, this);
+}
 
+void
+FlowMonitor::WriteSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (!m_snapshotStream.is_open (), "Snapshots are not enabled");
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+
+  std::vector<uint32_t> flowId;
+  std::vector<uint32_t> txPackets;
+  std::vector<uint64_t> txBytes;
+  std::vector<uint32_t> rxPackets;
+  std::vector<uint64_t> rxBytes;
+  std::vector<uint32_t> lostPackets;
+  std::vector<uint32_t> timesForwarded;
+  std::vector<int64_t> delaySum;
+  std::vector<int64_t> jitterSum;
+
+  // both maps are sorted by FlowId, so the hint is the right position
+  std::map<FlowId, SnapshotCounters>::iterator last = m_lastSnapshot.begin ();
+  for (FlowStatsContainerCI flow = m_flowStats.begin (); flow != m_flowStats.end (); flow++)
+    {
+      const FlowStats &stats = flow->second;
+      if (last == m_lastSnapshot.end () || last->first != flow->first)
+        {
+          SnapshotCounters zero = {0, 0, 0, 0, 0, 0, Seconds (0), Seconds (0)};
+          last = m_lastSnapshot.insert (last, std::make_pair (flow->first, zero));
+        }
+      SnapshotCounters &counters = last->second;
+      if (stats.txPackets != counters.txPackets || stats.rxPackets != counters.rxPackets
+          || stats.lostPackets != counters.lostPackets)
+        {
+          flowId.push_back (flow->first);
+          txPackets.push_back (stats.txPackets - counters.txPackets);
+          txBytes.push_back (stats.txBytes - counters.txBytes);
+          rxPackets.push_back (stats.rxPackets - counters.rxPackets);
+          rxBytes.push_back (stats.rxBytes - counters.rxBytes);
+          lostPackets.push_back (stats.lostPackets - counters.lostPackets);
+          timesForwarded.push_back (stats.timesForwarded - counters.timesForwarded);
+          delaySum.push_back ((stats.delaySum - counters.delaySum).GetNanoSeconds ());
+          jitterSum.push_back ((stats.jitterSum - counters.jitterSum).GetNanoSeconds ());
+          counters.txPackets = stats.txPackets;
+          counters.txBytes = stats.txBytes;
+          counters.rxPackets = stats.rxPackets;
+          counters.rxBytes = stats.rxBytes;
+          counters.lostPackets = stats.lostPackets;
+          counters.timesForwarded = stats.timesForwarded;
+          counters.delaySum = stats.delaySum;
+          counters.jitterSum = stats.jitterSum;
+        }
+      last++;
+    }
+
+  if (m_snapshotFormat == SNAPSHOT_BINARY)
+    {
+      uint32_t nFlows = flowId.size ();
+      m_snapshotStream.write (reinterpret_cast<const char *> (&now), sizeof (now));
+      m_snapshotStream.write (reinterpret_cast<const char *> (&nFlows), sizeof (nFlows));
+      WriteSnapshotColumn (m_snapshotStream, flowId);
+      WriteSnapshotColumn (m_snapshotStream, txPackets);
+      WriteSnapshotColumn (m_snapshotStream, txBytes);
+      WriteSnapshotColumn (m_snapshotStream, rxPackets);
+      WriteSnapshotColumn (m_snapshotStream, rxBytes);
+      WriteSnapshotColumn (m_snapshotStream, lostPackets);
+      WriteSnapshotColumn (m_snapshotStream, timesForwarded);
+      WriteSnapshotColumn (m_snapshotStream, delaySum);
+      WriteSnapshotColumn (m_snapshotStream, jitterSum);
+    }
+  else
+    {
+      for (std::size_t i = 0; i < flowId.size (); i++)
+        {
+          m_snapshotStream << now << ',' << flowId[i] << ',' << txPackets[i] << ',' << txBytes[i]
+                           << ',' << rxPackets[i] << ',' << rxBytes[i] << ',' << lostPackets[i]
+                           << ',' << timesForwarded[i] << ',' << delaySum[i] << ',' << jitterSum[i]
+                           << '\n';
+        }
+    }
+  // keep the file usable if the run is interrupted
+  m_snapshotStream.flush ();
+  NS_ABORT_MSG_IF (!m_snapshotStream, "Could not write the snapshot");
+}
+
+} // namespace ns3
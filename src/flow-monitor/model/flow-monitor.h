@@ -23,11 +23,13 @@
 
 #include <vector>
 #include <map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/flow-probe.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/flow-hash-table.h"
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -258,6 +260,52 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  // --- periodic snapshots ---
+
+  /// Format of the snapshot files
+  enum SnapshotFormat
+  {
+    SNAPSHOT_BINARY, //!< columnar binary records
+    SNAPSHOT_CSV     //!< one comma separated line per flow and snapshot
+  };
+
+  /// Write, every interval from now on, what changed in the statistics
+  /// of each flow since the previous snapshot, so that long runs yield
+  /// time series without keeping them in memory.  A snapshot lists, for
+  /// each flow whose counters changed, the increments of txPackets,
+  /// txBytes, rxPackets, rxBytes, lostPackets, timesForwarded, delaySum
+  /// and jitterSum.  The FlowIds are those of the XML output.
+  ///
+  /// In the CSV format, the first line names the columns, and each
+  /// following line holds the time of the snapshot and the increments
+  /// of a flow, with the times in nanoseconds.  The binary format, in
+  /// host byte order, is:
+  /// \verbatim
+  ///   char     magic[8]       "NS3FLSNP"
+  ///   uint32_t version        1
+  ///   then, for each snapshot:
+  ///   int64_t  time           time of the snapshot (ns)
+  ///   uint32_t nFlows         number N of flows in the snapshot
+  ///   uint32_t flowId[N]
+  ///   uint32_t txPackets[N]
+  ///   uint64_t txBytes[N]
+  ///   uint32_t rxPackets[N]
+  ///   uint64_t rxBytes[N]
+  ///   uint32_t lostPackets[N]
+  ///   uint32_t timesForwarded[N]
+  ///   int64_t  delaySum[N]    (ns)
+  ///   int64_t  jitterSum[N]   (ns)
+  /// \endverbatim
+  /// src/flow-monitor/examples/flowmon-snapshots.py reads both formats.
+  /// \param fileName name or path of the output file that will be created
+  /// \param interval the time between two snapshots
+  /// \param format the format of the file
+  void EnableSnapshots (std::string fileName, Time interval, SnapshotFormat format = SNAPSHOT_BINARY);
+
+  /// Write a snapshot right now; call it after Simulator::Run to record
+  /// the last, partial, interval.
+  void WriteSnapshot ();
+
 
 protected:
 
@@ -277,9 +325,27 @@ private:
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
 
+  /// Hash of the key of a tracked packet
+  struct TrackedPacketHash
+  {
+    /**
+     * \param key the FlowId in the high 32 bits and the FlowPacketId in
+     * the low 32 bits
+     * \returns the hash of the key
+     */
+    uint64_t operator() (uint64_t key) const
+    {
+      return FlowHashMix (key);
+    }
+  };
+
   /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  typedef FlowHashTable<uint64_t, TrackedPacket, TrackedPacketHash> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /// Index of the time bucket --> keys of the tracked packets last seen in it.
+  /// A key is added when the packet is seen in a new bucket, and left in
+  /// the old one, where it is skipped when the bucket is checked.
+  std::map<int64_t, std::vector<uint64_t> > m_lossBuckets;
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -295,6 +361,14 @@ private:
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
 
+  /// \param flowId the Flow identification
+  /// \param packetId the Packet ID
+  /// \returns the key of the packet in m_trackedPackets
+  static uint64_t GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId);
+  /// \param time a time
+  /// \returns the index of the time bucket of m_lossBuckets holding it
+  static int64_t GetLossBucket (Time time);
+
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
@@ -302,6 +376,29 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Periodic function to write the snapshots
+  void PeriodicSnapshot ();
+
+  /// The counters of a flow written in the last snapshot
+  struct SnapshotCounters
+  {
+    uint64_t txBytes;         //!< transmitted bytes
+    uint64_t rxBytes;         //!< received bytes
+    uint32_t txPackets;       //!< transmitted packets
+    uint32_t rxPackets;       //!< received packets
+    uint32_t lostPackets;     //!< lost packets
+    uint32_t timesForwarded;  //!< times the received packets were forwarded
+    Time delaySum;            //!< sum of the delays
+    Time jitterSum;           //!< sum of the jitters
+  };
+
+  std::ofstream m_snapshotStream;   //!< the snapshot file
+  SnapshotFormat m_snapshotFormat;  //!< the format of the snapshot file
+  Time m_snapshotInterval;          //!< the time between two snapshots
+  EventId m_snapshotEvent;          //!< the next snapshot
+  /// FlowId --> counters written in the last snapshot
+  std::map<FlowId, SnapshotCounters> m_lastSnapshot;
 };
 
 
@@ -96,6 +96,17 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 
 
 
+uint64_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &tuple) const
+{
+  uint64_t addresses = (static_cast<uint64_t> (tuple.sourceAddress.Get ()) << 32)
+    | tuple.destinationAddress.Get ();
+  uint64_t ports = (static_cast<uint64_t> (tuple.protocol) << 32)
+    | (static_cast<uint64_t> (tuple.sourcePort) << 16) | tuple.destinationPort;
+  return FlowHashMix (addresses ^ FlowHashMix (ports));
+}
+
+
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
 }
@@ -148,35 +159,29 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-    = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
+  std::pair<FlowId *, bool> insert = m_flowMap.Insert (tuple);
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
-      insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      NS_ASSERT (newFlowId == m_flows.size () + 1);
+      *insert.first = newFlowId;
+      m_flows.push_back (FlowInfo ());
+      m_flows.back ().tuple = tuple;
+      m_flows.back ().lastPacketId = 0;
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      m_flows[*insert.first - 1].lastPacketId++;
     }
+  FlowInfo &flow = m_flows[*insert.first - 1];
 
   // increment the counter of packets with the same DSCP value
-  Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
-    {
-      m_flowDscpMap[insert.first->second][dscp] ++;
-    }
+  flow.dscpCounts[ipHeader.GetDscp ()]++;
 
-  *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_flowId = *insert.first;
+  *out_packetId = flow.lastPacketId;
 
   return true;
 }
@@ -185,13 +190,9 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId > 0 && flowId <= m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      return m_flows[flowId - 1].tuple;
     }
   NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
   FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
@@ -208,15 +209,13 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  const std::map<Ipv4Header::DscpType, uint32_t> &counts = m_flows[flowId - 1].dscpCounts;
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (counts.begin (), counts.end ());
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -227,8 +226,16 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  // list the flows in the order of their tuples
+  std::vector<std::pair<FiveTuple, FlowId> > flows;
+  flows.reserve (m_flows.size ());
+  for (uint32_t i = 0; i < m_flows.size (); i++)
+    {
+      flows.push_back (std::make_pair (m_flows[i].tuple, i + 1));
+    }
+  std::sort (flows.begin (), flows.end ());
+  for (std::vector<std::pair<FiveTuple, FlowId> >::const_iterator
+       iter = flows.begin (); iter != flows.end (); iter++)
     {
       Indent (os, indent);
       os << "<Flow flowId=\"" << iter->second << "\""
@@ -239,17 +246,12 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
          << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      const std::map<Ipv4Header::DscpType, uint32_t> &counts = m_flows[iter->second - 1].dscpCounts;
+      for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = counts.begin (); i != counts.end (); i++)
         {
-          for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
@@ -23,9 +23,11 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/flow-hash-table.h"
 
 namespace ns3 {
 
@@ -92,12 +94,29 @@ public:
 
 private:
 
+  /// Hash of a FiveTuple
+  struct FiveTupleHash
+  {
+    /**
+     * \param tuple the tuple
+     * \returns the hash of the tuple
+     */
+    uint64_t operator() (const FiveTuple &tuple) const;
+  };
+
+  /// Structure holding what is known of a flow
+  struct FlowInfo
+  {
+    FiveTuple tuple;              //!< the tuple of the flow
+    FlowPacketId lastPacketId;    //!< the identifier of the last packet of the flow
+    /// (DSCP value, packet count) pairs
+    std::map<Ipv4Header::DscpType, uint32_t> dscpCounts;
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  FlowHashTable<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// The flows, indexed by FlowId - 1 since the FlowIds are allocated in sequence
+  std::vector<FlowInfo> m_flows;
 
 };
 
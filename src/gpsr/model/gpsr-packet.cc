@@ -104,9 +104,10 @@ operator<< (std::ostream & os, TypeHeader const & h)
 //-----------------------------------------------------------------------------
 // HELLO
 //-----------------------------------------------------------------------------
-HelloHeader::HelloHeader (uint64_t originPosx, uint64_t originPosy)
+HelloHeader::HelloHeader (uint64_t originPosx, uint64_t originPosy, Mac48Address hardwareAddress)
   : m_originPosx (originPosx),
-    m_originPosy (originPosy)
+    m_originPosy (originPosy),
+    m_hardwareAddress (hardwareAddress)
 {
 }
 
@@ -131,7 +132,7 @@ HelloHeader::GetInstanceTypeId () const
 uint32_t
 HelloHeader::GetSerializedSize () const
 {
-  return 16;
+  return 22;
 }
 
 void
@@ -142,6 +143,7 @@ HelloHeader::Serialize (Buffer::Iterator i) const
 
   i.WriteHtonU64 (m_originPosx);
   i.WriteHtonU64 (m_originPosy);
+  WriteTo (i, m_hardwareAddress);
 
 }
 
@@ -153,6 +155,7 @@ HelloHeader::Deserialize (Buffer::Iterator start)
 
   m_originPosx = i.ReadNtohU64 ();
   m_originPosy = i.ReadNtohU64 ();
+  ReadFrom (i, m_hardwareAddress);
 
   NS_LOG_DEBUG ("Deserialize X " << m_originPosx << " Y " << m_originPosy);
 
@@ -165,7 +168,8 @@ void
 HelloHeader::Print (std::ostream &os) const
 {
   os << " PositionX: " << m_originPosx
-     << " PositionY: " << m_originPosy;
+     << " PositionY: " << m_originPosy
+     << " MAC: " << m_hardwareAddress;
 }
 
 std::ostream &
@@ -180,7 +184,8 @@ operator<< (std::ostream & os, HelloHeader const & h)
 bool
 HelloHeader::operator== (HelloHeader const & o) const
 {
-  return (m_originPosx == o.m_originPosx && m_originPosy == o.m_originPosy);
+  return (m_originPosx == o.m_originPosx && m_originPosy == o.m_originPosy
+          && m_hardwareAddress == o.m_hardwareAddress);
 }
 
 
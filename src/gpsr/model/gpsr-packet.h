@@ -7,6 +7,7 @@
 #include "ns3/header.h"
 #include "ns3/enum.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/mac48-address.h"
 #include <map>
 #include "ns3/nstime.h"
 #include "ns3/vector.h"
@@ -64,7 +65,7 @@ class HelloHeader : public Header
 {
 public:
   /// c-tor
-  HelloHeader (uint64_t originPosx = 0, uint64_t originPosy = 0);
+  HelloHeader (uint64_t originPosx = 0, uint64_t originPosy = 0, Mac48Address hardwareAddress = Mac48Address ());
 
   ///\name Header serialization/deserialization
   //\{
@@ -94,6 +95,14 @@ public:
   {
     return m_originPosy;
   }
+  void SetHardwareAddress (Mac48Address hardwareAddress)
+  {
+    m_hardwareAddress = hardwareAddress;
+  }
+  Mac48Address GetHardwareAddress () const
+  {
+    return m_hardwareAddress;
+  }
   //\}
 
 
@@ -101,6 +110,7 @@ public:
 private:
   uint64_t         m_originPosx;          ///< Originator Position x
   uint64_t         m_originPosy;          ///< Originator Position x
+  Mac48Address     m_hardwareAddress;     ///< Originator MAC address, 00:00:00:00:00:00 if unknown
 };
 
 std::ostream & operator<< (std::ostream & os, HelloHeader const &);
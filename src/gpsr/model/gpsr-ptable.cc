@@ -1,6 +1,7 @@
 #include "gpsr-ptable.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/position-snapshot.h"
 #include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("GpsrTable");
@@ -35,8 +36,15 @@ PositionTable::GetEntryUpdateTime (Ipv4Address id)
  * \brief Adds entry in position table
  */
 void 
-PositionTable::AddEntry (Ipv4Address id, Vector position)
+PositionTable::AddEntry (Ipv4Address id, Vector position, Mac48Address mac)
 {
+  if (mac != Mac48Address ())
+    {
+      for (std::vector<Ptr<ArpCache> >::const_iterator i = m_arp.begin (); i != m_arp.end (); ++i)
+        {
+          (*i)->LearnMacAddress (id, mac);
+        }
+    }
   std::map<Ipv4Address, std::pair<Vector, Time> >::iterator i = m_table.find (id);
   if (i != m_table.end () || id == i->first)
     {
@@ -72,7 +80,7 @@ PositionTable::GetPosition (Ipv4Address id)
       Ptr<Node> node = *i;
       if (node->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal () == id)
         {
-          return node->GetObject<MobilityModel> ()->GetPosition ();
+          return PositionSnapshot::GetPosition (node->GetObject<MobilityModel> ());
         }
     }
   return PositionTable::GetInvalidPosition ();
@@ -97,6 +105,16 @@ PositionTable::isNeighbour (Ipv4Address id)
   return false;
 }
 
+/**
+ * \brief Gets the number of neighbours in the table
+ * \return The number of entries
+ */
+uint32_t
+PositionTable::GetNNeighbours () const
+{
+  return m_table.size ();
+}
+
 
 /**
  * \brief remove entries with expired lifetime
@@ -260,6 +278,18 @@ PositionTable::GetAngle (Vector centrePos, Vector refPos, Vector node){
 
 
 
+void
+PositionTable::AddArpCache (Ptr<ArpCache> a)
+{
+  m_arp.push_back (a);
+}
+
+void
+PositionTable::DelArpCache (Ptr<ArpCache> a)
+{
+  m_arp.erase (std::remove (m_arp.begin (), m_arp.end (), a), m_arp.end ());
+}
+
 /**
  * \ProcessTxError
  */
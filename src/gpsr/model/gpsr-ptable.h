@@ -2,6 +2,7 @@
 #define GPSR_PTABLE_H
 
 #include <map>
+#include <vector>
 #include <cassert>
 #include <stdint.h>
 #include "ns3/ipv4.h"
@@ -12,6 +13,7 @@
 #include "ns3/mobility-model.h"
 #include "ns3/vector.h"
 #include "ns3/wifi-mac-header.h"
+#include "ns3/arp-cache.h"
 #include "ns3/random-variable-stream.h"
 #include <complex>
 
@@ -36,9 +38,13 @@ public:
   Time GetEntryUpdateTime (Ipv4Address id);
 
   /**
-   * \brief Adds entry in position table
+   * \brief Adds entry in position table, and the MAC address of the
+   * neighbor, if known, to the ARP caches
+   * \param id the address of the neighbor
+   * \param position the position of the neighbor
+   * \param mac the MAC address of the neighbor, 00:00:00:00:00:00 if unknown
    */
-  void AddEntry (Ipv4Address id, Vector position);
+  void AddEntry (Ipv4Address id, Vector position, Mac48Address mac = Mac48Address ());
 
   /**
    * \brief Deletes entry in position table
@@ -59,6 +65,12 @@ public:
    */
   bool isNeighbour (Ipv4Address id);
 
+  /**
+   * \brief Gets the number of neighbours in the table
+   * \return The number of entries
+   */
+  uint32_t GetNNeighbours () const;
+
   /**
    * \brief remove entries with expired lifetime
    */
@@ -69,6 +81,17 @@ public:
    */
   void Clear ();
 
+  /**
+   * \brief Add ARP cache to which the MAC addresses of the neighbors are added
+   * \param a pointer to the ARP cache to add
+   */
+  void AddArpCache (Ptr<ArpCache> a);
+  /**
+   * \brief Don't use given ARP cache any more (interface is down)
+   * \param a pointer to the ARP cache to delete
+   */
+  void DelArpCache (Ptr<ArpCache> a);
+
   /**
    * \Get Callback to ProcessTxError
    */
@@ -114,6 +137,8 @@ private:
   Callback<void, WifiMacHeader const &> m_txErrorCallback;
   // Process layer 2 TX error notification
   void ProcessTxError (WifiMacHeader const&);
+  // ARP caches to which the MAC addresses of the neighbors are added
+  std::vector<Ptr<ArpCache> > m_arp;
 
 
 
@@ -16,6 +16,7 @@
 #include "ns3/wifi-net-device.h"
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/double.h"
+#include "ns3/position-snapshot.h"
 #include <algorithm>
 #include <limits>
 
@@ -99,7 +100,8 @@ RoutingProtocol::RoutingProtocol ()
     MaxQueueTime (Seconds (30)),
     m_queue (MaxQueueLen, MaxQueueTime),
     HelloIntervalTimer (Timer::CANCEL_ON_DESTROY),
-    PerimeterMode (false)
+    PerimeterMode (false),
+    m_populateArpCache (true)
 {
 
   m_neighbors = PositionTable ();
@@ -124,6 +126,14 @@ RoutingProtocol::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&RoutingProtocol::PerimeterMode),
                    MakeBooleanChecker ())
+    .AddAttribute ("PopulateArpCache", "Indicates if the MAC addresses carried by the HELLO messages "
+                   "are added to the ARP caches, so that no ARP request is needed to reach the neighbors",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&RoutingProtocol::m_populateArpCache),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("RoutingDecision", "The next hop chosen for a packet.",
+                     MakeTraceSourceAccessor (&RoutingProtocol::m_routingDecisionTrace),
+                     "ns3::Ipv4RoutingDecision::TracedCallback")
   ;
   return tid;
 }
@@ -297,16 +307,17 @@ RoutingProtocol::SendPacketFromQueue (Ipv4Address dst)
   Vector myPos;
   
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
-  myPos.x = MM->GetPosition ().x;
-  myPos.y = MM->GetPosition ().y;
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  myPos.x = mmPosition.x;
+  myPos.y = mmPosition.y;
   Ipv4Address nextHop;
+  Vector dstPos = m_locationService->GetPosition (dst);
 
   if(m_neighbors.isNeighbour (dst))
     {
       nextHop = dst;
     }
   else{
-    Vector dstPos = m_locationService->GetPosition (dst);
     nextHop = m_neighbors.BestNeighbor (dstPos, myPos);
     if (nextHop == Ipv4Address::GetZero ())
       {
@@ -375,6 +386,7 @@ RoutingProtocol::SendPacketFromQueue (Ipv4Address dst)
         {
           route->SetSource (header.GetSource ());
         }
+      NotifyRoutingDecision (p, dst, dstPos, nextHop, false);
       ucb (route, p, header);
     }
   return true;
@@ -393,8 +405,9 @@ RoutingProtocol::RecoveryMode(Ipv4Address dst, Ptr<Packet> p, UnicastForwardCall
   Vector recPos;
 
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
-  positionX = MM->GetPosition ().x;
-  positionY = MM->GetPosition ().y;
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  positionX = mmPosition.x;
+  positionY = mmPosition.y;
   myPos.x = positionX;
   myPos.y = positionY;  
 
@@ -439,6 +452,7 @@ RoutingProtocol::RecoveryMode(Ipv4Address dst, Ptr<Packet> p, UnicastForwardCall
   route->SetSource (header.GetSource ());
 
   NS_LOG_LOGIC (route->GetOutputDevice () << " forwarding in Recovery to " << dst << " through " << route->GetGateway () << " packet " << p->GetUid ());
+  NotifyRoutingDecision (p, dst, Position, nextHop, true);
   ucb (route, p, header);
   return;
 }
@@ -470,6 +484,11 @@ RoutingProtocol::NotifyInterfaceUp (uint32_t interface)
   socket->SetAttribute ("IpTtl", UintegerValue (1));
   m_socketAddresses.insert (std::make_pair (socket, iface));
 
+  // Add the MAC addresses of the neighbors to the ARP cache of this interface
+  if (m_populateArpCache && l3->GetInterface (interface)->GetArpCache ())
+    {
+      m_neighbors.AddArpCache (l3->GetInterface (interface)->GetArpCache ());
+    }
 
   // Allow neighbor manager use this interface for layer 2 feedback if possible
   Ptr<NetDevice> dev = m_ipv4->GetNetDevice (m_ipv4->GetInterfaceForAddress (iface.GetLocal ()));
@@ -513,15 +532,15 @@ RoutingProtocol::RecvGPSR (Ptr<Socket> socket)
   Ipv4Address sender = inetSourceAddr.GetIpv4 ();
   Ipv4Address receiver = m_socketAddresses[socket].GetLocal ();
 
-  UpdateRouteToNeighbor (sender, receiver, Position);
+  UpdateRouteToNeighbor (sender, receiver, Position, hdr.GetHardwareAddress ());
 
 }
 
 
 void
-RoutingProtocol::UpdateRouteToNeighbor (Ipv4Address sender, Ipv4Address receiver, Vector Pos)
+RoutingProtocol::UpdateRouteToNeighbor (Ipv4Address sender, Ipv4Address receiver, Vector Pos, Mac48Address mac)
 {
-  m_neighbors.AddEntry (sender, Pos);
+  m_neighbors.AddEntry (sender, Pos, mac);
 
 }
 
@@ -535,6 +554,7 @@ RoutingProtocol::NotifyInterfaceDown (uint32_t interface)
   // Disable layer 2 link state monitoring (if possible)
   Ptr<Ipv4L3Protocol> l3 = m_ipv4->GetObject<Ipv4L3Protocol> ();
   Ptr<NetDevice> dev = l3->GetNetDevice (interface);
+  m_neighbors.DelArpCache (l3->GetInterface (interface)->GetArpCache ());
   Ptr<WifiNetDevice> wifi = dev->GetObject<WifiNetDevice> ();
   if (wifi != 0)
     {
@@ -706,14 +726,20 @@ RoutingProtocol::SendHello ()
 
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
 
-  positionX = MM->GetPosition ().x;
-  positionY = MM->GetPosition ().y;
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  positionX = mmPosition.x;
+  positionY = mmPosition.y;
 
   for (std::map<Ptr<Socket>, Ipv4InterfaceAddress>::const_iterator j = m_socketAddresses.begin (); j != m_socketAddresses.end (); ++j)
     {
       Ptr<Socket> socket = j->first;
       Ipv4InterfaceAddress iface = j->second;
       HelloHeader helloHeader (((uint64_t) positionX),((uint64_t) positionY));
+      Ptr<NetDevice> dev = socket->GetBoundNetDevice ();
+      if (dev && Mac48Address::IsMatchingType (dev->GetAddress ()))
+        {
+          helloHeader.SetHardwareAddress (Mac48Address::ConvertFrom (dev->GetAddress ()));
+        }
 
       Ptr<Packet> packet = Create<Packet> ();
       packet->AddHeader (helloHeader);
@@ -824,8 +850,9 @@ RoutingProtocol::AddHeaders (Ptr<Packet> p, Ipv4Address source, Ipv4Address dest
  
   Vector myPos;
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
-  myPos.x = MM->GetPosition ().x;
-  myPos.y = MM->GetPosition ().y;  
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  myPos.x = mmPosition.x;
+  myPos.y = mmPosition.y;
  
   Ipv4Address nextHop;
 
@@ -898,8 +925,9 @@ RoutingProtocol::Forwarding (Ptr<const Packet> packet, const Ipv4Header & header
 
   Vector myPos;
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
-  myPos.x = MM->GetPosition ().x;
-  myPos.y = MM->GetPosition ().y;  
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  myPos.x = mmPosition.x;
+  myPos.y = mmPosition.y;
 
   if(inRec == 1 && CalculateDistance (myPos, Position) < CalculateDistance (RecPosition, Position)){
     inRec = 0;
@@ -957,6 +985,7 @@ RoutingProtocol::Forwarding (Ptr<const Packet> packet, const Ipv4Header & header
           
           NS_LOG_LOGIC (route->GetOutputDevice () << " forwarding to " << dst << " from " << origin << " through " << route->GetGateway () << " packet " << p->GetUid ());
           
+          NotifyRoutingDecision (p, dst, Position, nextHop, false);
           ucb (route, p, header);
           return true;
         }
@@ -978,6 +1007,27 @@ RoutingProtocol::Forwarding (Ptr<const Packet> packet, const Ipv4Header & header
 
 
 
+void
+RoutingProtocol::NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst, Vector dstPos,
+                                        Ipv4Address nextHop, bool recovery)
+{
+  if (m_routingDecisionTrace.IsEmpty ())
+    {
+      return;
+    }
+  Ipv4RoutingDecision decision;
+  decision.time = Simulator::Now ();
+  decision.node = m_ipv4->GetObject<Node> ()->GetId ();
+  decision.packetUid = packet != 0 ? packet->GetUid () : 0;
+  decision.destination = dst;
+  decision.nextHop = nextHop;
+  // The progress of a greedy choice: how far the next hop is from the destination
+  decision.value = CalculateDistance (m_neighbors.GetPosition (nextHop), dstPos);
+  decision.exploration = recovery;
+  decision.nNeighbors = m_neighbors.GetNNeighbours ();
+  m_routingDecisionTrace (decision);
+}
+
 void
 RoutingProtocol::SetDownTarget (IpL4Protocol::DownTargetCallback callback)
 {
@@ -1036,8 +1086,9 @@ RoutingProtocol::RouteOutput (Ptr<Packet> p, const Ipv4Header &header,
 
   Vector myPos;
   Ptr<MobilityModel> MM = m_ipv4->GetObject<MobilityModel> ();
-  myPos.x = MM->GetPosition ().x;
-  myPos.y = MM->GetPosition ().y;  
+  Vector mmPosition = PositionSnapshot::GetPosition (MM);
+  myPos.x = mmPosition.x;
+  myPos.y = mmPosition.y;
 
 
   Ipv4Address nextHop;
@@ -1076,6 +1127,7 @@ RoutingProtocol::RouteOutput (Ptr<Packet> p, const Ipv4Header &header,
           sockerr = Socket::ERROR_NOROUTETOHOST;
           return Ptr<Ipv4Route> ();
         }
+      NotifyRoutingDecision (p, dst, dstPos, nextHop, false);
       return route;
     }
   else
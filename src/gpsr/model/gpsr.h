@@ -20,6 +20,8 @@
 #include "ns3/ipv4-route.h"
 #include "ns3/location-service.h"
 #include "ns3/god.h"
+#include "ns3/traced-callback.h"
+#include "ns3/ipv4-routing-decision.h"
 
 #include <map>
 #include <complex>
@@ -58,7 +60,7 @@ public:
   virtual void NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address);
   virtual void SetIpv4 (Ptr<Ipv4> ipv4);
   virtual void RecvGPSR (Ptr<Socket> socket);
-  virtual void UpdateRouteToNeighbor (Ipv4Address sender, Ipv4Address receiver, Vector Pos);
+  virtual void UpdateRouteToNeighbor (Ipv4Address sender, Ipv4Address receiver, Vector Pos, Mac48Address mac);
   virtual void SendHello ();
   virtual bool IsMyOwnAddress (Ipv4Address src);
 
@@ -115,6 +117,17 @@ private:
   void CheckQueue ();
 
   void RecoveryMode(Ipv4Address dst, Ptr<Packet> p, UnicastForwardCallback ucb, Ipv4Header header);
+
+  /**
+   * Reports the next hop chosen for a packet to the RoutingDecision trace
+   * \param packet The packet
+   * \param dst The destination of the packet
+   * \param dstPos The position of the destination
+   * \param nextHop The next hop
+   * \param recovery Whether the next hop was chosen in recovery mode
+   */
+  void NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst, Vector dstPos,
+                              Ipv4Address nextHop, bool recovery);
   
   uint32_t MaxQueueLen;                  ///< The maximum number of packets that we allow a routing protocol to buffer.
   Time MaxQueueTime;                     ///< The maximum period of time that a routing protocol is allowed to buffer a packet for.
@@ -125,10 +138,14 @@ private:
   uint8_t LocationServiceName;
   PositionTable m_neighbors;
   bool PerimeterMode;
+  /// Add the MAC addresses carried by the HELLO messages to the ARP caches
+  bool m_populateArpCache;
   std::list<Ipv4Address> m_queuedAddresses;
   Ptr<LocationService> m_locationService;
 
   IpL4Protocol::DownTargetCallback m_downTarget;
+  /// Trace of the next hops chosen for the packets
+  TracedCallback<const Ipv4RoutingDecision &> m_routingDecisionTrace;
 
 
 
@@ -2,6 +2,10 @@
 
 // Include a header file from your module to test.
 #include "ns3/gpsr.h"
+#include "ns3/gpsr-packet.h"
+#include "ns3/gpsr-ptable.h"
+#include "ns3/arp-cache.h"
+#include "ns3/packet.h"
 
 // An essential include is test.h
 #include "ns3/test.h"
@@ -46,6 +50,56 @@ GpsrTestCase1::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+/**
+ * \ingroup gpsr
+ * \ingroup tests
+ *
+ * \brief Check that the MAC address carried by a HELLO reaches the ARP caches.
+ */
+class GpsrHelloArpTestCase : public TestCase
+{
+public:
+  GpsrHelloArpTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GpsrHelloArpTestCase::GpsrHelloArpTestCase ()
+  : TestCase ("Check the MAC address of the HELLO messages and the ARP caches")
+{
+}
+
+void
+GpsrHelloArpTestCase::DoRun (void)
+{
+  Ipv4Address neighbor ("10.0.0.2");
+  Mac48Address mac ("00:00:00:00:00:02");
+
+  // The MAC address survives the serialization of the header
+  gpsr::HelloHeader hello (10, 20, mac);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (hello);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), hello.GetSerializedSize (), "Wrong size of the HELLO");
+  gpsr::HelloHeader received;
+  packet->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (received.GetOriginPosx (), 10, "Wrong position");
+  NS_TEST_EXPECT_MSG_EQ (received.GetHardwareAddress (), mac, "Wrong MAC address");
+
+  // A neighbor with a known MAC address is added to the ARP cache
+  Ptr<ArpCache> arp = CreateObject<ArpCache> ();
+  gpsr::PositionTable table;
+  table.AddArpCache (arp);
+  table.AddEntry (Ipv4Address ("10.0.0.3"), Vector (0, 0, 0));
+  NS_TEST_EXPECT_MSG_EQ ((arp->Lookup (Ipv4Address ("10.0.0.3")) == 0), true, "Unknown MAC address added");
+  table.AddEntry (neighbor, Vector (10, 20, 0), received.GetHardwareAddress ());
+  ArpCache::Entry *entry = arp->Lookup (neighbor);
+  NS_TEST_ASSERT_MSG_EQ ((entry != 0), true, "Neighbor not added to the ARP cache");
+  NS_TEST_EXPECT_MSG_EQ (entry->IsAlive (), true, "ARP entry not alive");
+  NS_TEST_EXPECT_MSG_EQ (Mac48Address::ConvertFrom (entry->GetMacAddress ()), mac, "Wrong MAC address in the ARP cache");
+  arp->Dispose ();
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -61,6 +115,7 @@ GpsrTestSuite::GpsrTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new GpsrTestCase1, TestCase::QUICK);
+  AddTestCase (new GpsrHelloArpTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
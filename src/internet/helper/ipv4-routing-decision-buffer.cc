@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "ipv4-routing-decision-buffer.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Ipv4RoutingDecisionBuffer");
+
+/// The magic number starting a routing decision file
+static const char ROUTING_DECISION_MAGIC[8] = {'N', 'S', '3', 'R', 'T', 'D', 'E', 'C'};
+/// The version of the routing decision file format
+static const uint32_t ROUTING_DECISION_VERSION = 1;
+
+Ipv4RoutingDecisionBuffer::Ipv4RoutingDecisionBuffer (uint32_t capacity)
+  : m_entries (capacity),
+    m_first (0),
+    m_size (0),
+    m_nRecorded (0)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  NS_ABORT_MSG_IF (capacity == 0, "The buffer must hold at least one decision");
+  NS_ASSERT (sizeof (Entry) == 48);
+}
+
+Ipv4RoutingDecisionBuffer::~Ipv4RoutingDecisionBuffer ()
+{
+  if (m_file.is_open ())
+    {
+      Flush ();
+      m_file.close ();
+    }
+}
+
+bool
+Ipv4RoutingDecisionBuffer::Connect (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  return Config::ConnectWithoutContextFailSafe (path, MakeCallback (&Ipv4RoutingDecisionBuffer::Record, this));
+}
+
+bool
+Ipv4RoutingDecisionBuffer::ConnectAll (void)
+{
+  return Connect ("/NodeList/*/$ns3::Ipv4RoutingProtocol/RoutingDecision");
+}
+
+void
+Ipv4RoutingDecisionBuffer::SetFile (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  if (m_file.is_open ())
+    {
+      Flush ();
+      m_file.close ();
+    }
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary);
+  NS_ABORT_MSG_IF (!m_file, "Could not open routing decision file " << filename);
+  WriteHeader (m_file);
+}
+
+void
+Ipv4RoutingDecisionBuffer::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (!m_file.is_open (), "No routing decision file was set");
+  WriteEntries (m_file);
+  m_file.flush ();
+  NS_ABORT_MSG_IF (!m_file, "Could not write the routing decisions");
+  m_first = 0;
+  m_size = 0;
+}
+
+void
+Ipv4RoutingDecisionBuffer::Write (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary);
+  WriteHeader (file);
+  WriteEntries (file);
+  file.close ();
+  NS_ABORT_MSG_IF (!file, "Could not write routing decision file " << filename);
+}
+
+void
+Ipv4RoutingDecisionBuffer::WriteHeader (std::ostream &os)
+{
+  uint32_t recordSize = sizeof (Entry);
+  os.write (ROUTING_DECISION_MAGIC, sizeof (ROUTING_DECISION_MAGIC));
+  os.write (reinterpret_cast<const char *> (&ROUTING_DECISION_VERSION), sizeof (ROUTING_DECISION_VERSION));
+  os.write (reinterpret_cast<const char *> (&recordSize), sizeof (recordSize));
+}
+
+void
+Ipv4RoutingDecisionBuffer::WriteEntries (std::ostream &os) const
+{
+  // at most two contiguous runs: from the oldest decision to the end
+  // of the vector, then from its start
+  uint32_t firstRun = std::min<uint32_t> (m_size, m_entries.size () - m_first);
+  os.write (reinterpret_cast<const char *> (&m_entries[m_first]), firstRun * sizeof (Entry));
+  if (firstRun < m_size)
+    {
+      os.write (reinterpret_cast<const char *> (&m_entries[0]), (m_size - firstRun) * sizeof (Entry));
+    }
+}
+
+void
+Ipv4RoutingDecisionBuffer::Record (const Ipv4RoutingDecision &decision)
+{
+  if (m_size == m_entries.size ())
+    {
+      if (m_file.is_open ())
+        {
+          Flush ();
+        }
+      else
+        {
+          // overwrite the oldest decision
+          m_first = (m_first + 1) % m_entries.size ();
+          m_size--;
+        }
+    }
+  Entry &entry = m_entries[(m_first + m_size) % m_entries.size ()];
+  std::memset (&entry, 0, sizeof (entry));
+  entry.time = decision.time.GetNanoSeconds ();
+  entry.packetUid = decision.packetUid;
+  entry.value = decision.value;
+  entry.node = decision.node;
+  entry.destination = decision.destination.Get ();
+  entry.nextHop = decision.nextHop.Get ();
+  entry.nNeighbors = decision.nNeighbors;
+  entry.exploration = decision.exploration;
+  m_size++;
+  m_nRecorded++;
+}
+
+uint32_t
+Ipv4RoutingDecisionBuffer::GetSize (void) const
+{
+  return m_size;
+}
+
+Ipv4RoutingDecision
+Ipv4RoutingDecisionBuffer::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_size);
+  const Entry &entry = m_entries[(m_first + i) % m_entries.size ()];
+  Ipv4RoutingDecision decision;
+  decision.time = NanoSeconds (entry.time);
+  decision.node = entry.node;
+  decision.packetUid = entry.packetUid;
+  decision.destination = Ipv4Address (entry.destination);
+  decision.nextHop = Ipv4Address (entry.nextHop);
+  decision.value = entry.value;
+  decision.exploration = entry.exploration != 0;
+  decision.nNeighbors = entry.nNeighbors;
+  return decision;
+}
+
+uint64_t
+Ipv4RoutingDecisionBuffer::GetNRecorded (void) const
+{
+  return m_nRecorded;
+}
+
+} // namespace ns3
@@ -356,6 +356,40 @@ ArpCache::Remove (ArpCache::Entry *entry)
   NS_LOG_WARN ("Entry not found in this ARP Cache");
 }
 
+void
+ArpCache::LearnMacAddress (Ipv4Address to, Address macAddress)
+{
+  NS_LOG_FUNCTION (this << to << macAddress);
+  ArpCache::Entry *entry = Lookup (to);
+  if (entry != 0 && entry->IsDead ())
+    {
+      Remove (entry);
+      entry = 0;
+    }
+  if (entry == 0)
+    {
+      entry = Add (to);
+      entry->SetMacAddress (macAddress);
+      entry->UpdateSeen ();
+    }
+  else if (entry->IsAlive ())
+    {
+      entry->SetMacAddress (macAddress);
+      entry->UpdateSeen ();
+    }
+  else if (entry->IsWaitReply ())
+    {
+      NS_LOG_LOGIC ("Learnt " << macAddress << " for waiting entry " << to << " -- flush");
+      entry->MarkAlive (macAddress);
+      Ipv4PayloadHeaderPair pending = entry->DequeuePending ();
+      while (pending.first != 0)
+        {
+          m_interface->Send (pending.first, pending.second, to);
+          pending = entry->DequeuePending ();
+        }
+    }
+}
+
 ArpCache::Entry::Entry (ArpCache *arp)
   : m_arp (arp),
     m_state (ALIVE),
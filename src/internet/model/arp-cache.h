@@ -165,6 +165,18 @@ public:
    * \param entry pointer to delete it from the list
    */
   void Remove (ArpCache::Entry *entry);
+  /**
+   * \brief Record the MAC address of a neighbor learnt by other means than
+   * ARP, e.g., from the HELLO messages of a routing protocol.
+   *
+   * A missing or dead entry is replaced by an alive entry, an alive entry
+   * is refreshed, and a waiting entry becomes alive and its pending
+   * packets are sent.  Permanent entries are left untouched.
+   *
+   * \param to the IPv4 address of the neighbor
+   * \param macAddress the MAC address of the neighbor
+   */
+  void LearnMacAddress (Ipv4Address to, Address macAddress);
   /**
    * \brief Clear the ArpCache of all entries
    */
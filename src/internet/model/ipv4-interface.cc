@@ -38,6 +38,9 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4Interface");
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv4Interface);
 
+/// The address generation, see Ipv4Interface::GetAddressGeneration
+static uint64_t g_addressGeneration = 1;
+
 TypeId 
 Ipv4Interface::GetTypeId (void)
 {
@@ -310,6 +313,7 @@ Ipv4Interface::AddAddress (Ipv4InterfaceAddress addr)
 {
   NS_LOG_FUNCTION (this << addr);
   m_ifaddrs.push_back (addr);
+  g_addressGeneration++;
   return true;
 }
 
@@ -353,6 +357,7 @@ Ipv4Interface::RemoveAddress (uint32_t index)
         {
           Ipv4InterfaceAddress addr = *i;
           m_ifaddrs.erase (i);
+          g_addressGeneration++;
           return addr;
         }
       ++tmp;
@@ -380,11 +385,18 @@ Ipv4Interface::RemoveAddress(Ipv4Address address)
         {
           Ipv4InterfaceAddress ifAddr = *it;
           m_ifaddrs.erase(it);
+          g_addressGeneration++;
           return ifAddr;
         }
     }
   return Ipv4InterfaceAddress();
 }
 
+uint64_t
+Ipv4Interface::GetAddressGeneration (void)
+{
+  return g_addressGeneration;
+}
+
 } // namespace ns3
 
@@ -188,6 +188,17 @@ public:
    */
   Ipv4InterfaceAddress RemoveAddress (Ipv4Address address);
 
+  /**
+   * \brief Get the address generation.
+   *
+   * The generation is a global counter incremented whenever an address
+   * is added to or removed from any interface, so that the caches of
+   * the addresses of the interfaces can tell whether they are stale.
+   *
+   * \returns the current address generation, never 0
+   */
+  static uint64_t GetAddressGeneration (void);
+
 protected:
   virtual void DoDispose (void);
 private:
@@ -86,6 +86,15 @@ Ipv4L3Protocol::GetTypeId (void)
                    TimeValue (Seconds (1)),
                    MakeTimeAccessor (&Ipv4L3Protocol::m_purge),
                    MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("FastForwarding",
+                   "Forward the packets received from a device without "
+                   "copying them when the routing protocol hands them "
+                   "to the unicast forward callback from RouteInput. "
+                   "The routing protocol must neither keep nor reuse "
+                   "the packets it forwards this way.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&Ipv4L3Protocol::m_fastForwarding),
+                   MakeBooleanChecker ())
     .AddTraceSource ("Tx",
                      "Send ipv4 packet to outgoing interface.",
                      MakeTraceSourceAccessor (&Ipv4L3Protocol::m_txTrace),
@@ -130,6 +139,8 @@ Ipv4L3Protocol::GetTypeId (void)
 }
 
 Ipv4L3Protocol::Ipv4L3Protocol()
+  : m_addressGeneration (0),
+    m_routedPacket (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -319,6 +330,10 @@ Ipv4L3Protocol::DoDispose (void)
     }
   m_interfaces.clear ();
   m_reverseInterfacesContainer.clear ();
+  m_interfaceDestinations.clear ();
+  m_destinations.clear ();
+  m_localAddresses.clear ();
+  m_addressGeneration = 0;
 
   m_sockets.clear ();
   m_node = 0;
@@ -448,18 +463,11 @@ Ipv4L3Protocol::GetInterfaceForAddress (
   Ipv4Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  int32_t interface = 0;
-  for (Ipv4InterfaceList::const_iterator i = m_interfaces.begin (); 
-       i != m_interfaces.end (); 
-       i++, interface++)
+  UpdateAddressCaches ();
+  AddressInterfaceMap_t::const_iterator i = m_localAddresses.find (address);
+  if (i != m_localAddresses.end ())
     {
-      for (uint32_t j = 0; j < (*i)->GetNAddresses (); j++)
-        {
-          if ((*i)->GetAddress (j).GetLocal () == address)
-            {
-              return interface;
-            }
-        }
+      return i->second;
     }
 
   return -1;
@@ -507,20 +515,19 @@ bool
 Ipv4L3Protocol::IsDestinationAddress (Ipv4Address address, uint32_t iif) const
 {
   NS_LOG_FUNCTION (this << address << iif);
-  // First check the incoming interface for a unicast address match
-  for (uint32_t i = 0; i < GetNAddresses (iif); i++)
-    {
-      Ipv4InterfaceAddress iaddr = GetAddress (iif, i);
-      if (address == iaddr.GetLocal ())
+  UpdateAddressCaches ();
+  // First check the incoming interface for a unicast or interface
+  // broadcast address match
+  NS_ASSERT (iif < m_interfaceDestinations.size ());
+  const std::vector<Ipv4Address> &destinations = m_interfaceDestinations[iif];
+  for (std::vector<Ipv4Address>::const_iterator i = destinations.begin ();
+       i != destinations.end (); i++)
+    {
+      if (address == *i)
         {
           NS_LOG_LOGIC ("For me (destination " << address << " match)");
           return true;
         }
-      if (address == iaddr.GetBroadcast ())
-        {
-          NS_LOG_LOGIC ("For me (interface broadcast address)");
-          return true;
-        }
     }
 
   if (address.IsMulticast ())
@@ -543,29 +550,46 @@ Ipv4L3Protocol::IsDestinationAddress (Ipv4Address address, uint32_t iif) const
 
   if (GetWeakEsModel ())  // Check other interfaces
     { 
-      for (uint32_t j = 0; j < GetNInterfaces (); j++)
+      //  This includes a small corner case:  match another interface's broadcast address
+      if (m_destinations.find (address) != m_destinations.end ())
         {
-          if (j == uint32_t (iif)) continue;
-          for (uint32_t i = 0; i < GetNAddresses (j); i++)
-            {
-              Ipv4InterfaceAddress iaddr = GetAddress (j, i);
-              if (address == iaddr.GetLocal ())
-                {
-                  NS_LOG_LOGIC ("For me (destination " << address << " match) on another interface");
-                  return true;
-                }
-              //  This is a small corner case:  match another interface's broadcast address
-              if (address == iaddr.GetBroadcast ())
-                {
-                  NS_LOG_LOGIC ("For me (interface broadcast address on another interface)");
-                  return true;
-                }
-            }
+          NS_LOG_LOGIC ("For me (destination " << address << " match) on another interface");
+          return true;
         }
     }
   return false;
 }
 
+void
+Ipv4L3Protocol::UpdateAddressCaches (void) const
+{
+  uint64_t generation = Ipv4Interface::GetAddressGeneration ();
+  if (generation == m_addressGeneration
+      && m_interfaceDestinations.size () == m_interfaces.size ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_addressGeneration = generation;
+  m_interfaceDestinations.assign (m_interfaces.size (), std::vector<Ipv4Address> ());
+  m_destinations.clear ();
+  m_localAddresses.clear ();
+  for (uint32_t interface = 0; interface < m_interfaces.size (); interface++)
+    {
+      Ptr<Ipv4Interface> ipv4Interface = m_interfaces[interface];
+      for (uint32_t j = 0; j < ipv4Interface->GetNAddresses (); j++)
+        {
+          Ipv4InterfaceAddress iaddr = ipv4Interface->GetAddress (j);
+          m_interfaceDestinations[interface].push_back (iaddr.GetLocal ());
+          m_interfaceDestinations[interface].push_back (iaddr.GetBroadcast ());
+          m_destinations.insert (iaddr.GetLocal ());
+          m_destinations.insert (iaddr.GetBroadcast ());
+          // The first interface holding an address wins
+          m_localAddresses.insert (std::make_pair (iaddr.GetLocal (), interface));
+        }
+    }
+}
+
 void 
 Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from,
                           const Address &to, NetDevice::PacketType packetType)
@@ -585,7 +609,10 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
 
   if (ipv4Interface->IsUp ())
     {
-      m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+      if (!m_rxTrace.IsEmpty ())
+        {
+          m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+        }
     }
   else
     {
@@ -661,12 +688,15 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
     }
 
   NS_ASSERT_MSG (m_routingProtocol != 0, "Need a routing protocol object to process packets");
-  if (!m_routingProtocol->RouteInput (packet, ipHeader, device,
-                                      MakeCallback (&Ipv4L3Protocol::IpForward, this),
-                                      MakeCallback (&Ipv4L3Protocol::IpMulticastForward, this),
-                                      MakeCallback (&Ipv4L3Protocol::LocalDeliver, this),
-                                      MakeCallback (&Ipv4L3Protocol::RouteInputError, this)
-                                      ))
+  // The packet is a copy private to this method, so it can be forwarded as is
+  m_routedPacket = PeekPointer (packet);
+  bool routed = m_routingProtocol->RouteInput (packet, ipHeader, device,
+                                               MakeCallback (&Ipv4L3Protocol::IpForward, this),
+                                               MakeCallback (&Ipv4L3Protocol::IpMulticastForward, this),
+                                               MakeCallback (&Ipv4L3Protocol::LocalDeliver, this),
+                                               MakeCallback (&Ipv4L3Protocol::RouteInputError, this));
+  m_routedPacket = 0;
+  if (!routed)
     {
       NS_LOG_WARN ("No route found for forwarding packet.  Drop.");
       m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), interface);
@@ -741,6 +771,10 @@ void
 Ipv4L3Protocol::CallTxTrace (const Ipv4Header & ipHeader, Ptr<Packet> packet,
                                     Ptr<Ipv4> ipv4, uint32_t interface)
 {
+  if (m_txTrace.IsEmpty ())
+    {
+      return;
+    }
   Ptr<Packet> packetCopy = packet->Copy ();
   packetCopy->AddHeader (ipHeader);
   m_txTrace (packetCopy, ipv4, interface);
@@ -1057,7 +1091,17 @@ Ipv4L3Protocol::IpForward (Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ip
   NS_LOG_LOGIC ("Forwarding logic for node: " << m_node->GetId ());
   // Forwarding
   Ipv4Header ipHeader = header;
-  Ptr<Packet> packet = p->Copy ();
+  Ptr<Packet> packet;
+  if (m_fastForwarding && PeekPointer (p) == m_routedPacket)
+    {
+      // Forward the packet received by Receive without copying it, once
+      m_routedPacket = 0;
+      packet = ConstCast<Packet> (p);
+    }
+  else
+    {
+      packet = p->Copy ();
+    }
   int32_t interface = GetInterfaceForDevice (rtentry->GetOutputDevice ());
   ipHeader.SetTtl (ipHeader.GetTtl () - 1);
   if (ipHeader.GetTtl () == 0)
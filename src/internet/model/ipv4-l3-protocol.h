@@ -24,6 +24,8 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -631,6 +633,27 @@ private:
   Time                m_expire;       //!< duplicate entry expiration delay
   Time                m_purge;        //!< time between purging expired duplicate entries
   EventId             m_cleanDpd;     //!< event to cleanup expired duplicate entries
+
+  /**
+   * \brief Rebuild the caches of the addresses of the interfaces if an
+   * address or an interface was added or removed since they were built.
+   */
+  void UpdateAddressCaches (void) const;
+
+  /// Local and broadcast addresses of each interface, indexed by interface
+  typedef std::vector<std::vector<Ipv4Address> > InterfaceDestinations_t;
+  /// Set of addresses
+  typedef std::unordered_set<Ipv4Address, Ipv4AddressHash> AddressSet_t;
+  /// Map of the local addresses to the first interface holding them
+  typedef std::unordered_map<Ipv4Address, int32_t, Ipv4AddressHash> AddressInterfaceMap_t;
+
+  mutable uint64_t m_addressGeneration;                     //!< address generation of the caches, 0 if never built
+  mutable InterfaceDestinations_t m_interfaceDestinations;  //!< local and broadcast addresses of each interface
+  mutable AddressSet_t m_destinations;                      //!< local and broadcast addresses of all the interfaces
+  mutable AddressInterfaceMap_t m_localAddresses;           //!< interface of each local address
+
+  bool m_fastForwarding;          //!< Forward the packet being received without copying it
+  const Packet *m_routedPacket;   //!< Packet being passed to the routing protocol by Receive, or 0
 };
 
 } // Namespace ns3
@@ -209,6 +209,14 @@ Ipv4ForwardingTest::DoRun (void)
   m_receivedPacket = 0;
 
   Ptr<Ipv4> ipv4 = fwNode->GetObject<Ipv4> ();
+  ipv4->SetAttribute ("FastForwarding", BooleanValue (true));
+  SendData (txSocket, "10.0.0.2");
+  NS_TEST_EXPECT_MSG_EQ (m_receivedPacket->GetSize (), 123, "IPv4 fast forwarding on");
+
+  m_receivedPacket->RemoveAllByteTags ();
+  m_receivedPacket = 0;
+
+  ipv4->SetAttribute ("FastForwarding", BooleanValue (false));
   ipv4->SetAttribute("IpForward", BooleanValue (false));
   SendData (txSocket, "10.0.0.2");
   NS_TEST_EXPECT_MSG_EQ (m_receivedPacket->GetSize (), 0, "IPv4 Forwarding off");
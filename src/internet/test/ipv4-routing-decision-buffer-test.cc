@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <cstring>
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include "ns3/ipv4-routing-decision-buffer.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the ring buffer and the files of Ipv4RoutingDecisionBuffer.
+ */
+class Ipv4RoutingDecisionBufferTest : public TestCase
+{
+public:
+  Ipv4RoutingDecisionBufferTest ()
+    : TestCase ("Check the ring buffer and the files of the routing decisions")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param i the index of the decision
+   * \returns a decision whose fields are derived from its index
+   */
+  static Ipv4RoutingDecision MakeDecision (uint32_t i);
+  /**
+   * Check the header and the records of a file.
+   * \param filename the name of the file
+   * \param first the index of the first decision expected in the file
+   * \param n the number of decisions expected in the file
+   */
+  void CheckFile (std::string filename, uint32_t first, uint32_t n);
+};
+
+Ipv4RoutingDecision
+Ipv4RoutingDecisionBufferTest::MakeDecision (uint32_t i)
+{
+  Ipv4RoutingDecision decision;
+  decision.time = MilliSeconds (i);
+  decision.node = i % 7;
+  decision.packetUid = 1000 + i;
+  decision.destination = Ipv4Address (0x0a000000 + i);
+  decision.nextHop = Ipv4Address (0x0a010000 + i);
+  decision.value = i * 0.5;
+  decision.exploration = (i % 3 == 0);
+  decision.nNeighbors = i % 11;
+  return decision;
+}
+
+void
+Ipv4RoutingDecisionBufferTest::CheckFile (std::string filename, uint32_t first, uint32_t n)
+{
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (is.good (), true, "Cannot open " << filename);
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  is.read (magic, sizeof (magic));
+  is.read (reinterpret_cast<char *> (&version), sizeof (version));
+  is.read (reinterpret_cast<char *> (&recordSize), sizeof (recordSize));
+  NS_TEST_ASSERT_MSG_EQ (std::memcmp (magic, "NS3RTDEC", 8), 0, "Wrong magic number");
+  NS_TEST_EXPECT_MSG_EQ (version, 1, "Wrong version");
+  NS_TEST_ASSERT_MSG_EQ (recordSize, 48, "Wrong record size");
+  for (uint32_t i = first; i < first + n; i++)
+    {
+      char record[48];
+      is.read (record, sizeof (record));
+      NS_TEST_ASSERT_MSG_EQ (is.gcount (), 48, "Missing record " << i);
+      int64_t time;
+      uint64_t uid;
+      double value;
+      uint32_t nextHop;
+      uint8_t exploration;
+      std::memcpy (&time, record, 8);
+      std::memcpy (&uid, record + 8, 8);
+      std::memcpy (&value, record + 16, 8);
+      std::memcpy (&nextHop, record + 32, 4);
+      std::memcpy (&exploration, record + 40, 1);
+      Ipv4RoutingDecision expected = MakeDecision (i);
+      NS_TEST_EXPECT_MSG_EQ (time, expected.time.GetNanoSeconds (), "Wrong time of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (uid, expected.packetUid, "Wrong uid of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (value, expected.value, "Wrong value of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (nextHop, expected.nextHop.Get (), "Wrong next hop of record " << i);
+      NS_TEST_EXPECT_MSG_EQ ((exploration != 0), expected.exploration, "Wrong exploration of record " << i);
+    }
+  is.peek ();
+  NS_TEST_EXPECT_MSG_EQ (is.eof (), true, "Unexpected data after the records");
+}
+
+void
+Ipv4RoutingDecisionBufferTest::DoRun (void)
+{
+  // Without a file, the buffer keeps the last decisions
+  Ipv4RoutingDecisionBuffer ring (8);
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      ring.Record (MakeDecision (i));
+    }
+  NS_TEST_ASSERT_MSG_EQ (ring.GetSize (), 8, "Wrong number of decisions kept");
+  NS_TEST_EXPECT_MSG_EQ (ring.GetNRecorded (), 20, "Wrong number of decisions recorded");
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      Ipv4RoutingDecision decision = ring.Get (i);
+      Ipv4RoutingDecision expected = MakeDecision (12 + i);
+      NS_TEST_EXPECT_MSG_EQ (decision.time, expected.time, "Wrong time of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.node, expected.node, "Wrong node of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.packetUid, expected.packetUid, "Wrong uid of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.destination, expected.destination, "Wrong destination of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.nextHop, expected.nextHop, "Wrong next hop of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.value, expected.value, "Wrong value of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.exploration, expected.exploration, "Wrong exploration of decision " << i);
+      NS_TEST_EXPECT_MSG_EQ (decision.nNeighbors, expected.nNeighbors, "Wrong neighbors of decision " << i);
+    }
+  std::string ringFile = CreateTempDirFilename ("Ipv4RoutingDecisionBufferTest.ring");
+  ring.Write (ringFile);
+  CheckFile (ringFile, 12, 8);
+
+  // With a file, all the decisions are written
+  std::string streamFile = CreateTempDirFilename ("Ipv4RoutingDecisionBufferTest.stream");
+  {
+    Ipv4RoutingDecisionBuffer stream (8);
+    stream.SetFile (streamFile);
+    for (uint32_t i = 0; i < 21; i++)
+      {
+        stream.Record (MakeDecision (i));
+      }
+    NS_TEST_EXPECT_MSG_EQ (stream.GetSize (), 5, "The full buffers were not written");
+  }
+  CheckFile (streamFile, 0, 21);
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4RoutingDecisionBuffer Test Suite
+ */
+static class Ipv4RoutingDecisionBufferTestSuite : public TestSuite
+{
+public:
+  Ipv4RoutingDecisionBufferTestSuite () : TestSuite ("ipv4-routing-decision-buffer", UNIT)
+  {
+    AddTestCase (new Ipv4RoutingDecisionBufferTest (), TestCase::QUICK);
+  }
+} g_ipv4RoutingDecisionBufferTestSuite; ///< the test suite
@@ -82,9 +82,25 @@ Ipv4L3ProtocolTestCase::DoRun (void)
   interface->AddAddress (ifaceAddr4);
   uint32_t num = interface->GetNAddresses ();
   NS_TEST_ASSERT_MSG_EQ (num, 4, "Should find 4 interfaces??");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->GetInterfaceForAddress (Ipv4Address ("10.30.0.1")), 0,
+                         "Address not found on its interface");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("10.30.0.1"), index), true,
+                         "Local address not for me");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("10.30.0.255"), index), true,
+                         "Interface broadcast address not for me");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("10.30.0.2"), index), false,
+                         "Other address for me");
   interface->RemoveAddress (2);
   num = interface->GetNAddresses ();
   NS_TEST_ASSERT_MSG_EQ (num, 3, "Should find 3 interfaces??");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->GetInterfaceForAddress (Ipv4Address ("10.30.0.1")), -1,
+                         "Removed address found");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("10.30.0.1"), index), false,
+                         "Removed address for me");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("10.30.0.255"), index), false,
+                         "Broadcast address of a removed address for me");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->IsDestinationAddress (Ipv4Address ("192.168.0.255"), index), true,
+                         "Interface broadcast address not for me");
   Ipv4InterfaceAddress output = interface->GetAddress (2);
   NS_TEST_ASSERT_MSG_EQ (ifaceAddr4, output,
                          "The addresses should be identical");
@@ -116,6 +132,10 @@ Ipv4L3ProtocolTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (true, result, "Unable to remove Address??");
   num = interface->GetNAddresses ();
   NS_TEST_ASSERT_MSG_EQ (num, 1, "Should find 1 addresses??");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->GetInterfaceForAddress (Ipv4Address ("192.168.0.2")), -1,
+                         "Removed address found");
+  NS_TEST_ASSERT_MSG_EQ (ipv4->GetInterfaceForAddress (Ipv4Address ("192.168.0.1")), 0,
+                         "Address not found on its interface");
 
   /* Remove a non-existent Address */
   result = ipv4->RemoveAddress (index, Ipv4Address ("189.0.0.1"));
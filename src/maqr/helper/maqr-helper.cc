@@ -6,6 +6,8 @@
 #include "ns3/names.h"
 #include "ns3/ptr.h"
 #include "ns3/ipv4-list-routing.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/boolean.h"
 
 
 namespace ns3 {
@@ -25,6 +27,13 @@ Ptr<Ipv4RoutingProtocol> MaqrHelper::Create (Ptr<Node> node) const
 {
   Ptr<maqr::RoutingProtocol> agent = m_agentFactory.Create<maqr::RoutingProtocol> ();
   node->AggregateObject (agent);
+  // MAQR forwards the packets it receives from RouteInput and keeps no
+  // reference to them, so IPv4 does not need to copy them
+  Ptr<Ipv4L3Protocol> l3 = node->GetObject<Ipv4L3Protocol> ();
+  if (l3 != 0)
+    {
+      l3->SetAttribute ("FastForwarding", BooleanValue (true));
+    }
   return agent;
 }
 
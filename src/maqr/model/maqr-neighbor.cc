@@ -30,6 +30,7 @@ Time Neighbors::GetEntryUpdateTime (Ipv4Address ip)
 
 void Neighbors::AddEntry (Ipv4Address ip, Neighbor nb)
 {
+  UpdateArpCaches (ip, nb.m_hardwareAddress);
   auto i = m_nbTable.find(ip);
   if(i != m_nbTable.end() || ip == i->first)
   {
@@ -149,6 +150,19 @@ void Neighbors::DelArpCache (Ptr<ArpCache> a)
   m_arp.erase (std::remove (m_arp.begin (), m_arp.end (), a), m_arp.end ());
 }
 
+void Neighbors::UpdateArpCaches (Ipv4Address addr, Mac48Address hwaddr)
+{
+  if (hwaddr == Mac48Address ())
+    {
+      return;
+    }
+  for (std::vector<Ptr<ArpCache> >::const_iterator i = m_arp.begin ();
+       i != m_arp.end (); ++i)
+    {
+      (*i)->LearnMacAddress (addr, hwaddr);
+    }
+}
+
 Mac48Address Neighbors::LookupMacAddress (Ipv4Address addr)
 {
   Mac48Address hwaddr;
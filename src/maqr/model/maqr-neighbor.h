@@ -85,7 +85,8 @@ public:
    */
   Time GetEntryUpdateTime (Ipv4Address id);
   /**
-   * \brief Adds entry in the neighbor table
+   * \brief Adds entry in the neighbor table, and the MAC address of the
+   * neighbor, if known, to the ARP caches
    */
   void AddEntry (Ipv4Address ip, Neighbor nb);
   /**
@@ -134,7 +135,8 @@ public:
 
 
    /**
-   * Add ARP cache to be used to allow layer 2 notifications processing
+   * Add ARP cache to be used to allow layer 2 notifications processing,
+   * and to which the MAC addresses of the neighbors are added
    * \param a pointer to the ARP cache to add
    */
    void AddArpCache (Ptr<ArpCache> a);
@@ -188,6 +190,14 @@ private:
    * \returns the MAC address for the IP address
    */
   Mac48Address LookupMacAddress (Ipv4Address addr);
+  /**
+   * Add the MAC address of a neighbor to the ARP caches, so that no ARP
+   * request is needed to reach it
+   *
+   * \param addr the IP address of the neighbor
+   * \param hwaddr the MAC address of the neighbor, ignored if unknown
+   */
+  void UpdateArpCaches (Ipv4Address addr, Mac48Address hwaddr);
   /**
    * Process layer 2 TX error notification
    * \param hdr header of the packet
@@ -132,12 +132,14 @@ std::ostream& operator<< (std::ostream & os, TypeHeader const & h)
 //--------------------------------------------------------------
 // HELLO HEADER
 //--------------------------------------------------------------
-HelloHeader::HelloHeader(uint8_t reserved8, uint16_t reserved16, Ipv4Address origin, float qValue, Vector2D curPos)
+HelloHeader::HelloHeader(uint8_t reserved8, uint16_t reserved16, Ipv4Address origin, float qValue, Vector2D curPos,
+                         Mac48Address hardwareAddress)
   : m_reserved8(reserved8),
     m_reserved16(reserved16),
     m_origin(origin),
     m_qValue(qValue),
-    m_curPos(curPos)
+    m_curPos(curPos),
+    m_hardwareAddress(hardwareAddress)
 {
 }
 
@@ -163,7 +165,7 @@ uint32_t HelloHeader::GetSerializedSize() const
   /**
    * \todo hello header size
    */
-  return 19;
+  return 25;
 }
 
 void HelloHeader::Serialize(Buffer::Iterator i) const
@@ -176,6 +178,7 @@ void HelloHeader::Serialize(Buffer::Iterator i) const
   i.WriteHtonU32(FtoU32(m_qValue));
   i.WriteHtonU32(FtoU32((float)m_curPos.x));
   i.WriteHtonU32(FtoU32((float)m_curPos.y));
+  WriteTo(i, m_hardwareAddress);
 }
 
 uint32_t HelloHeader::Deserialize(Buffer::Iterator start)
@@ -188,6 +191,7 @@ uint32_t HelloHeader::Deserialize(Buffer::Iterator start)
   float curPosX = U32toF(i.ReadNtohU32());
   float curPosY = U32toF(i.ReadNtohU32());
   m_curPos = Vector2D(curPosX, curPosY);
+  ReadFrom(i, m_hardwareAddress);
 
   uint32_t dist = i.GetDistanceFrom(start);
   NS_ASSERT(dist == GetSerializedSize());
@@ -197,7 +201,8 @@ uint32_t HelloHeader::Deserialize(Buffer::Iterator start)
 void HelloHeader::Print(std::ostream & os) const
 {
   os << "Originator: " << m_origin << "q-value: " << m_qValue
-     << " Current Position: (" << m_curPos.x << ", " << m_curPos.y << ")";
+     << " Current Position: (" << m_curPos.x << ", " << m_curPos.y << ")"
+     << " MAC: " << m_hardwareAddress;
 
 }
 
@@ -4,6 +4,7 @@
 #include <iostream>
 #include "ns3/header.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/mac48-address.h"
 #include "ns3/vector.h"
 #include "ns3/enum.h"
 
@@ -89,8 +90,10 @@ public:
    * \param origin originator IP address
    * \param qValue q-learning value of originator
    * \param curPos current position
+   * \param hardwareAddress MAC address of the interface of the originator
    */
-  HelloHeader (uint8_t reserved8 = 0, uint16_t reserved16 = 0, Ipv4Address origin = Ipv4Address(), float qValue = 1.0, Vector2D curPos = Vector2D(0, 0));
+  HelloHeader (uint8_t reserved8 = 0, uint16_t reserved16 = 0, Ipv4Address origin = Ipv4Address(), float qValue = 1.0, Vector2D curPos = Vector2D(0, 0),
+               Mac48Address hardwareAddress = Mac48Address ());
   /**
    * \brief Get the type ID.
    * \return the object TypeId
@@ -159,6 +162,22 @@ public:
   {
     return m_curPos;
   }
+  /**
+   * \brief Set the MAC address of the interface of the originator
+   * \param hardwareAddress the MAC address, 00:00:00:00:00:00 if unknown
+   */
+  void SetHardwareAddress (Mac48Address hardwareAddress)
+  {
+    m_hardwareAddress = hardwareAddress;
+  }
+  /**
+   * \brief Get the MAC address of the interface of the originator
+   * \returns the MAC address, 00:00:00:00:00:00 if unknown
+   */
+  Mac48Address GetHardwareAddress () const
+  {
+    return m_hardwareAddress;
+  }
   
 
 private:
@@ -167,6 +186,7 @@ private:
   Ipv4Address m_origin;
   float m_qValue;
   Vector2D m_curPos;
+  Mac48Address m_hardwareAddress;
   
 };
 
@@ -92,8 +92,13 @@ Ipv4Address QLearning::GetNextHop(Ipv4Address target)
   return a;
 }
 
-Ipv4Address QLearning::GetNextHop (Ipv4Address target, const std::set<Ipv4Address>& nbList)
+Ipv4Address QLearning::GetNextHop (Ipv4Address target, const std::set<Ipv4Address>& nbList, bool *exploration)
 {  
+  if (exploration != 0)
+  {
+    *exploration = false;
+  }
+
   // decay epsilon
   if (m_updateEpsilon)
   {
@@ -133,6 +138,10 @@ Ipv4Address QLearning::GetNextHop (Ipv4Address target, const std::set<Ipv4Addres
   float prob = (rand () % (1000)) / 1000.0;
   if (prob < m_epsilon)
   {
+    if (exploration != 0)
+    {
+      *exploration = true;
+    }
     auto i = nbList.cbegin ();
     std::advance (i, rand () % nbList.size ());
     return *i;
@@ -158,6 +167,10 @@ Ipv4Address QLearning::GetNextHop (Ipv4Address target, const std::set<Ipv4Addres
 
   if (a == Ipv4Address::GetZero ())
   {
+    if (exploration != 0)
+    {
+      *exploration = true;
+    }
     auto i = nbList.cbegin ();
     std::advance (i, rand () % nbList.size ());
     return *i;
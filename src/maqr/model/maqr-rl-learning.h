@@ -115,9 +115,10 @@ public:
    * \brief Get next hop for target node within active neighbors
    * \param target the target node
    * \param nbList the active neighbors
+   * \param exploration if not null, set to whether the next hop was chosen at random
    * \returns the next hop for the target node
    */
-  Ipv4Address GetNextHop (Ipv4Address target, const std::set<Ipv4Address>& nbList);
+  Ipv4Address GetNextHop (Ipv4Address target, const std::set<Ipv4Address>& nbList, bool *exploration = 0);
   /**
    * \brief Reward function
    * \param origin the origin address (state)
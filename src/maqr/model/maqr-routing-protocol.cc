@@ -4,9 +4,11 @@
 #include "maqr-routing-protocol.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/socket.h"
+#include "ns3/position-snapshot.h"
 
 namespace ns3 {
 
@@ -25,7 +27,18 @@ TypeId RoutingProtocol::GetTypeId(void)
     .SetParent<Ipv4RoutingProtocol>()
     .SetGroupName("MAQR")
     .AddConstructor<RoutingProtocol>()
+    .AddAttribute ("PopulateArpCache",
+                   "Add the MAC addresses carried by the HELLO messages "
+                   "to the ARP caches, so that no ARP request is needed "
+                   "to reach a neighbor.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&RoutingProtocol::m_populateArpCache),
+                   MakeBooleanChecker ())
     // the access of internal member objects of a simulation
+    .AddTraceSource ("RoutingDecision",
+                     "The next hop chosen for a packet.",
+                     MakeTraceSourceAccessor (&RoutingProtocol::m_routingDecisionTrace),
+                     "ns3::Ipv4RoutingDecision::TracedCallback")
     ;
   return tid;
 }
@@ -36,6 +49,7 @@ RoutingProtocol::RoutingProtocol()
     m_maxQueueTime(Seconds(30)),
     // learning rate, discount rate, initial value of epsilon, epsilon lower limit, decay rate, entry life time
     m_qLearning(0.8, 0.9, 0.9, 0.2, 0.99, true, Seconds(1)),
+    m_populateArpCache(true),
     m_helloInterval(Seconds(0.2)),
     m_helloIntervalTimer(Timer::CANCEL_ON_DESTROY)
 {
@@ -82,6 +96,7 @@ Ptr<Ipv4Route> RoutingProtocol::RouteOutput(Ptr<Packet> p, const Ipv4Header &hea
   Ptr<Ipv4Route> route = Create<Ipv4Route> ();
   Ipv4Address dst = header.GetDestination ();
   Ipv4Address nextHop;
+  bool exploration = false;
   m_nb.Purge ();
   if (m_nb.IsNeighbor (dst))
   {
@@ -100,10 +115,11 @@ Ptr<Ipv4Route> RoutingProtocol::RouteOutput(Ptr<Packet> p, const Ipv4Header &hea
       return LoopbackRoute(header, oif);
     }
 
-    nextHop = m_qLearning.GetNextHop (dst, activeNeighbors);
+    nextHop = m_qLearning.GetNextHop (dst, activeNeighbors, &exploration);
   }
   if (nextHop != Ipv4Address::GetZero ())
   {
+    NotifyRoutingDecision (p, dst, nextHop, exploration);
     NS_LOG_DEBUG ("Destination: " << dst);
     route->SetDestination (dst);
     if (header.GetSource () == Ipv4Address ("102.102.102.102"))
@@ -172,15 +188,15 @@ bool RoutingProtocol::RouteInput(Ptr<const Packet> p, const Ipv4Header &header,
     return false;
   }
 
-  // Broadcast local delivery/forward
+  // Broadcast local delivery/forward. The sockets are bound to the device
+  // of their interface, and unicast packets skip the device check.
   for (auto j = m_socketAddresses.cbegin (); j != m_socketAddresses.cend (); ++j)
   {
-    Ipv4InterfaceAddress iface = j->second;
-    if (m_ipv4->GetInterfaceForAddress (iface.GetLocal ()) == iif)
+    const Ipv4InterfaceAddress &iface = j->second;
+    if (dst == iface.GetBroadcast () || dst.IsBroadcast ())
     {
-      if (dst == iface.GetBroadcast () || dst.IsBroadcast ())
+      if (PeekPointer (j->first->GetBoundNetDevice ()) == PeekPointer (idev))
       {
-        Ptr<Packet> packet = p->Copy ();
         if (lcb.IsNull () == false)
         {
           NS_LOG_LOGIC ("Broadcast local delivery to " << iface.GetLocal ());
@@ -283,12 +299,10 @@ void RoutingProtocol::NotifyInterfaceUp(uint32_t interface)
                         /*next hop=*/ iface.GetBroadcast (), /*lifetime=*/ Simulator::GetMaximumSimulationTime ());
   m_routingTable.AddRoute (rt);
 
-  /*
-  if (l3->GetInterface (i)->GetArpCache ())
+  if (m_populateArpCache && l3->GetInterface (interface)->GetArpCache ())
   {
-    m_nb.AddArpCache (l3->GetInterface (i)->GetArpCache ());
+    m_nb.AddArpCache (l3->GetInterface (interface)->GetArpCache ());
   }
-  */
 
   // Allow neighbor manager use this interface for layer 2 feedback if possible
   Ptr<WifiNetDevice> wifi = dev->GetObject<WifiNetDevice> ();
@@ -325,9 +339,9 @@ void RoutingProtocol::NotifyInterfaceDown(uint32_t interface)
     {
       //mac->TraceDisconnectWithoutContext ("DroppedMpdu",
       //                                    MakeCallback (&RoutingProtocol::NotifyTxError, this));
-      // m_nb.DelArpCache (l3->GetInterface (interface)->GetArpCache ());
     }
   }
+  m_nb.DelArpCache (l3->GetInterface (interface)->GetArpCache ());
 
   // Close socket
   Ptr<Socket> socket = FindSocketWithInterfaceAddress(m_ipv4->GetAddress(interface, 0));
@@ -620,16 +634,16 @@ void RoutingProtocol::ReceiveHello(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addr
   Vector2D curPos;
   curPos = hdr.GetCurPosition();
 
-  UpdateNeighbor(sender, maxQ, curPos);
+  UpdateNeighbor(sender, maxQ, curPos, hdr.GetHardwareAddress ());
 }
 
-void RoutingProtocol::UpdateNeighbor(Ipv4Address origin, float qValue, Vector2D pos)
+void RoutingProtocol::UpdateNeighbor(Ipv4Address origin, float qValue, Vector2D pos, Mac48Address mac)
 {
-  NS_LOG_FUNCTION (this << "Update neighbor : " << origin);
+  NS_LOG_FUNCTION (this << "Update neighbor : " << origin << mac);
   /**
    * \todo update neighbor entry
    */
-  m_nb.AddEntry(origin, Neighbors::Neighbor(origin, ns3::Mac48Address(), Simulator::Now(), pos, 0.0, 0.0, 0.0));
+  m_nb.AddEntry(origin, Neighbors::Neighbor(origin, mac, Simulator::Now(), pos, 0.0, 0.0, 0.0));
 }
 
 void RoutingProtocol::SendHello()
@@ -639,14 +653,20 @@ void RoutingProtocol::SendHello()
 
   Ptr<MobilityModel> mm = m_ipv4->GetObject<MobilityModel>();
 
-  positionX = mm->GetPosition().x;
-  positionY = mm->GetPosition().y;
+  Vector position = PositionSnapshot::GetPosition(mm);
+  positionX = position.x;
+  positionY = position.y;
 
   for(auto i = m_socketAddresses.cbegin(); i != m_socketAddresses.cend(); ++i)
   {
     Ptr<Socket> socket = i->first;
     Ipv4InterfaceAddress iface = i->second;
     HelloHeader helloHeader((uint8_t)0, (uint16_t)0, iface.GetLocal(), 0.0, Vector2D(positionX, positionY));
+    Address hardwareAddress = socket->GetBoundNetDevice ()->GetAddress ();
+    if (Mac48Address::IsMatchingType (hardwareAddress))
+    {
+      helloHeader.SetHardwareAddress (Mac48Address::ConvertFrom (hardwareAddress));
+    }
 
     Ptr<Packet> packet = Create<Packet>();
     SocketIpTtlTag tag;
@@ -742,9 +762,11 @@ bool RoutingProtocol::Forwarding (Ptr<const Packet> packet, const Ipv4Header& he
     NS_LOG_DEBUG (*i << " ");
   }
 
-  Ipv4Address nextHop = m_qLearning.GetNextHop (dst, activeNeighbors);
+  bool exploration;
+  Ipv4Address nextHop = m_qLearning.GetNextHop (dst, activeNeighbors, &exploration);
   if (nextHop != Ipv4Address::GetZero ())
   {
+    NotifyRoutingDecision (packet, dst, nextHop, exploration);
     Ptr<NetDevice> oif = m_ipv4->GetObject<NetDevice> ();
     Ptr<Ipv4Route> route = Create<Ipv4Route> ();
     route->SetDestination (dst);
@@ -835,6 +857,34 @@ float RoutingProtocol::UpdateQValue(Ipv4Address target, Ipv4Address hop, RewardT
   return newQValue;
 }
 
+void RoutingProtocol::NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst, Ipv4Address nextHop,
+                                              bool exploration)
+{
+  if (m_routingDecisionTrace.IsEmpty ())
+  {
+    return;
+  }
+  Ipv4RoutingDecision decision;
+  decision.time = Simulator::Now ();
+  decision.node = m_ipv4->GetObject<Node> ()->GetId ();
+  decision.packetUid = packet != 0 ? packet->GetUid () : 0;
+  decision.destination = dst;
+  decision.nextHop = nextHop;
+  decision.value = 0;
+  auto target = m_qLearning.m_QTable.find (dst);
+  if (target != m_qLearning.m_QTable.end ())
+  {
+    auto hop = target->second.find (nextHop);
+    if (hop != target->second.end ())
+    {
+      decision.value = hop->second->GetqValue ();
+    }
+  }
+  decision.exploration = exploration;
+  decision.nNeighbors = m_nb.GetAllActiveNeighbors ().size ();
+  m_routingDecisionTrace (decision);
+}
+
 int64_t RoutingProtocol::AssignStreams (int64_t stream)
 {
   NS_LOG_FUNCTION (this << stream);
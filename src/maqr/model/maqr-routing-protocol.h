@@ -18,6 +18,8 @@
 #include "ns3/wifi-mac.h"
 
 #include "ns3/timer.h"
+#include "ns3/traced-callback.h"
+#include "ns3/ipv4-routing-decision.h"
 
 #include <algorithm>
 #include <deque>
@@ -160,8 +162,12 @@ public:
   virtual void ReceiveHello (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sender);
   /**
    * \brief Update neighbor table
+   * \param origin the address of the neighbor
+   * \param qValue the q-value advertised by the neighbor
+   * \param pos the position of the neighbor
+   * \param mac the MAC address of the neighbor, 00:00:00:00:00:00 if unknown
    */
-  virtual void UpdateNeighbor (Ipv4Address origin, float qValue, Vector2D pos);
+  virtual void UpdateNeighbor (Ipv4Address origin, float qValue, Vector2D pos, Mac48Address mac);
   /**
    * \brief Send Hello packet
    */
@@ -199,6 +205,16 @@ public:
 
   float UpdateQValue(Ipv4Address target, Ipv4Address hop, RewardType type);
 
+  /**
+   * \brief Report the next hop chosen for a packet to the RoutingDecision trace
+   * \param packet the packet
+   * \param dst the destination of the packet
+   * \param nextHop the next hop
+   * \param exploration whether the next hop was chosen at random
+   */
+  void NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst, Ipv4Address nextHop,
+                              bool exploration);
+
   virtual void PrintRoutingTable (ns3::Ptr<ns3::OutputStreamWrapper>, Time::Unit unit = Time::S) const
   {
     return;
@@ -244,6 +260,10 @@ public:
 
   // Q-Learning algorithm
   QLearning m_qLearning;
+  // Trace of the next hops chosen for the packets
+  TracedCallback<const Ipv4RoutingDecision &> m_routingDecisionTrace;
+  // Add the MAC addresses of the neighbors to the ARP caches
+  bool m_populateArpCache;
   // Hello interval
   Time m_helloInterval;
   // Hello timer
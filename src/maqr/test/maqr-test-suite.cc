@@ -1,7 +1,11 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 
 // Include a header file from your module to test.
-#include "ns3/maqr.h"
+#include "ns3/maqr-routing-protocol.h"
+#include "ns3/maqr-packet.h"
+#include "ns3/maqr-neighbor.h"
+#include "ns3/arp-cache.h"
+#include "ns3/packet.h"
 
 // An essential include is test.h
 #include "ns3/test.h"
@@ -46,6 +50,64 @@ MaqrTestCase1::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+/**
+ * \ingroup maqr
+ * \ingroup tests
+ *
+ * \brief Check that the MAC address carried by a HELLO reaches the ARP caches.
+ */
+class MaqrHelloArpTestCase : public TestCase
+{
+public:
+  MaqrHelloArpTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MaqrHelloArpTestCase::MaqrHelloArpTestCase ()
+  : TestCase ("Check the MAC address of the HELLO messages and the ARP caches")
+{
+}
+
+void
+MaqrHelloArpTestCase::DoRun (void)
+{
+  Ipv4Address origin ("10.0.0.2");
+  Mac48Address mac ("00:00:00:00:00:02");
+
+  // The MAC address survives the serialization of the header
+  maqr::HelloHeader hello (0, 0, origin, 0.5, Vector2D (10, 20), mac);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (hello);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), hello.GetSerializedSize (), "Wrong size of the HELLO");
+  maqr::HelloHeader received;
+  packet->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (received.GetOrigin (), origin, "Wrong origin");
+  NS_TEST_EXPECT_MSG_EQ (received.GetHardwareAddress (), mac, "Wrong MAC address");
+
+  // A neighbor with a known MAC address is added to the ARP cache
+  Ptr<ArpCache> arp = CreateObject<ArpCache> ();
+  maqr::Neighbors nb;
+  nb.AddArpCache (arp);
+  nb.AddEntry (Ipv4Address ("10.0.0.3"), maqr::Neighbors::Neighbor (Ipv4Address ("10.0.0.3"), Mac48Address (),
+                                                                     Seconds (1), Vector2D (0, 0), 0, 0, 0));
+  NS_TEST_EXPECT_MSG_EQ ((arp->Lookup (Ipv4Address ("10.0.0.3")) == 0), true, "Unknown MAC address added");
+  nb.AddEntry (origin, maqr::Neighbors::Neighbor (origin, received.GetHardwareAddress (),
+                                                  Seconds (1), Vector2D (10, 20), 0, 0, 0));
+  ArpCache::Entry *entry = arp->Lookup (origin);
+  NS_TEST_ASSERT_MSG_EQ ((entry != 0), true, "Neighbor not added to the ARP cache");
+  NS_TEST_EXPECT_MSG_EQ (entry->IsAlive (), true, "ARP entry not alive");
+  NS_TEST_EXPECT_MSG_EQ (Mac48Address::ConvertFrom (entry->GetMacAddress ()), mac, "Wrong MAC address in the ARP cache");
+
+  // The ARP cache is not updated any more once deleted
+  nb.DelArpCache (arp);
+  nb.AddEntry (origin, maqr::Neighbors::Neighbor (origin, Mac48Address ("00:00:00:00:00:04"),
+                                                  Seconds (1), Vector2D (10, 20), 0, 0, 0));
+  NS_TEST_EXPECT_MSG_EQ (Mac48Address::ConvertFrom (entry->GetMacAddress ()), mac, "Deleted ARP cache updated");
+  arp->Dispose ();
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -61,6 +123,7 @@ MaqrTestSuite::MaqrTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new MaqrTestCase1, TestCase::QUICK);
+  AddTestCase (new MaqrHelloArpTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * This program converts an ns-2 movement trace to a binary waypoint
+ * trace, and optionally times loading both of them.
+ *
+ *  - The ns-2 trace is converted once with
+ *    Ns2MobilityHelper::WriteWaypointTrace.
+ *  - Simulations then load the waypoint trace with WaypointTraceHelper,
+ *    which maps the file in memory and feeds the waypoints of each node
+ *    to its WaypointMobilityModel a few at a time, instead of parsing
+ *    the whole text trace and scheduling all its movements up front.
+ *
+ * Usage of ns2-to-waypoint-trace:
+ *
+ *  ./waf --run "ns2-to-waypoint-trace \
+ *        --traceFile=src/mobility/examples/default.ns_movements \
+ *        --waypointFile=default.waypoints --compare=1"
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string traceFile;
+  std::string waypointFile;
+  bool compare = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("traceFile", "Ns2 movement trace file", traceFile);
+  cmd.AddValue ("waypointFile", "Waypoint trace file to write", waypointFile);
+  cmd.AddValue ("compare", "Time loading both traces on as many nodes as in the trace", compare);
+  cmd.Parse (argc, argv);
+
+  if (traceFile.empty () || waypointFile.empty ())
+    {
+      std::cout << "Usage of " << argv[0] << " :\n\n"
+      "./waf --run \"ns2-to-waypoint-trace"
+      " --traceFile=src/mobility/examples/default.ns_movements"
+      " --waypointFile=default.waypoints\"\n";
+      return 0;
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Ns2MobilityHelper ns2 (traceFile);
+  ns2.WriteWaypointTrace (waypointFile);
+  std::cout << "Converted " << traceFile << " to " << waypointFile
+            << " in " << clock.End () << " ms" << std::endl;
+
+  if (compare)
+    {
+      clock.Start ();
+      WaypointTraceHelper waypoints (waypointFile);
+      NodeContainer waypointNodes;
+      waypointNodes.Create (waypoints.GetNNodes ());
+      waypoints.Install (waypointNodes.Begin (), waypointNodes.End ());
+      std::cout << "Installed the waypoint trace in " << clock.End () << " ms" << std::endl;
+
+      clock.Start ();
+      NodeContainer ns2Nodes;
+      ns2Nodes.Create (waypoints.GetNNodes ());
+      ns2.Install (ns2Nodes.Begin (), ns2Nodes.End ());
+      std::cout << "Installed the ns-2 trace in " << clock.End () << " ms" << std::endl;
+      Simulator::Destroy ();
+    }
+  return 0;
+}
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mobility-trace-recorder.h"
+#include "ns3/mobility-model.h"
+#include "ns3/waypoint-trace-file.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilityTraceRecorder");
+
+/// Distance under which a recorded position continues the last segment (m)
+static const double POSITION_TOLERANCE = 1e-6;
+
+/**
+ * \param waypoint the last waypoint of a trajectory
+ * \param velocity the velocity since the waypoint
+ * \param now a time later than the waypoint
+ * \returns the position reached at that time
+ */
+static Vector
+Extrapolate (const Waypoint &waypoint, const Vector &velocity, Time now)
+{
+  double elapsed = (now - waypoint.time).GetSeconds ();
+  return Vector (waypoint.position.x + velocity.x * elapsed,
+                 waypoint.position.y + velocity.y * elapsed,
+                 waypoint.position.z + velocity.z * elapsed);
+}
+
+MobilityTraceRecorder::MobilityTraceRecorder ()
+{
+}
+
+void
+MobilityTraceRecorder::Install (NodeContainer c)
+{
+  NS_LOG_FUNCTION (this);
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<MobilityModel> model = (*i)->GetObject<MobilityModel> ();
+      NS_ABORT_MSG_IF (model == 0, "Node " << (*i)->GetId () << " has no mobility model to record");
+      if ((*i)->GetId () >= m_trajectories.size ())
+        {
+          m_trajectories.resize ((*i)->GetId () + 1);
+        }
+      model->TraceConnectWithoutContext ("CourseChange", MakeCallback (&MobilityTraceRecorder::CourseChange, this));
+      CourseChange (model);
+    }
+}
+
+void
+MobilityTraceRecorder::InstallAll (void)
+{
+  NodeContainer c;
+  NodeContainer global = NodeContainer::GetGlobal ();
+  for (NodeContainer::Iterator i = global.Begin (); i != global.End (); ++i)
+    {
+      if ((*i)->GetObject<MobilityModel> () != 0)
+        {
+          c.Add (*i);
+        }
+    }
+  Install (c);
+}
+
+void
+MobilityTraceRecorder::CourseChange (Ptr<const MobilityModel> model)
+{
+  Ptr<Node> node = model->GetObject<Node> ();
+  NS_ASSERT (node != 0 && node->GetId () < m_trajectories.size ());
+  Trajectory &trajectory = m_trajectories[node->GetId ()];
+  Time now = Simulator::Now ();
+  Vector position = model->GetPosition ();
+  if (trajectory.waypoints.empty ())
+    {
+      trajectory.waypoints.push_back (Waypoint (now, position));
+    }
+  else
+    {
+      const Waypoint &last = trajectory.waypoints.back ();
+      Vector reached = last.position;
+      if (now > last.time)
+        {
+          reached = Extrapolate (last, trajectory.velocity, now);
+        }
+      if (CalculateDistance (reached, position) > POSITION_TOLERANCE)
+        {
+          // A jump: end the last segment where it was heading
+          NS_LOG_LOGIC ("Node " << node->GetId () << " jumped from " << reached << " to " << position);
+          if (now > last.time)
+            {
+              trajectory.waypoints.push_back (Waypoint (now, reached));
+            }
+          trajectory.waypoints.push_back (Waypoint (now, position));
+        }
+      else if (now > last.time)
+        {
+          trajectory.waypoints.push_back (Waypoint (now, position));
+        }
+    }
+  trajectory.velocity = model->GetVelocity ();
+}
+
+void
+MobilityTraceRecorder::Write (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  Time now = Simulator::Now ();
+  std::vector<std::vector<Waypoint> > waypoints (m_trajectories.size ());
+  for (std::size_t i = 0; i < m_trajectories.size (); i++)
+    {
+      waypoints[i] = m_trajectories[i].waypoints;
+      if (!waypoints[i].empty () && now > waypoints[i].back ().time)
+        {
+          waypoints[i].push_back (Waypoint (now, Extrapolate (waypoints[i].back (), m_trajectories[i].velocity, now)));
+        }
+    }
+  WaypointTraceFile::Write (filename, waypoints);
+}
+
+} // namespace ns3
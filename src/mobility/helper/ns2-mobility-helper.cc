@@ -41,12 +41,14 @@
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/unused.h"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
 #include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/waypoint-trace-file.h"
 #include "ns2-mobility-helper.h"
 
 namespace ns3 {
@@ -853,4 +855,181 @@ Ns2MobilityHelper::Install (void) const
   Install (NodeList::Begin (), NodeList::End ());
 }
 
+/**
+ * A scheduled statement of a node, for Ns2MobilityHelper::WriteWaypointTrace
+ */
+struct Ns2Statement
+{
+  double at;         //!< the time of the statement (s)
+  bool setdest;      //!< whether it is a setdest, else the set of a coordinate
+  std::string coord; //!< the coordinate of a set
+  double x;          //!< the x destination of a setdest, or the value of a set
+  double y;          //!< the y destination of a setdest
+  double speed;      //!< the speed of a setdest
+
+  /**
+   * \param o another statement
+   * \returns true if this statement is earlier than the other one
+   */
+  bool operator< (const Ns2Statement &o) const
+  {
+    return at < o.at;
+  }
+};
+
+/**
+ * The statements of a node, for Ns2MobilityHelper::WriteWaypointTrace
+ */
+struct Ns2NodeStatements
+{
+  Vector initial;                       //!< the initial position
+  std::vector<Ns2Statement> statements; //!< the scheduled statements
+};
+
+/**
+ * Convert the statements of a node to waypoints.
+ * \param node the statements of the node
+ * \param waypoints the waypoints
+ */
+static void
+ConvertToWaypoints (Ns2NodeStatements &node, std::vector<Waypoint> &waypoints)
+{
+  // The statements are scheduled in time order, and in file order at
+  // the same time.
+  std::stable_sort (node.statements.begin (), node.statements.end ());
+  Vector position = node.initial;  // the position at the last waypoint
+  double last = 0;                 // the time of the last waypoint
+  waypoints.push_back (Waypoint (Seconds (0), position));
+  bool moving = false;
+  DestinationPoint movement;
+  for (std::vector<Ns2Statement>::const_iterator i = node.statements.begin (); i != node.statements.end (); ++i)
+    {
+      if (moving)
+        {
+          if (movement.m_targetArrivalTime <= i->at)
+            {
+              position = movement.m_finalPosition;
+              last = movement.m_targetArrivalTime;
+            }
+          else
+            {
+              // Did not reach the destination
+              double traveled = i->at - movement.m_travelStartTime;
+              position.x = movement.m_startPosition.x + movement.m_speed.x * traveled;
+              position.y = movement.m_startPosition.y + movement.m_speed.y * traveled;
+              last = i->at;
+            }
+          waypoints.push_back (Waypoint (Seconds (last), position));
+          moving = false;
+        }
+      if (i->setdest)
+        {
+          double distance = std::sqrt (std::pow (i->x - position.x, 2) + std::pow (i->y - position.y, 2));
+          if (i->speed <= 0 || distance == 0)
+            {
+              // Stop, or stay
+              continue;
+            }
+          if (i->at > last)
+            {
+              waypoints.push_back (Waypoint (Seconds (i->at), position));
+              last = i->at;
+            }
+          double time = distance / i->speed;
+          movement.m_startPosition = position;
+          movement.m_speed = Vector ((i->x - position.x) / time, (i->y - position.y) / time, 0);
+          movement.m_finalPosition = Vector (position.x + movement.m_speed.x * time,
+                                             position.y + movement.m_speed.y * time,
+                                             position.z);
+          movement.m_travelStartTime = i->at;
+          movement.m_targetArrivalTime = i->at + time;
+          moving = true;
+        }
+      else
+        {
+          if (i->at > last)
+            {
+              waypoints.push_back (Waypoint (Seconds (i->at), position));
+              last = i->at;
+            }
+          std::string coord = i->coord;
+          position = SetOneInitialCoord (position, coord, i->x);
+          waypoints.push_back (Waypoint (Seconds (last), position));
+        }
+    }
+  if (moving)
+    {
+      waypoints.push_back (Waypoint (Seconds (movement.m_targetArrivalTime), movement.m_finalPosition));
+    }
+}
+
+void
+Ns2MobilityHelper::WriteWaypointTrace (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::map<uint32_t, Ns2NodeStatements> nodes;
+  std::ifstream file (m_filename.c_str (), std::ios::in);
+  std::string line;
+  while (getline (file, line))
+    {
+      if (line.empty ())
+        {
+          continue;
+        }
+      ParseResult pr = ParseNs2Line (line);
+      if (pr.tokens.size () != 4 && pr.tokens.size () != 7 && pr.tokens.size () != 8)
+        {
+          NS_LOG_ERROR ("Line has not correct number of parameters (corrupted file?): " << line << "\n");
+          continue;
+        }
+      int iNodeId = GetNodeIdInt (pr);
+      if (iNodeId == -1)
+        {
+          NS_LOG_ERROR ("Node number couldn't be obtained (corrupted file?): " << line << "\n");
+          continue;
+        }
+      Ns2NodeStatements &node = nodes[iNodeId];
+      if (IsSetInitialPos (pr))
+        {
+          node.initial = SetOneInitialCoord (node.initial, pr.tokens[2], pr.dvals[3]);
+          continue;
+        }
+      if (!IsNumber (pr.tokens[2]) || pr.dvals[2] < 0)
+        {
+          NS_LOG_WARN ("Time is not a positive number: " << pr.tokens[2]);
+          continue;
+        }
+      Ns2Statement statement;
+      statement.at = pr.dvals[2];
+      if (IsSchedMobilityPos (pr))
+        {
+          statement.setdest = true;
+          statement.x = pr.dvals[5];
+          statement.y = pr.dvals[6];
+          statement.speed = pr.dvals[7];
+        }
+      else if (IsSchedSetPos (pr))
+        {
+          statement.setdest = false;
+          statement.coord = pr.tokens[5];
+          statement.x = pr.dvals[6];
+          statement.y = 0;
+          statement.speed = 0;
+        }
+      else
+        {
+          NS_LOG_WARN ("Format Line is not correct: " << line << "\n");
+          continue;
+        }
+      node.statements.push_back (statement);
+    }
+
+  std::vector<std::vector<Waypoint> > waypoints (nodes.empty () ? 0 : nodes.rbegin ()->first + 1);
+  for (std::map<uint32_t, Ns2NodeStatements>::iterator i = nodes.begin (); i != nodes.end (); ++i)
+    {
+      ConvertToWaypoints (i->second, waypoints[i->first]);
+    }
+  WaypointTraceFile::Write (filename, waypoints);
+}
+
 } // namespace ns3
@@ -103,6 +103,19 @@ public:
    */
   template <typename T>
   void Install (T begin, T end) const;
+
+  /**
+   * \param filename the name of the waypoint trace to write
+   *
+   * Convert the ns2 trace file to a binary waypoint trace (see
+   * WaypointTraceFile), which WaypointTraceHelper installs without
+   * parsing nor scheduling all the movements up front.  Each setdest
+   * becomes a waypoint at its start and one at its arrival, or where
+   * the next statement of the node interrupts it, and each scheduled
+   * set of a coordinate becomes a jump which stops the node.  Initial
+   * coordinates which the trace does not set are zero.
+   */
+  void WriteWaypointTrace (std::string filename) const;
 private:
   /**
    * \brief a class to hold input objects internally
@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replay-mobility-helper.h"
+#include "ns3/replay-mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ReplayMobilityHelper");
+
+ReplayMobilityHelper::ReplayMobilityHelper (std::string filename)
+  : m_file (Create<WaypointTraceFile> (filename))
+{
+}
+
+uint32_t
+ReplayMobilityHelper::GetNNodes (void) const
+{
+  return m_file->GetNNodes ();
+}
+
+void
+ReplayMobilityHelper::Install (NodeContainer c) const
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      uint32_t id = (*i)->GetId ();
+      if (id >= m_file->GetNNodes () || m_file->Begin (id) == m_file->End (id))
+        {
+          NS_LOG_WARN ("No trajectory for node " << id);
+          continue;
+        }
+      NS_ABORT_MSG_IF ((*i)->GetObject<MobilityModel> () != 0,
+                       "Node " << id << " already has a mobility model");
+      Ptr<ReplayMobilityModel> model = CreateObject<ReplayMobilityModel> ();
+      model->SetTrace (m_file, id);
+      (*i)->AggregateObject (model);
+    }
+}
+
+void
+ReplayMobilityHelper::InstallAll (void) const
+{
+  Install (NodeContainer::GetGlobal ());
+}
+
+} // namespace ns3
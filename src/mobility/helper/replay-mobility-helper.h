@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLAY_MOBILITY_HELPER_H
+#define REPLAY_MOBILITY_HELPER_H
+
+#include <string>
+#include "ns3/ptr.h"
+#include "ns3/node-container.h"
+#include "ns3/waypoint-trace-file.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief Helper class which replays the trajectories recorded by
+ * MobilityTraceRecorder.
+ *
+ * Each node gets a ReplayMobilityModel which follows the trajectory of
+ * the same node id in the trace, so that runs comparing, e.g., routing
+ * protocols over the same scenario skip the mobility computation and
+ * see identical positions.  The nodes must be created in the same order
+ * as in the recorded run.
+ */
+class ReplayMobilityHelper
+{
+public:
+  /**
+   * \param filename the name of the waypoint trace
+   */
+  ReplayMobilityHelper (std::string filename);
+
+  /**
+   * \returns the number of nodes in the trace
+   */
+  uint32_t GetNNodes (void) const;
+
+  /**
+   * Aggregate a ReplayMobilityModel to each node whose id matches a
+   * trajectory of the trace.
+   * \param c the nodes, which must not have a mobility model yet
+   */
+  void Install (NodeContainer c) const;
+  /**
+   * Install on all the nodes of the global ns3::NodeList.
+   */
+  void InstallAll (void) const;
+
+private:
+  Ptr<const WaypointTraceFile> m_file; //!< the mapped trace
+};
+
+} // namespace ns3
+
+#endif /* REPLAY_MOBILITY_HELPER_H */
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "waypoint-trace-helper.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WaypointTraceHelper");
+
+/**
+ * \ingroup mobility
+ *
+ * Adds the waypoints of a node to its WaypointMobilityModel a few at a
+ * time.
+ */
+class WaypointTraceFeeder : public SimpleRefCount<WaypointTraceFeeder>
+{
+public:
+  /**
+   * \param file the mapped trace
+   * \param id the node id in the trace
+   * \param model the mobility model of the node
+   * \param ahead the number of waypoints added at once
+   */
+  WaypointTraceFeeder (Ptr<const WaypointTraceFile> file, uint32_t id,
+                       Ptr<WaypointMobilityModel> model, uint32_t ahead);
+  /**
+   * Add the next waypoints to the model, and schedule the next call
+   * before the model reaches the last of them.
+   */
+  void Feed (void);
+
+private:
+  Ptr<const WaypointTraceFile> m_file;      //!< the mapped trace, kept mapped while feeding
+  Ptr<WaypointMobilityModel> m_model;       //!< the mobility model of the node
+  const WaypointTraceFile::Record *m_next;  //!< the next waypoint to add
+  const WaypointTraceFile::Record *m_end;   //!< past the last waypoint of the node
+  uint32_t m_ahead;                         //!< the number of waypoints added at once
+};
+
+WaypointTraceFeeder::WaypointTraceFeeder (Ptr<const WaypointTraceFile> file, uint32_t id,
+                                          Ptr<WaypointMobilityModel> model, uint32_t ahead)
+  : m_file (file),
+    m_model (model),
+    m_next (file->Begin (id)),
+    m_end (file->End (id)),
+    m_ahead (ahead)
+{
+}
+
+void
+WaypointTraceFeeder::Feed (void)
+{
+  Time now = Simulator::Now ();
+  NS_ABORT_MSG_IF (m_next != m_end && Seconds (m_next->time) < now,
+                   "Waypoint trace installed after the time of its first waypoint");
+  const WaypointTraceFile::Record *end = m_next + std::min<std::size_t> (m_ahead, m_end - m_next);
+  // WaypointMobilityModel can not resume once it went past its last
+  // waypoint, so the batch may end neither at the current time nor
+  // within waypoints of the same time (a jump).
+  while (end != m_end && (Seconds ((end - 1)->time) <= now || Seconds ((end - 1)->time) == Seconds (end->time)))
+    {
+      ++end;
+    }
+  if (end != m_end)
+    {
+      // Feed again at the last waypoint time before the last one.  This
+      // event is scheduled before the updates scheduled by AddWaypoint
+      // below, and thus runs first at the same time.
+      Time last = Seconds ((end - 1)->time);
+      Time at = now;
+      for (const WaypointTraceFile::Record *i = end - 1; i != m_next; )
+        {
+          --i;
+          if (Seconds (i->time) < last)
+            {
+              at = std::max (at, Seconds (i->time));
+              break;
+            }
+        }
+      Simulator::Schedule (at - now, &WaypointTraceFeeder::Feed, Ptr<WaypointTraceFeeder> (this));
+    }
+  NS_LOG_LOGIC ("Adding " << end - m_next << " waypoints");
+  for (; m_next != end; ++m_next)
+    {
+      m_model->AddWaypoint (Waypoint (Seconds (m_next->time), Vector (m_next->x, m_next->y, m_next->z)));
+    }
+}
+
+WaypointTraceHelper::WaypointTraceHelper (std::string filename)
+  : m_file (Create<WaypointTraceFile> (filename)),
+    m_waypointsAhead (16)
+{
+}
+
+void
+WaypointTraceHelper::SetWaypointsAhead (uint32_t n)
+{
+  NS_ABORT_MSG_IF (n < 2, "At least two waypoints must be added at once");
+  m_waypointsAhead = n;
+}
+
+uint32_t
+WaypointTraceHelper::GetNNodes (void) const
+{
+  return m_file->GetNNodes ();
+}
+
+void
+WaypointTraceHelper::InstallObject (Ptr<Object> object, uint32_t id) const
+{
+  if (object == 0 || id >= m_file->GetNNodes () || m_file->Begin (id) == m_file->End (id))
+    {
+      return;
+    }
+  Ptr<WaypointMobilityModel> model = object->GetObject<WaypointMobilityModel> ();
+  if (model == 0)
+    {
+      model = CreateObject<WaypointMobilityModel> ();
+      object->AggregateObject (model);
+    }
+  Create<WaypointTraceFeeder> (m_file, id, model, m_waypointsAhead)->Feed ();
+}
+
+void
+WaypointTraceHelper::Install (void) const
+{
+  Install (NodeList::Begin (), NodeList::End ());
+}
+
+} // namespace ns3
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <atomic>
 #include <cmath>
 
 #include "mobility-model.h"
@@ -25,6 +26,9 @@
 
 namespace ns3 {
 
+/// Last position epoch given to a mobility model
+static std::atomic<uint64_t> g_positionEpoch (0);
+
 NS_OBJECT_ENSURE_REGISTERED (MobilityModel);
 
 TypeId 
@@ -53,6 +57,8 @@ MobilityModel::GetTypeId (void)
 }
 
 MobilityModel::MobilityModel ()
+  : m_positionEpoch (++g_positionEpoch),
+    m_snapshotSlot (0)
 {
 }
 
@@ -107,9 +113,16 @@ MobilityModel::GetRelativeSpeed (Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange (void) const
 {
+  m_positionEpoch = ++g_positionEpoch;
   m_courseChangeTrace (this);
 }
 
+uint64_t
+MobilityModel::GetPositionEpoch (void) const
+{
+  return m_positionEpoch;
+}
+
 int64_t
 MobilityModel::AssignStreams (int64_t start)
 {
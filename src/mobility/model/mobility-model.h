@@ -90,6 +90,17 @@ public:
    * \return the number of stream indices assigned by this model
    */
   int64_t AssignStreams (int64_t stream);
+  /**
+   * The position epoch changes whenever the course of this model
+   * changes, i.e., whenever NotifyCourseChange is called.  Epochs are
+   * drawn from a counter shared by all the mobility models, so that
+   * two models never have the same epoch.  A model which was not moving
+   * at some point still has the same position as long as its epoch is
+   * unchanged, so that results depending only on positions may be cached.
+   *
+   * \return the position epoch
+   */
+  uint64_t GetPositionEpoch (void) const;
 
   /**
    *  TracedCallback signature.
@@ -149,6 +160,10 @@ private:
    */
   ns3::TracedCallback<Ptr<const MobilityModel> > m_courseChangeTrace;
 
+  mutable uint64_t m_positionEpoch; //!< the position epoch, updated on each course change
+  mutable uint32_t m_snapshotSlot;  //!< the index of this model in the PositionSnapshot
+
+  friend class PositionSnapshot;
 };
 
 } // namespace ns3
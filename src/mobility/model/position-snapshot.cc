@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "position-snapshot.h"
+#include "mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PositionSnapshot");
+
+/**
+ * \ingroup mobility
+ * \anchor GlobalValuePositionSnapshotQuantum
+ * The time between two position snapshots, zero to disable them.
+ */
+static GlobalValue g_positionSnapshotQuantum = GlobalValue ("PositionSnapshotQuantum",
+                                                            "The time between two snapshots of the positions "
+                                                            "of the mobility models, zero to disable them",
+                                                            TimeValue (Seconds (0)),
+                                                            MakeTimeChecker ());
+
+namespace {
+
+/** The recorded position of a mobility model. */
+struct Slot
+{
+  Ptr<const MobilityModel> mobility; //!< the mobility model
+  uint64_t epoch;                    //!< its position epoch when recorded
+  bool moving;                       //!< whether its velocity was not zero
+  Vector position;                   //!< its recorded position
+};
+
+/** The state of the snapshots, reset by Simulator::Destroy. */
+struct State
+{
+  bool configured;         //!< whether the quantum was set
+  bool destroyScheduled;   //!< whether Reset is scheduled at Simulator::Destroy
+  Time quantum;            //!< the time between two snapshots
+  Time expiry;             //!< the end of the current quantum
+  std::vector<Slot> slots; //!< the recorded positions
+};
+
+/**
+ * \returns the state of the snapshots
+ */
+State &
+GetState (void)
+{
+  static State state = {false, false, Seconds (0), Seconds (0), std::vector<Slot> ()};
+  return state;
+}
+
+/**
+ * Forget the recorded positions and the quantum.
+ */
+void
+Reset (void)
+{
+  State &state = GetState ();
+  state.slots.clear ();
+  state.configured = false;
+  state.destroyScheduled = false;
+  state.expiry = Seconds (0);
+}
+
+/**
+ * Schedule Reset at Simulator::Destroy, if not done yet.
+ * \param state the state of the snapshots
+ */
+void
+ScheduleReset (State &state)
+{
+  if (!state.destroyScheduled)
+    {
+      Simulator::ScheduleDestroy (&Reset);
+      state.destroyScheduled = true;
+    }
+}
+
+/**
+ * Record the current position of a mobility model.
+ * \param slot the slot of the model
+ */
+void
+Record (Slot &slot)
+{
+  slot.position = slot.mobility->GetPosition ();
+  slot.moving = !(slot.mobility->GetVelocity () == Vector ());
+  // Read last, in case the model notified a course change above.
+  slot.epoch = slot.mobility->GetPositionEpoch ();
+}
+
+} // unnamed namespace
+
+void
+PositionSnapshot::SetQuantum (Time quantum)
+{
+  NS_LOG_FUNCTION (quantum);
+  NS_ASSERT (!quantum.IsStrictlyNegative ());
+  State &state = GetState ();
+  state.quantum = quantum;
+  state.configured = true;
+  state.expiry = Seconds (0);
+  ScheduleReset (state);
+}
+
+Time
+PositionSnapshot::GetQuantum (void)
+{
+  State &state = GetState ();
+  if (!state.configured)
+    {
+      TimeValue quantum;
+      g_positionSnapshotQuantum.GetValue (quantum);
+      state.quantum = quantum.Get ();
+      state.configured = true;
+    }
+  return state.quantum;
+}
+
+Vector
+PositionSnapshot::GetPosition (Ptr<const MobilityModel> mobility)
+{
+  State &state = GetState ();
+  if (GetQuantum ().IsZero ())
+    {
+      return mobility->GetPosition ();
+    }
+
+  Time now = Simulator::Now ();
+  if (now >= state.expiry)
+    {
+      NS_LOG_LOGIC ("Taking a snapshot of " << state.slots.size () << " positions");
+      for (std::vector<Slot>::iterator i = state.slots.begin (); i != state.slots.end (); ++i)
+        {
+          if (i->moving || i->epoch != i->mobility->GetPositionEpoch ())
+            {
+              Record (*i);
+            }
+        }
+      state.expiry = now + state.quantum;
+    }
+
+  uint32_t index = mobility->m_snapshotSlot;
+  if (index >= state.slots.size () || state.slots[index].mobility != mobility)
+    {
+      ScheduleReset (state);
+      index = state.slots.size ();
+      mobility->m_snapshotSlot = index;
+      Slot slot;
+      slot.mobility = mobility;
+      state.slots.push_back (slot);
+      Record (state.slots.back ());
+      return state.slots.back ().position;
+    }
+  Slot &slot = state.slots[index];
+  if (slot.epoch != mobility->GetPositionEpoch ())
+    {
+      Record (slot);
+    }
+  return slot.position;
+}
+
+double
+PositionSnapshot::GetDistance (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
+{
+  return CalculateDistance (GetPosition (a), GetPosition (b));
+}
+
+} // namespace ns3
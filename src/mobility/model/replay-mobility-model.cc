@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replay-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ReplayMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED (ReplayMobilityModel);
+
+/**
+ * \param now a time
+ * \param record a waypoint
+ * \returns true if the time is earlier than the waypoint
+ */
+static bool
+IsBeforeRecord (const Time &now, const WaypointTraceFile::Record &record)
+{
+  return now < Seconds (record.time);
+}
+
+TypeId
+ReplayMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ReplayMobilityModel")
+    .SetParent<MobilityModel> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<ReplayMobilityModel> ();
+  return tid;
+}
+
+ReplayMobilityModel::ReplayMobilityModel ()
+  : m_begin (0),
+    m_end (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ReplayMobilityModel::~ReplayMobilityModel ()
+{
+}
+
+void
+ReplayMobilityModel::SetTrace (Ptr<const WaypointTraceFile> file, uint32_t node)
+{
+  NS_LOG_FUNCTION (this << file << node);
+  m_file = file;
+  m_begin = file->Begin (node);
+  m_end = file->End (node);
+  if (IsInitialized ())
+    {
+      ScheduleCourseChange ();
+    }
+  NotifyCourseChange ();
+}
+
+void
+ReplayMobilityModel::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  ScheduleCourseChange ();
+  MobilityModel::DoInitialize ();
+}
+
+void
+ReplayMobilityModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  m_file = 0;
+  m_begin = 0;
+  m_end = 0;
+  MobilityModel::DoDispose ();
+}
+
+const WaypointTraceFile::Record *
+ReplayMobilityModel::FindNext (void) const
+{
+  return std::upper_bound (m_begin, m_end, Simulator::Now (), &IsBeforeRecord);
+}
+
+void
+ReplayMobilityModel::ScheduleCourseChange (void)
+{
+  m_event.Cancel ();
+  const WaypointTraceFile::Record *next = FindNext ();
+  if (next != m_end)
+    {
+      m_event = Simulator::Schedule (Seconds (next->time) - Simulator::Now (),
+                                     &ReplayMobilityModel::CourseChange, this);
+    }
+}
+
+void
+ReplayMobilityModel::CourseChange (void)
+{
+  NS_LOG_FUNCTION (this);
+  ScheduleCourseChange ();
+  NotifyCourseChange ();
+}
+
+Vector
+ReplayMobilityModel::DoGetPosition (void) const
+{
+  if (m_begin == m_end)
+    {
+      return Vector (0, 0, 0);
+    }
+  const WaypointTraceFile::Record *next = FindNext ();
+  if (next == m_begin)
+    {
+      return Vector (next->x, next->y, next->z);
+    }
+  const WaypointTraceFile::Record *last = next - 1;
+  if (next == m_end)
+    {
+      return Vector (last->x, last->y, last->z);
+    }
+  // The waypoints have different times, since next is the first one
+  // later than now and last is not.
+  double alpha = (Simulator::Now ().GetSeconds () - last->time) / (next->time - last->time);
+  return Vector (last->x + alpha * (next->x - last->x),
+                 last->y + alpha * (next->y - last->y),
+                 last->z + alpha * (next->z - last->z));
+}
+
+void
+ReplayMobilityModel::DoSetPosition (const Vector &position)
+{
+  NS_ABORT_MSG ("The position of a ReplayMobilityModel comes from its trace");
+}
+
+Vector
+ReplayMobilityModel::DoGetVelocity (void) const
+{
+  const WaypointTraceFile::Record *next = FindNext ();
+  if (next == m_begin || next == m_end)
+    {
+      return Vector (0, 0, 0);
+    }
+  const WaypointTraceFile::Record *last = next - 1;
+  double span = next->time - last->time;
+  return Vector ((next->x - last->x) / span,
+                 (next->y - last->y) / span,
+                 (next->z - last->z) / span);
+}
+
+} // namespace ns3
@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "spatial-grid-index.h"
+#include "mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatialGridIndex");
+
+SpatialGridIndex::SpatialGridIndex ()
+  : m_cellSize (0),
+    m_refreshInterval (Seconds (1)),
+    m_lastRefresh (Seconds (0)),
+    m_refreshed (false),
+    m_maxSpeed (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SpatialGridIndex::~SpatialGridIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+SpatialGridIndex::SetCellSize (double size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (size > 0);
+  if (size != m_cellSize)
+    {
+      m_cellSize = size;
+      m_refreshed = false;
+    }
+}
+
+double
+SpatialGridIndex::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+void
+SpatialGridIndex::SetRefreshInterval (Time interval)
+{
+  NS_LOG_FUNCTION (this << interval);
+  m_refreshInterval = interval;
+}
+
+uint32_t
+SpatialGridIndex::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  NS_ASSERT (mobility != 0);
+  uint32_t index = m_items.size ();
+  Item item;
+  item.mobility = mobility;
+  item.cell = 0;
+  item.binned = false;
+  item.dirty = true;
+  m_items.push_back (item);
+  m_dirty.push_back (index);
+  m_indices[PeekPointer (mobility)] = index;
+  mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&SpatialGridIndex::NotifyCourseChange, this));
+  return index;
+}
+
+uint32_t
+SpatialGridIndex::GetN (void) const
+{
+  return m_items.size ();
+}
+
+void
+SpatialGridIndex::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Item>::iterator i = m_items.begin (); i != m_items.end (); ++i)
+    {
+      i->mobility->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&SpatialGridIndex::NotifyCourseChange, this));
+    }
+  m_items.clear ();
+  m_indices.clear ();
+  m_cells.clear ();
+  m_dirty.clear ();
+  m_refreshed = false;
+  m_maxSpeed = 0;
+}
+
+uint64_t
+SpatialGridIndex::GetKey (int64_t x, int64_t y)
+{
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+int64_t
+SpatialGridIndex::GetCellCoordinate (double coordinate) const
+{
+  // Clamp to the cells which fit in a key, far beyond any sensible scenario.
+  double cell = std::floor (coordinate / m_cellSize);
+  cell = std::max (std::min (cell, 2147483647.0), -2147483648.0);
+  return static_cast<int64_t> (cell);
+}
+
+void
+SpatialGridIndex::Bin (uint32_t index)
+{
+  Item &item = m_items[index];
+  Vector position = item.mobility->GetPosition ();
+  uint64_t cell = GetKey (GetCellCoordinate (position.x), GetCellCoordinate (position.y));
+  if (!item.binned || item.cell != cell)
+    {
+      if (item.binned)
+        {
+          std::vector<uint32_t> &old = m_cells[item.cell];
+          old.erase (std::find (old.begin (), old.end (), index));
+          if (old.empty ())
+            {
+              m_cells.erase (item.cell);
+            }
+        }
+      m_cells[cell].push_back (index);
+      item.cell = cell;
+      item.binned = true;
+    }
+  item.dirty = false;
+  m_maxSpeed = std::max (m_maxSpeed, item.mobility->GetVelocity ().GetLength ());
+}
+
+void
+SpatialGridIndex::Update (void)
+{
+  NS_ASSERT_MSG (m_cellSize > 0, "The cell size must be set before querying the index");
+  Time now = Simulator::Now ();
+  if (!m_refreshed || now - m_lastRefresh >= m_refreshInterval)
+    {
+      NS_LOG_LOGIC ("Re-binning all the " << m_items.size () << " items");
+      if (!m_refreshed)
+        {
+          m_cells.clear ();
+          for (std::vector<Item>::iterator i = m_items.begin (); i != m_items.end (); ++i)
+            {
+              i->binned = false;
+            }
+        }
+      m_maxSpeed = 0;
+      for (uint32_t i = 0; i < m_items.size (); ++i)
+        {
+          Bin (i);
+        }
+      m_dirty.clear ();
+      m_lastRefresh = now;
+      m_refreshed = true;
+      return;
+    }
+  for (std::vector<uint32_t>::const_iterator i = m_dirty.begin (); i != m_dirty.end (); ++i)
+    {
+      Bin (*i);
+    }
+  m_dirty.clear ();
+}
+
+void
+SpatialGridIndex::Query (const Vector &position, double range, std::vector<uint32_t> &items)
+{
+  NS_LOG_FUNCTION (this << position << range);
+  items.clear ();
+  Update ();
+  // An item may have moved away from its cell since it was binned, at
+  // most at the largest speed seen since the last refresh.
+  double radius = range + m_maxSpeed * (Simulator::Now () - m_lastRefresh).GetSeconds ();
+  int64_t xMin = GetCellCoordinate (position.x - radius);
+  int64_t xMax = GetCellCoordinate (position.x + radius);
+  int64_t yMin = GetCellCoordinate (position.y - radius);
+  int64_t yMax = GetCellCoordinate (position.y + radius);
+  double nCells = static_cast<double> (xMax - xMin + 1) * static_cast<double> (yMax - yMin + 1);
+  if (nCells > m_cells.size ())
+    {
+      // Cheaper to visit the occupied cells than the ones in range.
+      for (std::unordered_map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.begin (); i != m_cells.end (); ++i)
+        {
+          int64_t x = static_cast<int32_t> (i->first >> 32);
+          int64_t y = static_cast<int32_t> (i->first & 0xffffffff);
+          if (x >= xMin && x <= xMax && y >= yMin && y <= yMax)
+            {
+              items.insert (items.end (), i->second.begin (), i->second.end ());
+            }
+        }
+    }
+  else
+    {
+      for (int64_t x = xMin; x <= xMax; ++x)
+        {
+          for (int64_t y = yMin; y <= yMax; ++y)
+            {
+              std::unordered_map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.find (GetKey (x, y));
+              if (i != m_cells.end ())
+                {
+                  items.insert (items.end (), i->second.begin (), i->second.end ());
+                }
+            }
+        }
+    }
+  std::sort (items.begin (), items.end ());
+}
+
+void
+SpatialGridIndex::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  std::unordered_map<const MobilityModel *, uint32_t>::const_iterator i = m_indices.find (PeekPointer (mobility));
+  if (i != m_indices.end () && !m_items[i->second].dirty)
+    {
+      m_items[i->second].dirty = true;
+      m_dirty.push_back (i->second);
+    }
+}
+
+} // namespace ns3
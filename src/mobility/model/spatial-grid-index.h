@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_GRID_INDEX_H
+#define SPATIAL_GRID_INDEX_H
+
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/ptr.h"
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief A uniform grid of mobility models, to find the ones which may
+ * be within some range of a position without visiting all of them.
+ *
+ * Items are binned by their (x, y) position in square cells.  Instead
+ * of tracking every position continuously, the index re-bins an item
+ * when its mobility model notifies a course change, and re-bins all
+ * items every refresh interval.  Between two refreshes, the items can
+ * only drift from their cell at the largest speed seen at the last
+ * refresh or course change, so queries are widened by that drift.
+ * This holds for every mobility model which notifies a course change
+ * whenever its velocity changes, i.e., all the models of this module
+ * but ConstantAccelerationMobilityModel, for which the refresh
+ * interval bounds the error.
+ *
+ * Queries return a superset of the items within range, in the order
+ * they were added; callers check the actual distances or powers.
+ */
+class SpatialGridIndex
+{
+public:
+  SpatialGridIndex ();
+  ~SpatialGridIndex ();
+
+  /**
+   * Set the size of the cells; this is best close to the range of
+   * the queries.  Changing it re-bins all the items.
+   *
+   * \param size the side of a cell (m)
+   */
+  void SetCellSize (double size);
+  /**
+   * \returns the side of a cell (m), or zero if not set
+   */
+  double GetCellSize (void) const;
+  /**
+   * \param interval the interval between two re-binnings of all the items
+   */
+  void SetRefreshInterval (Time interval);
+  /**
+   * Add an item to the index; the position of its mobility model is
+   * read lazily, on the next query.
+   *
+   * \param mobility the mobility model of the new item
+   * \returns the index of the item, i.e., the number of items added before
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * \returns the number of items
+   */
+  uint32_t GetN (void) const;
+  /**
+   * Remove all the items, and disconnect from their mobility models.
+   */
+  void Clear (void);
+  /**
+   * Find the items which may be within range of a position.
+   *
+   * \param position the position
+   * \param range the range (m)
+   * \param items the indices of the items which may be in range, in
+   *        increasing order; items further than the range, in the (x, y)
+   *        plane, may or may not be included
+   */
+  void Query (const Vector &position, double range, std::vector<uint32_t> &items);
+
+private:
+  /** An item of the index. */
+  struct Item
+  {
+    Ptr<MobilityModel> mobility;  //!< the mobility model
+    uint64_t cell;                //!< the key of its cell
+    bool binned;                  //!< whether the item is in a cell
+    bool dirty;                   //!< whether it changed course since it was binned
+  };
+
+  /**
+   * \param x the x coordinate of the cell
+   * \param y the y coordinate of the cell
+   * \returns the key of the cell
+   */
+  static uint64_t GetKey (int64_t x, int64_t y);
+  /**
+   * \param coordinate a position coordinate (m)
+   * \returns the coordinate of the cell holding it
+   */
+  int64_t GetCellCoordinate (double coordinate) const;
+  /**
+   * Move an item to the cell of its current position.
+   *
+   * \param index the index of the item
+   */
+  void Bin (uint32_t index);
+  /**
+   * Re-bin the items which need it before a query.
+   */
+  void Update (void);
+  /**
+   * Mark an item as changing course.
+   *
+   * \param mobility the mobility model which changed course
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
+  std::vector<Item> m_items;                      //!< the items
+  std::unordered_map<const MobilityModel *, uint32_t> m_indices; //!< item index of each mobility model
+  std::unordered_map<uint64_t, std::vector<uint32_t> > m_cells;  //!< items of each cell
+  std::vector<uint32_t> m_dirty;                  //!< items to re-bin before the next query
+  double m_cellSize;                              //!< side of a cell (m)
+  Time m_refreshInterval;                         //!< interval between two full re-binnings
+  Time m_lastRefresh;                             //!< time of the last full re-binning
+  bool m_refreshed;                               //!< whether all the items were ever binned
+  double m_maxSpeed;                              //!< largest speed since the last full re-binning (m/s)
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_INDEX_H */
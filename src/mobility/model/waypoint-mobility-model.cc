@@ -88,7 +88,7 @@ WaypointMobilityModel::AddWaypoint (const Waypoint &waypoint)
     }
   else
     {
-      NS_ABORT_MSG_IF ( !m_waypoints.empty () && (m_waypoints.back ().time >= waypoint.time),
+      NS_ABORT_MSG_IF ( !m_waypoints.empty () && (m_waypoints.back ().time > waypoint.time),
                         "Waypoints must be added in ascending time order");
       m_waypoints.push_back (waypoint);
     }
@@ -151,7 +151,13 @@ WaypointMobilityModel::Update (void) const
       newWaypoint = true;
 
       const double t_span = (m_next.time - m_current.time).GetSeconds ();
-      NS_ASSERT (t_span > 0);
+      NS_ASSERT (t_span >= 0);
+      if ( t_span == 0 )
+        {
+          // Jump to the next waypoint, processed by the next iteration
+          m_velocity = Vector (0,0,0);
+          continue;
+        }
       m_velocity.x = (m_next.position.x - m_current.position.x) / t_span;
       m_velocity.y = (m_next.position.y - m_current.position.y) / t_span;
       m_velocity.z = (m_next.position.z - m_current.position.z) / t_span;
@@ -47,7 +47,9 @@ namespace ns3 {
  * velocity between the position at the previous waypoint and the position
  * at the current waypoint. To make a node hold a certain position for a
  * time interval, two waypoints with the same position (but different times)
- * should be inserted sequentially.
+ * should be inserted sequentially.  Conversely, two waypoints with the same
+ * time (but different positions) make the object jump from the first
+ * position to the second one at that time.
  *
  * Waypoints can be added at any time, and setting the current position
  * of an object will set its velocity to zero until the next waypoint time
@@ -80,8 +82,7 @@ namespace ns3 {
  * and SetPosition() is called before any waypoints have been added,
  * the SetPosition() call is treated as an initial waypoint at time zero.
  * In such a case, when SetPosition() is treated as an initial waypoint,
- * it should be noted that attempts to add a waypoint at the same time
- * will cause the program to fail.
+ * a waypoint added at the same time is a jump from that initial position.
  */
 class WaypointMobilityModel : public MobilityModel
 {
@@ -102,7 +103,7 @@ public:
    * \param waypoint waypoint to append to the object path.
    *
    * Add a waypoint to the path of the object. The time must
-   * be greater than the previous waypoint added, otherwise
+   * not be lower than the previous waypoint added, otherwise
    * a fatal error occurs. The first waypoint is set as the
    * current position with a velocity of zero.
    *
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "waypoint-trace-file.h"
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WaypointTraceFile");
+
+/// The magic number starting a waypoint trace
+static const char WAYPOINT_TRACE_MAGIC[8] = {'N', 'S', '3', 'W', 'A', 'Y', 'P', 'T'};
+/// The version of the waypoint trace format
+static const uint32_t WAYPOINT_TRACE_VERSION = 1;
+/// The size of the magic number, version and number of nodes
+static const std::size_t WAYPOINT_TRACE_HEADER_SIZE = 16;
+
+WaypointTraceFile::WaypointTraceFile (std::string filename)
+  : m_data (0),
+    m_size (0),
+    m_nNodes (0),
+    m_index (0),
+    m_records (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("Could not open waypoint trace " << filename << " for reading");
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || st.st_size < static_cast<off_t> (WAYPOINT_TRACE_HEADER_SIZE + sizeof (uint64_t)))
+    {
+      close (fd);
+      NS_FATAL_ERROR ("Waypoint trace " << filename << " is too short");
+    }
+  m_size = st.st_size;
+  m_data = mmap (0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (m_data == MAP_FAILED)
+    {
+      m_data = 0;
+      NS_FATAL_ERROR ("Could not map waypoint trace " << filename);
+    }
+
+  const char *data = static_cast<const char *> (m_data);
+  uint32_t version;
+  std::memcpy (&version, data + 8, sizeof (version));
+  std::memcpy (&m_nNodes, data + 12, sizeof (m_nNodes));
+  if (std::memcmp (data, WAYPOINT_TRACE_MAGIC, sizeof (WAYPOINT_TRACE_MAGIC)) != 0
+      || version != WAYPOINT_TRACE_VERSION)
+    {
+      NS_FATAL_ERROR ("File " << filename << " is not a waypoint trace of version " << WAYPOINT_TRACE_VERSION);
+    }
+  std::size_t recordsOffset = WAYPOINT_TRACE_HEADER_SIZE + (static_cast<std::size_t> (m_nNodes) + 1) * sizeof (uint64_t);
+  if (m_size < recordsOffset)
+    {
+      NS_FATAL_ERROR ("Waypoint trace " << filename << " is truncated");
+    }
+  m_index = reinterpret_cast<const uint64_t *> (data + WAYPOINT_TRACE_HEADER_SIZE);
+  m_records = reinterpret_cast<const Record *> (data + recordsOffset);
+  if (m_size < recordsOffset + m_index[m_nNodes] * sizeof (Record))
+    {
+      NS_FATAL_ERROR ("Waypoint trace " << filename << " is truncated");
+    }
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      if (m_index[i] > m_index[i + 1])
+        {
+          NS_FATAL_ERROR ("Waypoint trace " << filename << " has a corrupted index");
+        }
+    }
+  NS_LOG_DEBUG ("Mapped " << m_index[m_nNodes] << " waypoints of " << m_nNodes << " nodes");
+}
+
+WaypointTraceFile::~WaypointTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_data != 0)
+    {
+      munmap (m_data, m_size);
+    }
+}
+
+uint32_t
+WaypointTraceFile::GetNNodes (void) const
+{
+  return m_nNodes;
+}
+
+const WaypointTraceFile::Record *
+WaypointTraceFile::Begin (uint32_t node) const
+{
+  NS_ASSERT (node < m_nNodes);
+  return m_records + m_index[node];
+}
+
+const WaypointTraceFile::Record *
+WaypointTraceFile::End (uint32_t node) const
+{
+  NS_ASSERT (node < m_nNodes);
+  return m_records + m_index[node + 1];
+}
+
+void
+WaypointTraceFile::Write (std::string filename, const std::vector<std::vector<Waypoint> > &waypoints)
+{
+  NS_LOG_FUNCTION (filename << waypoints.size ());
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open waypoint trace " << filename << " for writing");
+    }
+  uint32_t nNodes = waypoints.size ();
+  file.write (WAYPOINT_TRACE_MAGIC, sizeof (WAYPOINT_TRACE_MAGIC));
+  file.write (reinterpret_cast<const char *> (&WAYPOINT_TRACE_VERSION), sizeof (WAYPOINT_TRACE_VERSION));
+  file.write (reinterpret_cast<const char *> (&nNodes), sizeof (nNodes));
+  uint64_t first = 0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      file.write (reinterpret_cast<const char *> (&first), sizeof (first));
+      first += waypoints[i].size ();
+    }
+  file.write (reinterpret_cast<const char *> (&first), sizeof (first));
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      for (std::vector<Waypoint>::const_iterator j = waypoints[i].begin (); j != waypoints[i].end (); ++j)
+        {
+          NS_ASSERT_MSG (j == waypoints[i].begin () || (j - 1)->time <= j->time,
+                         "The waypoints of node " << i << " are not in ascending time order");
+          Record record = {j->time.GetSeconds (), j->position.x, j->position.y, j->position.z};
+          file.write (reinterpret_cast<const char *> (&record), sizeof (record));
+        }
+    }
+  if (!file.good ())
+    {
+      NS_FATAL_ERROR ("Could not write waypoint trace " << filename);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WAYPOINT_TRACE_FILE_H
+#define WAYPOINT_TRACE_FILE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/simple-ref-count.h"
+#include "waypoint.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief A binary file holding the waypoints of many nodes, mapped in
+ * memory.
+ *
+ * The waypoints of each node are stored contiguously, in ascending time
+ * order, so that they can be read lazily without parsing: the file is
+ * mapped with mmap and the operating system only loads the pages which
+ * are actually read.  The layout, in host byte order, is:
+ \verbatim
+   char     magic[8]       "NS3WAYPT"
+   uint32_t version        1
+   uint32_t nNodes         number of nodes N
+   uint64_t index[N + 1]   first record of each node, then the number of records
+   Record   records[]      time (s), x, y, z (m), as four doubles
+ \endverbatim
+ *
+ * Ns2MobilityHelper::WriteWaypointTrace converts an ns-2 movement trace
+ * to this format, and WaypointTraceHelper feeds the waypoints to
+ * WaypointMobilityModel objects.
+ */
+class WaypointTraceFile : public SimpleRefCount<WaypointTraceFile>
+{
+public:
+  /** A waypoint, as stored in the file. */
+  struct Record
+  {
+    double time; //!< the time of the waypoint (s)
+    double x;    //!< the x coordinate (m)
+    double y;    //!< the y coordinate (m)
+    double z;    //!< the z coordinate (m)
+  };
+
+  /**
+   * Map a waypoint trace in memory; a missing or malformed file is a
+   * fatal error.
+   * \param filename the name of the waypoint trace
+   */
+  WaypointTraceFile (std::string filename);
+  ~WaypointTraceFile ();
+
+  /**
+   * \returns the number of nodes in the trace, i.e., one more than the
+   * largest node id
+   */
+  uint32_t GetNNodes (void) const;
+  /**
+   * \param node a node id, lower than GetNNodes
+   * \returns the first waypoint of the node
+   */
+  const Record * Begin (uint32_t node) const;
+  /**
+   * \param node a node id, lower than GetNNodes
+   * \returns past the last waypoint of the node
+   */
+  const Record * End (uint32_t node) const;
+
+  /**
+   * Write a waypoint trace.
+   * \param filename the name of the waypoint trace
+   * \param waypoints the waypoints of each node, indexed by node id, in
+   *        ascending time order
+   */
+  static void Write (std::string filename, const std::vector<std::vector<Waypoint> > &waypoints);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  WaypointTraceFile (const WaypointTraceFile &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  WaypointTraceFile & operator = (const WaypointTraceFile &);
+
+  void *m_data;              //!< the mapped file
+  std::size_t m_size;        //!< the size of the mapped file
+  uint32_t m_nNodes;         //!< the number of nodes
+  const uint64_t *m_index;   //!< the first record of each node
+  const Record *m_records;   //!< the records
+};
+
+} // namespace ns3
+
+#endif /* WAYPOINT_TRACE_FILE_H */
@@ -31,6 +31,9 @@
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/position-snapshot.h"
 
 using namespace ns3;
 
@@ -410,6 +413,77 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Test that PositionSnapshot returns the positions recorded at
+ * the start of each quantum, and the new ones after a course change
+ */
+class PositionSnapshotQuantum : public TestCase
+{
+public:
+  PositionSnapshotQuantum ();
+  virtual ~PositionSnapshotQuantum ();
+
+private:
+  /**
+   * Test X position function
+   * \param mob the mobility model
+   * \param expectedXPos the expected X position from the snapshot
+   */
+  void TestXPosition (Ptr<const MobilityModel> mob, double expectedXPos);
+  virtual void DoRun (void);
+};
+
+PositionSnapshotQuantum::PositionSnapshotQuantum ()
+  : TestCase ("Test PositionSnapshot quanta and course changes")
+{
+}
+
+PositionSnapshotQuantum::~PositionSnapshotQuantum ()
+{
+}
+
+void
+PositionSnapshotQuantum::TestXPosition (Ptr<const MobilityModel> mob, double expectedXPos)
+{
+  Vector pos = PositionSnapshot::GetPosition (mob);
+  NS_TEST_EXPECT_MSG_EQ_TOL_INTERNAL (pos.x, expectedXPos, 0.001, "Position not equal", __FILE__, __LINE__);
+}
+
+void
+PositionSnapshotQuantum::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (PositionSnapshot::GetQuantum (), Seconds (0), "Snapshots should be disabled by default");
+  PositionSnapshot::SetQuantum (MilliSeconds (100));
+
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetVelocity (Vector (10.0, 0.0, 0.0));
+  Ptr<ConstantPositionMobilityModel> fixed = CreateObject<ConstantPositionMobilityModel> ();
+  fixed->SetPosition (Vector (5.0, 0.0, 0.0));
+
+  // The first query of a quantum takes the snapshot, at 1 m.
+  Simulator::Schedule (MilliSeconds (100), &PositionSnapshotQuantum::TestXPosition, this, moving, 1);
+  Simulator::Schedule (MilliSeconds (100), &PositionSnapshotQuantum::TestXPosition, this, fixed, 5);
+  // Later queries of the same quantum return the same position.
+  Simulator::Schedule (MilliSeconds (150), &PositionSnapshotQuantum::TestXPosition, this, moving, 1);
+  // A course change is seen at once.
+  Simulator::Schedule (MilliSeconds (160), &MobilityModel::SetPosition, fixed, Vector (7.0, 0.0, 0.0));
+  Simulator::Schedule (MilliSeconds (170), &PositionSnapshotQuantum::TestXPosition, this, fixed, 7);
+  Simulator::Schedule (MilliSeconds (180), &ConstantVelocityMobilityModel::SetVelocity, moving, Vector (0.0, 0.0, 0.0));
+  Simulator::Schedule (MilliSeconds (190), &PositionSnapshotQuantum::TestXPosition, this, moving, 1.8);
+  // The next quantum starts at the first query after 200 ms.
+  Simulator::Schedule (MilliSeconds (210), &ConstantVelocityMobilityModel::SetVelocity, moving, Vector (10.0, 0.0, 0.0));
+  Simulator::Schedule (MilliSeconds (250), &PositionSnapshotQuantum::TestXPosition, this, moving, 2.2);
+  Simulator::Schedule (MilliSeconds (330), &PositionSnapshotQuantum::TestXPosition, this, moving, 2.2);
+  Simulator::Schedule (MilliSeconds (350), &PositionSnapshotQuantum::TestXPosition, this, moving, 3.2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (PositionSnapshot::GetQuantum (), Seconds (0), "Simulator::Destroy should revert the quantum");
+}
+
 /**
  * \ingroup mobility-test
  * \ingroup tests
@@ -429,6 +503,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new PositionSnapshotQuantum, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite; ///< the test suite
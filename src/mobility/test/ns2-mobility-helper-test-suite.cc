@@ -48,6 +48,8 @@
 #include "ns3/names.h"
 #include "ns3/config.h"
 #include "ns3/ns2-mobility-helper.h"
+#include "ns3/waypoint-trace-helper.h"
+#include "ns3/waypoint-mobility-model.h"
 
 using namespace ns3;
 
@@ -292,6 +294,118 @@ private:
   }
 };
 
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that a waypoint trace converted from an ns-2 trace
+ * moves the nodes like the ns-2 trace, and models jumps.
+ */
+class Ns2WaypointTraceTest : public TestCase
+{
+public:
+  Ns2WaypointTraceTest ()
+    : TestCase ("waypoint trace converted from an ns-2 trace")
+  {
+  }
+
+private:
+  /**
+   * Convert an ns-2 trace to a waypoint trace.
+   * \param trace the ns-2 trace
+   * \param name the base name of the files
+   * \return the name of the waypoint trace
+   */
+  std::string Convert (std::string const & trace, std::string const & name)
+  {
+    std::string ns2File = CreateTempDirFilename (name + ".tcl");
+    std::ofstream of (ns2File.c_str ());
+    of << trace;
+    of.close ();
+    std::string waypointFile = CreateTempDirFilename (name + ".waypoints");
+    Ns2MobilityHelper (ns2File).WriteWaypointTrace (waypointFile);
+    return waypointFile;
+  }
+  /**
+   * Compare the positions of two nodes.
+   * \param expected the mobility model moved by Ns2MobilityHelper
+   * \param actual the mobility model moved by WaypointTraceHelper
+   */
+  void ComparePositions (Ptr<const MobilityModel> expected, Ptr<const MobilityModel> actual)
+  {
+    NS_TEST_EXPECT_MSG_EQ (AreVectorsEqual (actual->GetPosition (), expected->GetPosition (), 0.001), true,
+                           "Position mismatch at time " << Simulator::Now ().GetSeconds () << " s: "
+                           << actual->GetPosition () << " instead of " << expected->GetPosition ());
+  }
+  /**
+   * Check the position of a node.
+   * \param model the mobility model
+   * \param position the expected position
+   */
+  void CheckPosition (Ptr<const MobilityModel> model, Vector position)
+  {
+    NS_TEST_EXPECT_MSG_EQ (AreVectorsEqual (model->GetPosition (), position, 0.001), true,
+                           "Position mismatch at time " << Simulator::Now ().GetSeconds () << " s: "
+                           << model->GetPosition () << " instead of " << position);
+  }
+
+  void DoRun ()
+  {
+    // Arrivals, interrupted movements and stops
+    std::string waypointFile = Convert ("$node_(0) set X_ 10.0\n"
+                                        "$node_(0) set Y_ 10.0\n"
+                                        "$ns_ at 1.0 \"$node_(0) setdest 20 10 5\"\n"
+                                        "$ns_ at 4.0 \"$node_(0) setdest 20 30 10\"\n"
+                                        "$ns_ at 5.0 \"$node_(0) setdest 0 20 5\"\n"
+                                        "$ns_ at 10.0 \"$node_(0) setdest 0 40 10\"\n"
+                                        "$ns_ at 10.5 \"$node_(0) setdest 0 0 0\"\n"
+                                        "$ns_ at 0.5 \"$node_(1) setdest 10 0 1\"\n"
+                                        "$ns_ at 2.0 \"$node_(2) setdest 5 5 1\"\n"
+                                        "$node_(1) set X_ 1.0\n",
+                                        "Ns2WaypointTraceTest");
+    NodeContainer expected;
+    expected.Create (3);
+    Ns2MobilityHelper (CreateTempDirFilename ("Ns2WaypointTraceTest.tcl")).Install (expected.Begin (), expected.End ());
+    NodeContainer actual;
+    actual.Create (3);
+    WaypointTraceHelper helper (waypointFile);
+    NS_TEST_ASSERT_MSG_EQ (helper.GetNNodes (), 3, "Wrong number of nodes in the waypoint trace");
+    helper.SetWaypointsAhead (2);
+    helper.Install (actual.Begin (), actual.End ());
+    for (uint32_t i = 0; i < 3; i++)
+      {
+        Ptr<WaypointMobilityModel> model = actual.Get (i)->GetObject<WaypointMobilityModel> ();
+        NS_TEST_ASSERT_MSG_NE (model, 0, "No WaypointMobilityModel installed");
+        NS_TEST_EXPECT_MSG_LT (model->WaypointsLeft (), 3, "Waypoints should be fed lazily");
+        for (double t = 0; t <= 14; t += 0.25)
+          {
+            Simulator::Schedule (Seconds (t), &Ns2WaypointTraceTest::ComparePositions, this,
+                                 expected.Get (i)->GetObject<MobilityModel> (), model);
+          }
+      }
+    Simulator::Run ();
+    Simulator::Destroy ();
+
+    // Jumps
+    waypointFile = Convert ("$ns_ at 1.0 \"$node_(0) set X_ 10\"\n"
+                            "$ns_ at 2.0 \"$node_(0) setdest 10 10 5\"\n"
+                            "$ns_ at 3.0 \"$node_(0) set Z_ 7\"\n"
+                            "$ns_ at 3.0 \"$node_(0) set Y_ 1\"\n",
+                            "Ns2WaypointTraceJumpTest");
+    Ptr<Node> node = CreateObject<Node> ();
+    std::vector<Ptr<Node> > nodes (1, node);
+    WaypointTraceHelper (waypointFile).Install (nodes.begin (), nodes.end ());
+    Ptr<MobilityModel> model = node->GetObject<MobilityModel> ();
+    Simulator::Schedule (Seconds (0.5), &Ns2WaypointTraceTest::CheckPosition, this, model, Vector (0, 0, 0));
+    Simulator::Schedule (Seconds (1.5), &Ns2WaypointTraceTest::CheckPosition, this, model, Vector (10, 0, 0));
+    Simulator::Schedule (Seconds (2.5), &Ns2WaypointTraceTest::CheckPosition, this, model, Vector (10, 2.5, 0));
+    Simulator::Schedule (Seconds (3.0), &Ns2WaypointTraceTest::CheckPosition, this, model, Vector (10, 1, 7));
+    Simulator::Schedule (Seconds (5.0), &Ns2WaypointTraceTest::CheckPosition, this, model, Vector (10, 1, 7));
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+};
+
 /**
  * \ingroup mobility-test
  * \ingroup tests
@@ -558,5 +672,6 @@ public:
     t->AddReferencePoint ("0", 920.000, Vector (300.000,  650.000, 0.000), Vector (0.000, 0.000, 0.000));
     AddTestCase (t, TestCase::QUICK);
 
+    AddTestCase (new Ns2WaypointTraceTest, TestCase::QUICK);
   }
 } g_ns2TransmobilityHelperTestSuite; ///< the test suite
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/pointer.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/position-allocator.h"
+#include "ns3/mobility-trace-recorder.h"
+#include "ns3/replay-mobility-helper.h"
+#include "ns3/replay-mobility-model.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that ReplayMobilityModel replays the trajectories
+ * recorded by MobilityTraceRecorder.
+ */
+class ReplayMobilityModelTest : public TestCase
+{
+public:
+  ReplayMobilityModelTest ()
+    : TestCase ("Check the replay of recorded trajectories")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Record the position and velocity of the nodes.
+   * \param nodes the nodes
+   */
+  void Sample (NodeContainer nodes);
+  /**
+   * Compare the position and velocity of the nodes with the samples of
+   * the recorded run.
+   * \param nodes the nodes
+   */
+  void Compare (NodeContainer nodes);
+  /**
+   * Count the course changes of a node.
+   * \param model the mobility model
+   */
+  void CourseChange (Ptr<const MobilityModel> model);
+
+  std::vector<Vector> m_positions;  //!< the positions sampled in the recorded run
+  std::vector<Vector> m_velocities; //!< the velocities sampled in the recorded run
+  std::size_t m_nextSample;         //!< the next sample to compare
+  uint32_t m_courseChanges;         //!< the number of course changes in the replay
+};
+
+void
+ReplayMobilityModelTest::Sample (NodeContainer nodes)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Ptr<MobilityModel> model = (*i)->GetObject<MobilityModel> ();
+      m_positions.push_back (model->GetPosition ());
+      m_velocities.push_back (model->GetVelocity ());
+    }
+}
+
+void
+ReplayMobilityModelTest::Compare (NodeContainer nodes)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i, ++m_nextSample)
+    {
+      Ptr<MobilityModel> model = (*i)->GetObject<MobilityModel> ();
+      NS_TEST_ASSERT_MSG_LT (m_nextSample, m_positions.size (), "Not enough samples");
+      NS_TEST_EXPECT_MSG_LT (CalculateDistance (model->GetPosition (), m_positions[m_nextSample]), 1e-6,
+                             "Position mismatch for node " << (*i)->GetId () << " at "
+                             << Simulator::Now ().GetSeconds () << " s: " << model->GetPosition ()
+                             << " instead of " << m_positions[m_nextSample]);
+      NS_TEST_EXPECT_MSG_LT (CalculateDistance (model->GetVelocity (), m_velocities[m_nextSample]), 1e-6,
+                             "Velocity mismatch for node " << (*i)->GetId () << " at "
+                             << Simulator::Now ().GetSeconds () << " s: " << model->GetVelocity ()
+                             << " instead of " << m_velocities[m_nextSample]);
+    }
+}
+
+void
+ReplayMobilityModelTest::CourseChange (Ptr<const MobilityModel> model)
+{
+  m_courseChanges++;
+}
+
+void
+ReplayMobilityModelTest::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("ReplayMobilityModelTest.waypoints");
+  Time stop = Seconds (60);
+  m_nextSample = 0;
+  m_courseChanges = 0;
+
+  // Record two random waypoint nodes, and a node which jumps
+  NodeContainer nodes;
+  nodes.Create (3);
+  ObjectFactory pos;
+  pos.SetTypeId ("ns3::RandomRectanglePositionAllocator");
+  pos.Set ("X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+  pos.Set ("Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+  Ptr<PositionAllocator> allocator = pos.Create ()->GetObject<PositionAllocator> ();
+  allocator->AssignStreams (1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                             "Speed", StringValue ("ns3::UniformRandomVariable[Min=1.0|Max=20.0]"),
+                             "Pause", StringValue ("ns3::ConstantRandomVariable[Constant=2.0]"),
+                             "PositionAllocator", PointerValue (allocator));
+  mobility.SetPositionAllocator (allocator);
+  NodeContainer walking (nodes.Get (0), nodes.Get (1));
+  mobility.Install (walking);
+  mobility.AssignStreams (walking, 10);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (nodes.Get (2));
+  Ptr<ConstantVelocityMobilityModel> jumping = nodes.Get (2)->GetObject<ConstantVelocityMobilityModel> ();
+  jumping->SetVelocity (Vector (1, 2, 0));
+  Simulator::Schedule (Seconds (10), &MobilityModel::SetPosition, jumping, Vector (50, 50, 5));
+  Simulator::Schedule (Seconds (20), &ConstantVelocityMobilityModel::SetVelocity, jumping, Vector (0, 0, 0));
+
+  MobilityTraceRecorder recorder;
+  recorder.Install (nodes);
+  for (Time t = MilliSeconds (250); t < stop; t += MilliSeconds (500))
+    {
+      Simulator::Schedule (t, &ReplayMobilityModelTest::Sample, this, nodes);
+    }
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  recorder.Write (filename);
+  Simulator::Destroy ();
+
+  // Replay them
+  NodeContainer replayed;
+  replayed.Create (3);
+  ReplayMobilityHelper replay (filename);
+  NS_TEST_ASSERT_MSG_EQ (replay.GetNNodes (), 3, "Wrong number of nodes in the trace");
+  replay.Install (replayed);
+  for (NodeContainer::Iterator i = replayed.Begin (); i != replayed.End (); ++i)
+    {
+      Ptr<MobilityModel> model = (*i)->GetObject<ReplayMobilityModel> ();
+      NS_TEST_ASSERT_MSG_NE (model, 0, "No ReplayMobilityModel installed");
+      model->TraceConnectWithoutContext ("CourseChange", MakeCallback (&ReplayMobilityModelTest::CourseChange, this));
+    }
+  for (Time t = MilliSeconds (250); t < stop; t += MilliSeconds (500))
+    {
+      Simulator::Schedule (t, &ReplayMobilityModelTest::Compare, this, replayed);
+    }
+  Simulator::Stop (stop + Seconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_nextSample, m_positions.size (), "Not all the samples were compared");
+  NS_TEST_EXPECT_MSG_GT (m_courseChanges, 3, "The course changes were not notified");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Replay Mobility Model Test Suite
+ */
+static struct ReplayMobilityModelTestSuite : public TestSuite
+{
+  ReplayMobilityModelTestSuite () : TestSuite ("replay-mobility-model", UNIT)
+  {
+    AddTestCase (new ReplayMobilityModelTest (), TestCase::QUICK);
+  }
+} g_replayMobilityModelTestSuite; ///< the test suite
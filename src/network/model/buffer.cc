@@ -244,7 +244,19 @@ void
 Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
-  m_data = Buffer::Create (0);
+  if (g_recommendedStart <= BUFFER_INLINE_SIZE - BUFFER_INLINE_SIZE / 8)
+    {
+      /* the usual headers fit in the inline data, with some room
+       * left for the trailers.
+       */
+      m_data = reinterpret_cast<struct Buffer::Data *> (m_inline);
+      m_data->m_count = 1;
+      m_data->m_size = BUFFER_INLINE_SIZE;
+    }
+  else
+    {
+      m_data = Buffer::Create (0);
+    }
   m_start = std::min (m_data->m_size, g_recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
@@ -259,14 +271,18 @@ Buffer &
 Buffer::operator = (Buffer const&o)
 {
   NS_ASSERT (CheckInternalState ());
-  if (m_data != o.m_data) 
+  if (o.IsInline ())
     {
-      // not assignment to self.
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (this != &o)
         {
-          Recycle (m_data);
+          Release ();
+          CopyInline (o);
         }
+    }
+  else if (m_data != o.m_data) 
+    {
+      // not assignment to self.
+      Release ();
       m_data = o.m_data;
       m_data->m_count++;
     }
@@ -285,6 +301,17 @@ Buffer::~Buffer ()
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  Release ();
+}
+
+void
+Buffer::Release (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (IsInline ())
+    {
+      return;
+    }
   m_data->m_count--;
   if (m_data->m_count == 0) 
     {
@@ -328,11 +355,7 @@ Buffer::AddAtStart (uint32_t start)
       uint32_t newSize = GetInternalSize () + start;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data + start, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0)
-        {
-          Buffer::Recycle (m_data);
-        }
+      Release ();
       m_data = newData;
 
       int32_t delta = start - m_start;
@@ -373,11 +396,7 @@ Buffer::AddAtEnd (uint32_t end)
       uint32_t newSize = GetInternalSize () + end;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
-        {
-          Buffer::Recycle (m_data);
-        }
+      Release ();
       m_data = newData;
 
       int32_t delta = -m_start;
@@ -21,11 +21,14 @@
 #define BUFFER_H
 
 #include <stdint.h>
+#include <cstddef>
 #include <vector>
 #include <ostream>
 #include "ns3/assert.h"
 
 #define BUFFER_FREE_LIST 1
+/// Number of data bytes a Buffer can hold without a BufferData allocation
+#define BUFFER_INLINE_SIZE 128
 
 namespace ns3 {
 
@@ -88,6 +91,16 @@ namespace ns3 {
  * \endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * A new Buffer starts with its BufferData stored inline, in the Buffer
+ * instance itself, with room for BUFFER_INLINE_SIZE real bytes: the
+ * headers of most control packets fit there, so that no BufferData is
+ * allocated for them.  Inline BufferData is never shared: copying or
+ * assigning a Buffer which uses it copies the real bytes, and its
+ * m_count field always is one.  Adding more bytes than it can hold moves
+ * the content to a BufferData allocated as usual.  Iterators and
+ * pointers returned by PeekData are thus tied to the Buffer instance
+ * they were obtained from when it uses inline BufferData.
  */
 class Buffer 
 {
@@ -685,6 +698,25 @@ private:
     uint8_t m_data[1];
   };
 
+  /**
+   * \returns true if m_data is the inline BufferData of this instance
+   */
+  inline bool IsInline (void) const;
+  /**
+   * \brief Make m_data point to the inline BufferData of this
+   * instance, and copy there the inline BufferData of another Buffer.
+   *
+   * Only the real bytes referenced by the other Buffer are copied.
+   *
+   * \param o the Buffer whose m_data is its inline BufferData
+   */
+  inline void CopyInline (Buffer const &o);
+  /**
+   * \brief Drop the reference held by this instance on its BufferData,
+   * and recycle the BufferData if it was the last one.
+   */
+  void Release (void);
+
   /**
    * \brief Create a full copy of the buffer, including
    * all the internal structures.
@@ -750,6 +782,8 @@ private:
   static void Deallocate (struct Buffer::Data *data);
 
   struct Data *m_data; //!< the buffer data storage
+  /// the inline buffer data storage, used by m_data while it is large enough
+  alignas (struct Data) uint8_t m_inline[offsetof (struct Data, m_data) + BUFFER_INLINE_SIZE];
 
   /**
    * keep track of the maximum value of m_zeroAreaStart across
@@ -1055,10 +1089,32 @@ Buffer::Buffer (Buffer const&o)
     m_start (o.m_start),
     m_end (o.m_end)
 {
-  m_data->m_count++;
+  if (o.IsInline ())
+    {
+      CopyInline (o);
+    }
+  else
+    {
+      m_data->m_count++;
+    }
   NS_ASSERT (CheckInternalState ());
 }
 
+bool
+Buffer::IsInline (void) const
+{
+  return m_data == reinterpret_cast<struct Data const *> (m_inline);
+}
+
+void
+Buffer::CopyInline (Buffer const &o)
+{
+  m_data = reinterpret_cast<struct Data *> (m_inline);
+  std::memcpy (m_inline, o.m_inline, offsetof (struct Data, m_data));
+  std::memcpy (m_data->m_data + o.m_start, o.m_data->m_data + o.m_start,
+               o.m_end - (o.m_zeroAreaEnd - o.m_zeroAreaStart) - o.m_start);
+}
+
 uint32_t 
 Buffer::GetSize (void) const
 {
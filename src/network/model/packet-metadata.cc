@@ -26,6 +26,7 @@
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
+#include "packet-slab-allocator.h"
 
 namespace ns3 {
 
@@ -624,9 +625,10 @@ PacketMetadata::Allocate (uint32_t n)
       n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-  uint8_t *buf = new uint8_t [size];
-  struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
-  data->m_size = n;
+  // Use all the space of the block
+  uint32_t blockSize = PacketSlabAllocator::GetBlockSize (size);
+  struct PacketMetadata::Data *data = static_cast<struct PacketMetadata::Data *> (PacketSlabAllocator::Allocate (blockSize));
+  data->m_size = n + (blockSize - size);
   data->m_count = 1;
   data->m_dirtyEnd = 0;
   return data;
@@ -635,8 +637,7 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  uint8_t *buf = (uint8_t *)data;
-  delete [] buf;
+  PacketSlabAllocator::Deallocate (data, sizeof (struct Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 
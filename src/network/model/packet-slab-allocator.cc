@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-slab-allocator.h"
+#include <new>
+#include <cstddef>
+
+namespace {
+
+/** Largest block size served from slabs, in bytes. */
+const uint32_t g_slabMaxSize = 4096;
+/** Size of a slab, in bytes, unless it would hold less than g_slabMinBlocks blocks. */
+const uint32_t g_slabSize = 16384;
+/** Minimum number of blocks in a slab. */
+const uint32_t g_slabMinBlocks = 16;
+/** Number of size classes, as built by SizeClasses. */
+const uint32_t g_nSizeClasses = 26;
+
+/**
+ * The size classes, and the class of each block size rounded up to a
+ * multiple of 8 bytes, computed at compile time.
+ */
+struct SizeClasses
+{
+  uint32_t size[g_nSizeClasses];                 //!< the block size of each class
+  uint8_t classOf[g_slabMaxSize / 8 + 1];        //!< the class of (size + 7) / 8
+
+  constexpr SizeClasses ()
+    : size (),
+      classOf ()
+  {
+    uint32_t n = 0;
+    uint32_t c = 8;
+    while (c <= g_slabMaxSize)
+      {
+        size[n++] = c;
+        if (c < 64)
+          {
+            c += 8;
+          }
+        else if (c < g_slabMaxSize)
+          {
+            c = ((c * 5 / 4 + 7) / 8) * 8;
+            c = c > g_slabMaxSize ? g_slabMaxSize : c;
+          }
+        else
+          {
+            break;
+          }
+      }
+    uint32_t k = 0;
+    for (uint32_t i = 0; i <= g_slabMaxSize / 8; i++)
+      {
+        while (size[k] < i * 8)
+          {
+            k++;
+          }
+        classOf[i] = k;
+      }
+  }
+};
+
+/** The size classes. */
+constexpr SizeClasses g_sizeClasses;
+
+static_assert (g_sizeClasses.size[g_nSizeClasses - 1] == g_slabMaxSize,
+               "g_nSizeClasses does not match the size classes");
+
+/** A free block. */
+struct FreeBlock
+{
+  FreeBlock *next;          //!< the next free block of the same class
+};
+
+/** Free lists of the calling thread, indexed by size class. */
+thread_local FreeBlock *g_freeLists[g_nSizeClasses];
+/** Number of bytes of slabs allocated by the calling thread. */
+thread_local uint64_t g_slabBytes = 0;
+
+/**
+ * Allocate a new slab, and put its blocks in the free list of a class.
+ * \param [in] sizeClass the size class
+ */
+void
+RefillFreeList (uint32_t sizeClass)
+{
+  uint32_t blockSize = g_sizeClasses.size[sizeClass];
+  uint32_t nBlocks = g_slabSize / blockSize;
+  if (nBlocks < g_slabMinBlocks)
+    {
+      nBlocks = g_slabMinBlocks;
+    }
+  char *slab = static_cast<char *> (::operator new (static_cast<std::size_t> (nBlocks) * blockSize));
+  g_slabBytes += static_cast<uint64_t> (nBlocks) * blockSize;
+  // Link the blocks in address order
+  for (uint32_t i = nBlocks; i > 0; i--)
+    {
+      FreeBlock *block = reinterpret_cast<FreeBlock *> (slab + (i - 1) * blockSize);
+      block->next = g_freeLists[sizeClass];
+      g_freeLists[sizeClass] = block;
+    }
+}
+
+} // unnamed namespace
+
+namespace ns3 {
+
+void *
+PacketSlabAllocator::Allocate (uint32_t size)
+{
+  // Do not add function logging here, blocks are allocated for most
+  // packet operations.
+  if (size > g_slabMaxSize)
+    {
+      return ::operator new (size);
+    }
+  uint32_t sizeClass = g_sizeClasses.classOf[(size + 7) / 8];
+  if (g_freeLists[sizeClass] == 0)
+    {
+      RefillFreeList (sizeClass);
+    }
+  FreeBlock *block = g_freeLists[sizeClass];
+  g_freeLists[sizeClass] = block->next;
+  return block;
+}
+
+void
+PacketSlabAllocator::Deallocate (void *block, uint32_t size)
+{
+  if (block == 0)
+    {
+      return;
+    }
+  if (size > g_slabMaxSize)
+    {
+      ::operator delete (block);
+      return;
+    }
+  uint32_t sizeClass = g_sizeClasses.classOf[(size + 7) / 8];
+  FreeBlock *free = static_cast<FreeBlock *> (block);
+  free->next = g_freeLists[sizeClass];
+  g_freeLists[sizeClass] = free;
+}
+
+uint32_t
+PacketSlabAllocator::GetBlockSize (uint32_t size)
+{
+  if (size > g_slabMaxSize)
+    {
+      return size;
+    }
+  return g_sizeClasses.size[g_sizeClasses.classOf[(size + 7) / 8]];
+}
+
+uint32_t
+PacketSlabAllocator::GetMaxSize (void)
+{
+  return g_slabMaxSize;
+}
+
+uint64_t
+PacketSlabAllocator::GetSlabBytes (void)
+{
+  return g_slabBytes;
+}
+
+} // namespace ns3
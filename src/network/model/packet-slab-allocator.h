@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PACKET_SLAB_ALLOCATOR_H
+#define PACKET_SLAB_ALLOCATOR_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief Allocate the small variable-sized blocks attached to packets:
+ * the packet tag items of PacketTagList, the byte tag buffers of
+ * ByteTagList and the metadata buffers of PacketMetadata.
+ *
+ * Blocks are rounded up to a size class and carved from slabs; a
+ * freed block goes to the free list of its class, and is reused by the
+ * next allocation of the same class without going through the heap.
+ * The classes are 8 bytes apart up to 64 bytes, where most packet tag
+ * items fall (23 bytes plus the serialized size of the tag), then
+ * grow by a quarter up to 4096 bytes.  Larger blocks come from the heap.
+ *
+ * The free lists are per thread, so that no locking is needed: a
+ * block freed by another thread than the one which allocated it moves
+ * to the free lists of that thread.  Slabs are never returned to the
+ * heap.
+ *
+ * Blocks are freed with the size they were allocated with, or with
+ * any size up to the one returned by GetBlockSize, so that no header
+ * is needed in front of them.  This class is mostly private to the
+ * Packet implementation.
+ */
+class PacketSlabAllocator
+{
+public:
+  /**
+   * \param [in] size the size of the block, in bytes
+   * \returns a block of at least GetBlockSize (size) bytes, aligned
+   * for any object of at most 8 bytes
+   */
+  static void * Allocate (uint32_t size);
+  /**
+   * \param [in] block the block to free, or 0
+   * \param [in] size the size it was allocated with, or any size
+   * between that size and GetBlockSize of that size
+   */
+  static void Deallocate (void *block, uint32_t size);
+  /**
+   * \param [in] size the size of a block, in bytes
+   * \returns the number of bytes actually usable in a block
+   * allocated with this size
+   */
+  static uint32_t GetBlockSize (uint32_t size);
+  /**
+   * \returns the largest block size served from slabs
+   */
+  static uint32_t GetMaxSize (void);
+  /**
+   * \returns the number of bytes of slabs allocated by the calling
+   * thread
+   */
+  static uint64_t GetSlabBytes (void);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_SLAB_ALLOCATOR_H */
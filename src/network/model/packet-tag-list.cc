@@ -43,8 +43,8 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  void * p = PacketSlabAllocator::Allocate (sizeof (TagData) + dataSize - 1);
+  // The matching frees are in FreeTagData
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
@@ -194,8 +194,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
@@ -389,6 +389,116 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that small buffers, whose bytes are stored in the Buffer
+ * instance, behave as the buffers whose bytes are shared.
+ */
+class BufferInlineTest : public TestCase {
+public:
+  virtual void DoRun (void);
+  BufferInlineTest ();
+private:
+  /**
+   * Checks the buffer content
+   * \param b The buffer to check
+   * \param first The value of the first byte, the next ones being incremented
+   * \returns true if the bytes of the buffer hold the expected values
+   */
+  static bool CheckBytes (Buffer const &b, uint8_t first);
+};
+
+BufferInlineTest::BufferInlineTest ()
+  : TestCase ("Buffer with inline data") {
+}
+
+bool
+BufferInlineTest::CheckBytes (Buffer const &b, uint8_t first)
+{
+  Buffer::Iterator i = b.Begin ();
+  for (uint32_t j = 0; j < b.GetSize (); j++)
+    {
+      if (i.ReadU8 () != static_cast<uint8_t> (first + j))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+BufferInlineTest::DoRun (void)
+{
+  Buffer a;
+  a.AddAtStart (16);
+  Buffer::Iterator i = a.Begin ();
+  for (uint8_t j = 0; j < 16; j++)
+    {
+      i.WriteU8 (j);
+    }
+
+  // A copy does not see the bytes written later in the original
+  Buffer b = a;
+  b.Begin ().WriteU8 (100);
+  a.AddAtStart (1);
+  a.Begin ().WriteU8 (255);
+  NS_TEST_EXPECT_MSG_EQ (a.GetSize (), 17, "Wrong size of the original");
+  NS_TEST_EXPECT_MSG_EQ (a.Begin ().ReadU8 (), 255, "Wrong byte added to the original");
+  a.RemoveAtStart (1);
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (a, 0), true, "The copy changed the original");
+  b.Begin ().WriteU8 (0);
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (b, 0), true, "Wrong bytes in the copy");
+
+  // Growing past the inline data keeps the bytes
+  Buffer c = a;
+  for (uint32_t n = 0; n < 40; n++)
+    {
+      c.AddAtStart (8);
+      Buffer::Iterator k = c.Begin ();
+      for (uint8_t j = 0; j < 8; j++)
+        {
+          k.WriteU8 (static_cast<uint8_t> (j - 8 * (n + 1)));
+        }
+      c.AddAtEnd (1);
+      Buffer::Iterator end = c.End ();
+      end.Prev (1);
+      end.WriteU8 (static_cast<uint8_t> (c.GetSize () - 1 - 8 * (n + 1)));
+    }
+  NS_TEST_EXPECT_MSG_EQ (c.GetSize (), 16 + 40 * 9, "Wrong size of the grown buffer");
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (c, static_cast<uint8_t> (-320)), true, "Wrong bytes in the grown buffer");
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (a, 0), true, "Growing the copy changed the original");
+
+  // Assignments between inline and shared data, and to self
+  Buffer d = c;
+  d = a;
+  NS_TEST_EXPECT_MSG_EQ (d.GetSize (), 16, "Wrong size after assignment");
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (d, 0), true, "Wrong bytes after assignment");
+  Buffer &alias = d;
+  d = alias;
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (d, 0), true, "Wrong bytes after self assignment");
+  a = c;
+  NS_TEST_EXPECT_MSG_EQ (CheckBytes (a, static_cast<uint8_t> (-320)), true, "Wrong bytes after assignment of shared data");
+
+  // Fragments and zero areas
+  Buffer e (1000);
+  e.AddAtStart (4);
+  e.Begin ().WriteHtonU32 (0x01020304);
+  e.AddAtEnd (4);
+  Buffer::Iterator tail = e.End ();
+  tail.Prev (4);
+  tail.WriteHtonU32 (0x05060708);
+  Buffer f = e.CreateFragment (2, 1004);
+  NS_TEST_EXPECT_MSG_EQ (f.GetSize (), 1004, "Wrong size of the fragment");
+  Buffer::Iterator k = f.Begin ();
+  NS_TEST_EXPECT_MSG_EQ (k.ReadNtohU16 (), 0x0304, "Wrong start of the fragment");
+  k.Next (1000);
+  NS_TEST_EXPECT_MSG_EQ (k.ReadNtohU16 (), 0x0506, "Wrong end of the fragment");
+  e = Buffer ();
+  NS_TEST_EXPECT_MSG_EQ (f.GetSize (), 1004, "The fragment changed");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -405,6 +515,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferInlineTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -19,6 +19,7 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-slab-allocator.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
 #include <limits>     // std:numeric_limits
@@ -27,6 +28,9 @@
 #include <iostream>
 #include <iomanip>
 #include <ctime>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 using namespace ns3;
 
@@ -1158,6 +1162,89 @@ PacketTagListTest::DoRun (void)
     
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * PacketSlabAllocator unit tests.
+ */
+class PacketSlabAllocatorTest : public TestCase
+{
+public:
+  PacketSlabAllocatorTest ();
+private:
+  void DoRun (void);
+};
+
+PacketSlabAllocatorTest::PacketSlabAllocatorTest ()
+  : TestCase ("Check the size classes and the reuse of the packet slab allocator")
+{
+}
+
+void
+PacketSlabAllocatorTest::DoRun (void)
+{
+  uint32_t previous = 0;
+  for (uint32_t size = 1; size <= PacketSlabAllocator::GetMaxSize (); size++)
+    {
+      uint32_t blockSize = PacketSlabAllocator::GetBlockSize (size);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (blockSize, size, "Block too small for " << size << " bytes");
+      NS_TEST_ASSERT_MSG_EQ (blockSize % 8, 0, "Misaligned block size for " << size << " bytes");
+      NS_TEST_ASSERT_MSG_EQ (PacketSlabAllocator::GetBlockSize (blockSize), blockSize,
+                             "Block size of " << size << " bytes not stable");
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (blockSize, previous, "Block sizes not increasing at " << size << " bytes");
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (blockSize - size, std::max<uint32_t> (7, size / 4 + 8),
+                                   "Too much waste for " << size << " bytes");
+      previous = blockSize;
+    }
+  uint32_t large = PacketSlabAllocator::GetMaxSize () + 1;
+  NS_TEST_EXPECT_MSG_EQ (PacketSlabAllocator::GetBlockSize (large), large, "Large blocks are not rounded");
+
+  // Blocks of a class are distinct, aligned and reused last in, first out
+  std::vector<void *> blocks;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      void *block = PacketSlabAllocator::Allocate (24);
+      NS_TEST_ASSERT_MSG_EQ (reinterpret_cast<uintptr_t> (block) % 8, 0, "Misaligned block");
+      std::memset (block, 0xa5, 24);
+      blocks.push_back (block);
+    }
+  std::vector<void *> sorted = blocks;
+  std::sort (sorted.begin (), sorted.end ());
+  NS_TEST_EXPECT_MSG_EQ ((std::adjacent_find (sorted.begin (), sorted.end ()) == sorted.end ()), true,
+                         "A block was allocated twice");
+  PacketSlabAllocator::Deallocate (blocks[42], 24);
+  NS_TEST_EXPECT_MSG_EQ (PacketSlabAllocator::Allocate (20), blocks[42], "Freed block not reused by its class");
+  for (uint32_t i = 0; i < blocks.size (); i++)
+    {
+      PacketSlabAllocator::Deallocate (blocks[i], 24);
+    }
+  PacketSlabAllocator::Deallocate (0, 24);
+
+  // Once the slabs are there, packets with tags do not allocate slabs
+  ATestTag<7> tag;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint64_t slabBytes = PacketSlabAllocator::GetSlabBytes ();
+      for (uint32_t j = 0; j < 100; j++)
+        {
+          Ptr<Packet> p = Create<Packet> (100);
+          p->AddPacketTag (tag);
+          p->AddByteTag (tag);
+          Ptr<Packet> q = p->Copy ();
+          q->RemovePacketTag (tag);
+        }
+      if (i == 1)
+        {
+          NS_TEST_EXPECT_MSG_EQ (PacketSlabAllocator::GetSlabBytes (), slabBytes, "Freed blocks not reused");
+        }
+    }
+
+  void *block = PacketSlabAllocator::Allocate (large);
+  std::memset (block, 0, large);
+  PacketSlabAllocator::Deallocate (block, large);
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1175,6 +1262,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketSlabAllocatorTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
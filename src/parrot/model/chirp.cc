@@ -29,6 +29,7 @@
 */
 
 #include "parrot-routing-protocol.h"
+#include "ns3/position-snapshot.h"
 
 namespace ns3 {
 namespace parrot {
@@ -132,7 +133,7 @@ RoutingProtocol::SendMultiHopChirp ()
   MultiHopChirp chirp;
 
   // Set fallback information
-  Vector3D p = mobility->GetPosition ();
+  Vector3D p = PositionSnapshot::GetPosition (mobility);
   trackPosition (p);
 
   Vector3D forecast = forecastPosition ();
@@ -84,7 +84,10 @@ RoutingProtocol::GetTypeId (void)
                          MakeStringChecker ())
           .AddAttribute ("RangeOffset", "Offset for communication range estimation",
                          DoubleValue (0.0), MakeDoubleAccessor (&RoutingProtocol::rangeOffset),
-                         MakeDoubleChecker<double> ());
+                         MakeDoubleChecker<double> ())
+          .AddTraceSource ("RoutingDecision", "The next hop chosen for a packet.",
+                           MakeTraceSourceAccessor (&RoutingProtocol::m_routingDecisionTrace),
+                           "ns3::Ipv4RoutingDecision::TracedCallback");
 
   return tid;
 }
@@ -190,6 +193,11 @@ RoutingProtocol::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDe
           sockerr = Socket::ERROR_NOROUTETOHOST;
           return Ptr<Ipv4Route> ();
         }
+      // The broadcast entries only stand for the interfaces
+      if (!dst.IsBroadcast () && dst != rt.GetInterface ().GetBroadcast ())
+        {
+          NotifyRoutingDecision (p, dst, rt.GetNextHop ());
+        }
       return route;
     }
   else
@@ -206,6 +214,7 @@ RoutingProtocol::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDe
               sockerr = Socket::ERROR_NOROUTETOHOST;
               return Ptr<Ipv4Route> ();
             }
+          NotifyRoutingDecision (p, dst, rt.GetNextHop ());
           return route;
         }
       else
@@ -326,6 +335,7 @@ RoutingProtocol::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
       NS_LOG_LOGIC (m_mainAddress << " is forwarding packet " << p->GetUid () << " to " << dst
                                   << " from " << header.GetSource () << " via nexthop neighbor "
                                   << toDst.GetNextHop ());
+      NotifyRoutingDecision (p, dst, toDst.GetNextHop ());
       ucb (route, p, header);
       return true;
     }
@@ -333,6 +343,36 @@ RoutingProtocol::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
   return false;
 }
 
+void
+RoutingProtocol::NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst,
+                                        Ipv4Address nextHop)
+{
+  if (m_routingDecisionTrace.IsEmpty ())
+    {
+      return;
+    }
+  Ipv4RoutingDecision decision;
+  decision.time = Simulator::Now ();
+  decision.node = m_ipv4->GetObject<Node> ()->GetId ();
+  decision.packetUid = packet != 0 ? packet->GetUid () : 0;
+  decision.destination = dst;
+  decision.nextHop = nextHop;
+  decision.value = 0;
+  std::map<Ipv4Address, std::map<Ipv4Address, PCE *>>::const_iterator target = m_QTable.find (dst);
+  if (target != m_QTable.end ())
+    {
+      std::map<Ipv4Address, PCE *>::const_iterator hop = target->second.find (nextHop);
+      if (hop != target->second.end ())
+        {
+          decision.value = hop->second->Q ();
+        }
+    }
+  // PARRoT always follows the best route it learnt
+  decision.exploration = false;
+  decision.nNeighbors = Vi.size ();
+  m_routingDecisionTrace (decision);
+}
+
 void
 RoutingProtocol::NotifyInterfaceUp (uint32_t i)
 {
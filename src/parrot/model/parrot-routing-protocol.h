@@ -45,6 +45,8 @@
 #include "ns3/controlled-random-waypoint-mobility-model.h"
 
 #include "ns3/timer.h"
+#include "ns3/traced-callback.h"
+#include "ns3/ipv4-routing-decision.h"
 
 #include <algorithm>
 #include <deque>
@@ -235,6 +237,16 @@ private:
   UnicastForwardCallback m_scb;
   /// Error callback for own packets
   ErrorCallback m_ecb;
+  /// Trace of the next hops chosen for the packets
+  TracedCallback<const Ipv4RoutingDecision &> m_routingDecisionTrace;
+
+  /**
+   * Reports the next hop chosen for a packet to the RoutingDecision trace
+   * \param packet The packet
+   * \param dst The destination of the packet
+   * \param nextHop The next hop
+   */
+  void NotifyRoutingDecision (Ptr<const Packet> packet, Ipv4Address dst, Ipv4Address nextHop);
 
   /**
    * Find socket with local interface address iface
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cached-propagation-loss-model.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+/// Number of consecutive slots where an entry may be stored
+static const uint32_t MAX_PROBES = 8;
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The deterministic propagation loss model whose results are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationLossModel::SetModel,
+                                        &CachedPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("CacheSize",
+                   "The number of reception powers the cache can hold, "
+                   "rounded up to a power of two.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&CachedPropagationLossModel::m_size),
+                   MakeUintegerChecker<uint32_t> (1, 1u << 31))
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+  : m_hits (0),
+    m_misses (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_model = 0;
+  m_entries.clear ();
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_model = model;
+  m_entries.clear ();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+uint64_t
+CachedPropagationLossModel::GetHits (void) const
+{
+  return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetMisses (void) const
+{
+  return m_misses;
+}
+
+uint64_t
+CachedPropagationLossModel::Hash (const MobilityModel *a, const MobilityModel *b, double txPowerDbm)
+{
+  uint64_t power;
+  std::memcpy (&power, &txPowerDbm, sizeof (power));
+  uint64_t h = reinterpret_cast<uintptr_t> (a);
+  h = (h ^ (h >> 31)) * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t> (b);
+  h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ULL + power;
+  return h ^ (h >> 32);
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "No propagation loss model to cache");
+  if (m_entries.empty ())
+    {
+      uint32_t size = 1;
+      while (size < m_size)
+        {
+          size <<= 1;
+        }
+      Entry free = {0, 0, 0, 0, 0, 0};
+      m_entries.assign (size, free);
+    }
+
+  uint64_t aEpoch = a->GetPositionEpoch ();
+  uint64_t bEpoch = b->GetPositionEpoch ();
+  uint64_t mask = m_entries.size () - 1;
+  uint64_t h = Hash (PeekPointer (a), PeekPointer (b), txPowerDbm);
+  Entry *slot = 0;
+  for (uint32_t i = 0; i < MAX_PROBES; i++)
+    {
+      Entry &entry = m_entries[(h + i) & mask];
+      if (entry.a == PeekPointer (a) && entry.b == PeekPointer (b) && entry.txPowerDbm == txPowerDbm)
+        {
+          if (entry.aEpoch == aEpoch && entry.bEpoch == bEpoch)
+            {
+              m_hits++;
+              return entry.rxPowerDbm;
+            }
+          // A node moved since: refresh this entry
+          slot = &entry;
+          break;
+        }
+      if (entry.a == 0)
+        {
+          slot = &entry;
+          break;
+        }
+    }
+
+  m_misses++;
+  double rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  // The epochs of moving nodes do not tell whether their position changed.
+  if (a->GetVelocity () == Vector () && b->GetVelocity () == Vector ())
+    {
+      if (slot == 0)
+        {
+          slot = &m_entries[h & mask];
+        }
+      slot->a = PeekPointer (a);
+      slot->b = PeekPointer (b);
+      slot->txPowerDbm = txPowerDbm;
+      slot->aEpoch = aEpoch;
+      slot->bEpoch = bEpoch;
+      slot->rxPowerDbm = rxPowerDbm;
+    }
+  else if (slot != 0 && slot->a == PeekPointer (a))
+    {
+      // Stale entry of a node which started moving
+      slot->a = 0;
+    }
+  return rxPowerDbm;
+}
+
+bool
+CachedPropagationLossModel::DoIsMonotonic (void) const
+{
+  return m_model != 0 && m_model->IsMonotonic ();
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+} // namespace ns3
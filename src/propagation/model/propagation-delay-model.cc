@@ -19,6 +19,7 @@
  */
 #include "propagation-delay-model.h"
 #include "ns3/mobility-model.h"
+#include "ns3/position-snapshot.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
@@ -47,6 +48,12 @@ PropagationDelayModel::AssignStreams (int64_t stream)
   return DoAssignStreams (stream);
 }
 
+Time
+PropagationDelayModel::GetMinimumDelay (double distance) const
+{
+  return Seconds (0);
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationDelayModel);
@@ -109,10 +116,15 @@ ConstantSpeedPropagationDelayModel::ConstantSpeedPropagationDelayModel ()
 Time
 ConstantSpeedPropagationDelayModel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  double distance = a->GetDistanceFrom (b);
+  double distance = PositionSnapshot::GetDistance (a, b);
   double seconds = distance / m_speed;
   return Seconds (seconds);
 }
+Time
+ConstantSpeedPropagationDelayModel::GetMinimumDelay (double distance) const
+{
+  return Seconds (distance / m_speed);
+}
 void
 ConstantSpeedPropagationDelayModel::SetSpeed (double speed)
 {
@@ -52,6 +52,15 @@ public:
    * source and destination.
    */
   virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const = 0;
+  /**
+   * \param distance the distance between source and destination (m)
+   * \returns a lower bound of the propagation delay between any two
+   *          nodes at least this far apart
+   *
+   * This is used to derive the lookahead of a parallel simulation.
+   * The default implementation returns zero, which is always safe.
+   */
+  virtual Time GetMinimumDelay (double distance) const;
   /**
    * If this delay model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -114,6 +123,7 @@ public:
    */
   ConstantSpeedPropagationDelayModel ();
   virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  virtual Time GetMinimumDelay (double distance) const;
   /**
    * \param speed the new speed (m/s)
    */
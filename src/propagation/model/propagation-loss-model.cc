@@ -24,16 +24,34 @@
 #include "propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/position-snapshot.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include <cmath>
+#include <limits>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
 
+/**
+ * \param a a position
+ * \param b another position
+ * \returns the distance between the positions, as CalculateDistance, but
+ * inlined so that the loops over many destinations may be vectorized
+ */
+static inline double
+GetDistance (const Vector &a, const Vector &b)
+{
+  double dx = b.x - a.x;
+  double dy = b.y - a.y;
+  double dz = b.z - a.z;
+  return std::sqrt (dx * dx + dy * dy + dz * dz);
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (PropagationLossModel);
@@ -82,6 +100,106 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPowers (double txPowerDbm,
+                                    Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel> > &b,
+                                    std::vector<double> &rxPowerDbm) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << a << b.size ());
+  rxPowerDbm.assign (b.size (), txPowerDbm);
+  if (b.empty ())
+    {
+      return;
+    }
+  Vector aPosition = PositionSnapshot::GetPosition (a);
+  m_positions.resize (b.size ());
+  for (std::size_t i = 0; i < b.size (); i++)
+    {
+      m_positions[i] = PositionSnapshot::GetPosition (b[i]);
+    }
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowers (rxPowerDbm, a, aPosition, b, m_positions);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                                      Ptr<MobilityModel> a,
+                                      const Vector &aPosition,
+                                      const std::vector<Ptr<MobilityModel> > &b,
+                                      const std::vector<Vector> &bPositions) const
+{
+  for (std::size_t i = 0; i < rxPowerDbm.size (); i++)
+    {
+      rxPowerDbm[i] = DoCalcRxPower (rxPowerDbm[i], a, b[i]);
+    }
+}
+
+double
+PropagationLossModel::GetMaxRange (double txPowerDbm, double rxThresholdDbm) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << rxThresholdDbm);
+  const double unbounded = std::numeric_limits<double>::infinity ();
+  if (!IsMonotonic ())
+    {
+      return unbounded;
+    }
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  // Find a distance out of range by doubling, then refine it by bisection.
+  double inRange = 0;
+  double outOfRange = 1;
+  b->SetPosition (Vector (outOfRange, 0, 0));
+  while (CalcRxPower (txPowerDbm, a, b) >= rxThresholdDbm)
+    {
+      inRange = outOfRange;
+      outOfRange *= 2;
+      if (outOfRange > 1e9)
+        {
+          return unbounded;
+        }
+      b->SetPosition (Vector (outOfRange, 0, 0));
+    }
+  while (outOfRange - inRange > 1e-3)
+    {
+      double distance = (inRange + outOfRange) / 2;
+      b->SetPosition (Vector (distance, 0, 0));
+      if (CalcRxPower (txPowerDbm, a, b) >= rxThresholdDbm)
+        {
+          inRange = distance;
+        }
+      else
+        {
+          outOfRange = distance;
+        }
+    }
+  NS_LOG_DEBUG ("range=" << outOfRange << "m for txPower=" << txPowerDbm <<
+                "dBm, threshold=" << rxThresholdDbm << "dBm");
+  return outOfRange;
+}
+
+bool
+PropagationLossModel::IsMonotonic (void) const
+{
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      if (!model->DoIsMonotonic ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+PropagationLossModel::DoIsMonotonic (void) const
+{
+  return false;
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -260,6 +378,12 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     {
       NS_LOG_WARN ("distance not within the far field region => inaccurate propagation loss value");
     }
+  return CalcRxPowerAtDistance (txPowerDbm, distance);
+}
+
+double
+FriisPropagationLossModel::CalcRxPowerAtDistance (double txPowerDbm, double distance) const
+{
   if (distance <= 0)
     {
       return txPowerDbm - m_minLoss;
@@ -271,12 +395,31 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - std::max (lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           const Vector &aPosition,
+                                           const std::vector<Ptr<MobilityModel> > &b,
+                                           const std::vector<Vector> &bPositions) const
+{
+  for (std::size_t i = 0; i < rxPowerDbm.size (); i++)
+    {
+      rxPowerDbm[i] = CalcRxPowerAtDistance (rxPowerDbm[i], GetDistance (aPosition, bPositions[i]));
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+FriisPropagationLossModel::DoIsMonotonic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -402,15 +545,21 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower (double txPowerDbm,
    * rx = tx + 10 log10 (-----------------------)
    *                      (d * d * d * d) * L
    */
-  double distance = a->GetDistanceFrom (b);
+  return CalcRxPowerAtPositions (txPowerDbm, a->GetPosition (), b->GetPosition ());
+}
+
+double
+TwoRayGroundPropagationLossModel::CalcRxPowerAtPositions (double txPowerDbm, const Vector &a, const Vector &b) const
+{
+  double distance = GetDistance (a, b);
   if (distance <= m_minDistance)
     {
       return txPowerDbm;
     }
 
   // Set the height of the Tx and Rx antennae
-  double txAntHeight = a->GetPosition ().z + m_heightAboveZ;
-  double rxAntHeight = b->GetPosition ().z + m_heightAboveZ;
+  double txAntHeight = a.z + m_heightAboveZ;
+  double rxAntHeight = b.z + m_heightAboveZ;
 
   // Calculate a crossover distance, under which we use Friis
   /*
@@ -445,6 +594,19 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+void
+TwoRayGroundPropagationLossModel::DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                                                  Ptr<MobilityModel> a,
+                                                  const Vector &aPosition,
+                                                  const std::vector<Ptr<MobilityModel> > &b,
+                                                  const std::vector<Vector> &bPositions) const
+{
+  for (std::size_t i = 0; i < rxPowerDbm.size (); i++)
+    {
+      rxPowerDbm[i] = CalcRxPowerAtPositions (rxPowerDbm[i], aPosition, bPositions[i]);
+    }
+}
+
 int64_t
 TwoRayGroundPropagationLossModel::DoAssignStreams (int64_t stream)
 {
@@ -508,7 +670,12 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                                 Ptr<MobilityModel> a,
                                                 Ptr<MobilityModel> b) const
 {
-  double distance = a->GetDistanceFrom (b);
+  return CalcRxPowerAtDistance (txPowerDbm, a->GetDistanceFrom (b));
+}
+
+double
+LogDistancePropagationLossModel::CalcRxPowerAtDistance (double txPowerDbm, double distance) const
+{
   if (distance <= m_referenceDistance)
     {
       return txPowerDbm - m_referenceLoss;
@@ -534,12 +701,31 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                                                 Ptr<MobilityModel> a,
+                                                 const Vector &aPosition,
+                                                 const std::vector<Ptr<MobilityModel> > &b,
+                                                 const std::vector<Vector> &bPositions) const
+{
+  for (std::size_t i = 0; i < rxPowerDbm.size (); i++)
+    {
+      rxPowerDbm[i] = CalcRxPowerAtDistance (rxPowerDbm[i], GetDistance (aPosition, bPositions[i]));
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+LogDistancePropagationLossModel::DoIsMonotonic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeLogDistancePropagationLossModel);
@@ -600,7 +786,12 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                                      Ptr<MobilityModel> a,
                                                      Ptr<MobilityModel> b) const
 {
-  double distance = a->GetDistanceFrom (b);
+  return CalcRxPowerAtDistance (txPowerDbm, a->GetDistanceFrom (b));
+}
+
+double
+ThreeLogDistancePropagationLossModel::CalcRxPowerAtDistance (double txPowerDbm, double distance) const
+{
   NS_ASSERT (distance >= 0);
 
   // See doxygen comments for the formula and explanation
@@ -636,12 +827,31 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                                                      Ptr<MobilityModel> a,
+                                                      const Vector &aPosition,
+                                                      const std::vector<Ptr<MobilityModel> > &b,
+                                                      const std::vector<Vector> &bPositions) const
+{
+  for (std::size_t i = 0; i < rxPowerDbm.size (); i++)
+    {
+      rxPowerDbm[i] = CalcRxPowerAtDistance (rxPowerDbm[i], GetDistance (aPosition, bPositions[i]));
+    }
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::DoIsMonotonic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (NakagamiPropagationLossModel);
@@ -930,6 +1140,12 @@ RangePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+RangePropagationLossModel::DoIsMonotonic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
@@ -27,7 +27,9 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/vector.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -93,6 +95,51 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power of a transmission at several destinations,
+   * taking into account all the PropagationLossModel(s) chained to the
+   * current one.
+   *
+   * This gives the same results as CalcRxPower called for each
+   * destination in turn, but reads each position only once, and lets
+   * the models depending only on the positions (Friis, TwoRayGround,
+   * LogDistance, ThreeLogDistance) evaluate all the destinations in a
+   * single loop rather than with a virtual call per destination and
+   * per model.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param rxPowerDbm the reception power at each destination (in dBm),
+   *        resized to the number of destinations
+   */
+  void CalcRxPowers (double txPowerDbm,
+                     Ptr<MobilityModel> a,
+                     const std::vector<Ptr<MobilityModel> > &b,
+                     std::vector<double> &rxPowerDbm) const;
+
+  /**
+   * Returns the distance beyond which the Rx Power, taking into account
+   * all the PropagationLossModel(s) chained to the current one, is
+   * always below a threshold.
+   *
+   * The range is only bounded if every model of the chain is
+   * deterministic and its loss depends only on, and never decreases
+   * with, the distance (see DoIsMonotonic); it is then found by
+   * bisection on CalcRxPower.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param rxThresholdDbm the smallest reception power of interest (in dBm)
+   * \returns the range (in meters), or infinity if it is not bounded
+   */
+  double GetMaxRange (double txPowerDbm, double rxThresholdDbm) const;
+
+  /**
+   * \returns true if every PropagationLossModel of the chain starting
+   * at this one is monotonic (see DoIsMonotonic)
+   */
+  bool IsMonotonic (void) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -134,6 +181,35 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Applies the loss of only this particular PropagationLossModel to
+   * the reception powers at several destinations.
+   *
+   * The default implementation calls DoCalcRxPower for each destination;
+   * subclasses which only need the positions may override it.
+   *
+   * \param rxPowerDbm the reception powers so far, updated in place (in dBm)
+   * \param a the mobility model of the source
+   * \param aPosition the position of the source
+   * \param b the mobility models of the destinations
+   * \param bPositions the positions of the destinations
+   */
+  virtual void DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                               Ptr<MobilityModel> a,
+                               const Vector &aPosition,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               const std::vector<Vector> &bPositions) const;
+
+  /**
+   * \returns true if this model is deterministic, its loss depends
+   * only on the distance between the source and the destination, and
+   * the reception power never increases with the distance.
+   *
+   * The default implementation returns false; subclasses for which
+   * this holds may override it, so that GetMaxRange is bounded.
+   */
+  virtual bool DoIsMonotonic (void) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
@@ -141,6 +217,7 @@ private:
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
 
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
+  mutable std::vector<Vector> m_positions; //!< Destination positions of the last CalcRxPowers
 };
 
 /**
@@ -321,7 +398,19 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                               Ptr<MobilityModel> a,
+                               const Vector &aPosition,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               const std::vector<Vector> &bPositions) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param distance the distance between the source and the destination (in m)
+   * \return the reception power after propagation loss (in dBm)
+   */
+  double CalcRxPowerAtDistance (double txPowerDbm, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsMonotonic (void) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -441,6 +530,18 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                               Ptr<MobilityModel> a,
+                               const Vector &aPosition,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               const std::vector<Vector> &bPositions) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the position of the source
+   * \param b the position of the destination
+   * \return the reception power after propagation loss (in dBm)
+   */
+  double CalcRxPowerAtPositions (double txPowerDbm, const Vector &a, const Vector &b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
   /**
@@ -529,7 +630,19 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                               Ptr<MobilityModel> a,
+                               const Vector &aPosition,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               const std::vector<Vector> &bPositions) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param distance the distance between the source and the destination (in m)
+   * \return the reception power after propagation loss (in dBm)
+   */
+  double CalcRxPowerAtDistance (double txPowerDbm, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsMonotonic (void) const;
 
   /**
    *  Creates a default reference loss model
@@ -612,7 +725,19 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (std::vector<double> &rxPowerDbm,
+                               Ptr<MobilityModel> a,
+                               const Vector &aPosition,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               const std::vector<Vector> &bPositions) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param distance the distance between the source and the destination (in m)
+   * \return the reception power after propagation loss (in dBm)
+   */
+  double CalcRxPowerAtDistance (double txPowerDbm, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsMonotonic (void) const;
 
   double m_distance0; //!< Beginning of the first (near) distance field
   double m_distance1; //!< Beginning of the second (middle) distance field.
@@ -852,6 +977,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsMonotonic (void) const;
 private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
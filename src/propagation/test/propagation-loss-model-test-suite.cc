@@ -21,9 +21,14 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/simulator.h"
+#include "ns3/object-factory.h"
 
 using namespace ns3;
 
@@ -436,6 +441,165 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class BatchPropagationLossModelTestCase : public TestCase
+{
+public:
+  BatchPropagationLossModelTestCase ();
+  virtual ~BatchPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a chain of loss models twice, and check that CalcRxPowers
+   * on the first gives the same results as CalcRxPower on the second.
+   * \param first the type of the first model
+   * \param second the type of the chained model, or an empty string
+   */
+  void CheckChain (std::string first, std::string second);
+  /**
+   * \param first the type of the first model
+   * \param second the type of the chained model, or an empty string
+   * \return the chain of models, with fixed random streams
+   */
+  Ptr<PropagationLossModel> CreateChain (std::string first, std::string second);
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase ()
+  : TestCase ("Check that PropagationLossModel::CalcRxPowers matches CalcRxPower")
+{
+}
+
+BatchPropagationLossModelTestCase::~BatchPropagationLossModelTestCase ()
+{
+}
+
+Ptr<PropagationLossModel>
+BatchPropagationLossModelTestCase::CreateChain (std::string first, std::string second)
+{
+  ObjectFactory factory (first);
+  Ptr<PropagationLossModel> model = factory.Create<PropagationLossModel> ();
+  if (!second.empty ())
+    {
+      factory.SetTypeId (second);
+      model->SetNext (factory.Create<PropagationLossModel> ());
+    }
+  model->AssignStreams (1);
+  return model;
+}
+
+void
+BatchPropagationLossModelTestCase::CheckChain (std::string first, std::string second)
+{
+  Ptr<PropagationLossModel> batch = CreateChain (first, second);
+  Ptr<PropagationLossModel> scalar = CreateChain (first, second);
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (3, -4, 1.5));
+  std::vector<Ptr<MobilityModel> > b;
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      // Distances from zero up to about 1 km, some of the receivers higher up.
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (3 + i * i * 0.6, -4 + i * 3.0, (i % 3) * 10.0));
+      b.push_back (mobility);
+    }
+
+  std::vector<double> rxPowerDbm;
+  batch->CalcRxPowers (16.0206, a, b, rxPowerDbm);
+  NS_TEST_ASSERT_MSG_EQ (rxPowerDbm.size (), b.size (), "Wrong number of results for " << first);
+  for (uint32_t i = 0; i < b.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (rxPowerDbm[i], scalar->CalcRxPower (16.0206, a, b[i]),
+                             "Different rx power for " << first << " " << second << " at destination " << i);
+    }
+
+  batch->CalcRxPowers (16.0206, a, std::vector<Ptr<MobilityModel> > (), rxPowerDbm);
+  NS_TEST_EXPECT_MSG_EQ (rxPowerDbm.size (), 0, "No destination, no result");
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun (void)
+{
+  CheckChain ("ns3::FriisPropagationLossModel", "");
+  CheckChain ("ns3::TwoRayGroundPropagationLossModel", "");
+  CheckChain ("ns3::LogDistancePropagationLossModel", "");
+  CheckChain ("ns3::ThreeLogDistancePropagationLossModel", "");
+  CheckChain ("ns3::RangePropagationLossModel", "");
+  CheckChain ("ns3::LogDistancePropagationLossModel", "ns3::NakagamiPropagationLossModel");
+  CheckChain ("ns3::RandomPropagationLossModel", "ns3::FriisPropagationLossModel");
+  Simulator::Destroy ();
+}
+
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+  virtual ~CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Check that CachedPropagationLossModel reuses results only while nodes stand still")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase ()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (100, 0, 0));
+
+  // A deterministic model gives the same results with and without the cache.
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel> ();
+  cached->SetModel (logDistance);
+  double expected = logDistance->CalcRxPower (16, a, b);
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (16, a, b), expected, "Wrong rx power on a miss");
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (16, a, b), expected, "Wrong rx power on a hit");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetHits (), 1, "The second computation should be a hit");
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (20, a, b), logDistance->CalcRxPower (20, a, b), "The tx power is part of the key");
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (16, b, a), logDistance->CalcRxPower (16, b, a), "The direction is part of the key");
+  b->SetPosition (Vector (200, 0, 0));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (16, a, b), logDistance->CalcRxPower (16, a, b), "Moving a node invalidates its entries");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetHits (), 1, "No hit after a course change");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetMisses (), 4, "Each new key is a miss");
+  NS_TEST_EXPECT_MSG_EQ (cached->IsMonotonic (), true, "The cache is as monotonic as its model");
+
+  // Random draws of the wrapped model show which results are reused.
+  Ptr<CachedPropagationLossModel> random = CreateObject<CachedPropagationLossModel> ();
+  Ptr<RandomPropagationLossModel> randomLoss = CreateObject<RandomPropagationLossModel> ();
+  randomLoss->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=10.0]"));
+  random->SetModel (randomLoss);
+  random->AssignStreams (1);
+  double first = random->CalcRxPower (16, a, b);
+  NS_TEST_EXPECT_MSG_EQ (random->CalcRxPower (16, a, b), first, "Static nodes should hit the cache");
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetVelocity (Vector (1, 0, 0));
+  first = random->CalcRxPower (16, a, moving);
+  NS_TEST_EXPECT_MSG_NE (random->CalcRxPower (16, a, moving), first, "Moving nodes should not be cached");
+  moving->SetVelocity (Vector (0, 0, 0));
+  first = random->CalcRxPower (16, a, moving);
+  NS_TEST_EXPECT_MSG_EQ (random->CalcRxPower (16, a, moving), first, "Stopped nodes should be cached");
+
+  // The table holds a single entry, which each new key replaces.
+  Ptr<CachedPropagationLossModel> small = CreateObject<CachedPropagationLossModel> ();
+  small->SetAttribute ("CacheSize", UintegerValue (1));
+  small->SetModel (logDistance);
+  NS_TEST_EXPECT_MSG_EQ (small->CalcRxPower (16, a, b), logDistance->CalcRxPower (16, a, b), "Wrong rx power with a small cache");
+  NS_TEST_EXPECT_MSG_EQ (small->CalcRxPower (16, b, a), logDistance->CalcRxPower (16, b, a), "Wrong rx power with a small cache");
+  NS_TEST_EXPECT_MSG_EQ (small->CalcRxPower (16, a, b), logDistance->CalcRxPower (16, a, b), "Wrong rx power with a small cache");
+  NS_TEST_EXPECT_MSG_EQ (small->GetMisses (), 3, "Entries should be replaced");
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +614,8 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new BatchPropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the wall clock time taken by MultiModelSpectrumChannel to
+ * deliver the signals of periodic waveform generators to spectrum
+ * analyzers scattered over a square area, without culling and with the
+ * given MaxInterferenceDistance.  The generators transmit on the 5 MHz
+ * Wi-Fi spectrum model and the analyzers listen on the 1 MHz ISM one,
+ * so every signal also goes through a PSD conversion.
+ *
+ * ./waf --run "multi-model-spectrum-channel-benchmark --nAnalyzers=1000 --distance=500"
+ */
+
+#include <iostream>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/system-wall-clock-ms.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumChannelBenchmark");
+
+/**
+ * Run the scenario once.
+ * \param nGenerators the number of waveform generators
+ * \param nAnalyzers the number of spectrum analyzers
+ * \param side the side of the area (m)
+ * \param maxDistance the MaxInterferenceDistance attribute (m)
+ * \param duration the simulated time
+ */
+static void
+RunScenario (uint32_t nGenerators, uint32_t nAnalyzers, double side, double maxDistance, Time duration)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer generatorNodes;
+  generatorNodes.Create (nGenerators);
+  NodeContainer analyzerNodes;
+  analyzerNodes.Create (nAnalyzers);
+  NodeContainer allNodes (generatorNodes, analyzerNodes);
+
+  std::ostringstream bound;
+  bound << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue (bound.str ()),
+                                 "Y", StringValue (bound.str ()));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (allNodes);
+
+  SpectrumChannelHelper channelHelper = SpectrumChannelHelper::Default ();
+  channelHelper.SetChannel ("ns3::MultiModelSpectrumChannel",
+                            "MaxInterferenceDistance", DoubleValue (maxDistance));
+  Ptr<SpectrumChannel> channel = channelHelper.Create ();
+
+  WifiSpectrumValue5MhzFactory factory;
+  WaveformGeneratorHelper waveformGeneratorHelper;
+  waveformGeneratorHelper.SetChannel (channel);
+  waveformGeneratorHelper.SetTxPowerSpectralDensity (factory.CreateTxPowerSpectralDensity (0.1, 6));
+  waveformGeneratorHelper.SetPhyAttribute ("Period", TimeValue (MilliSeconds (1)));
+  waveformGeneratorHelper.SetPhyAttribute ("DutyCycle", DoubleValue (0.5));
+  NetDeviceContainer generatorDevices = waveformGeneratorHelper.Install (generatorNodes);
+  Ptr<UniformRandomVariable> offset = CreateObject<UniformRandomVariable> ();
+  for (NetDeviceContainer::Iterator i = generatorDevices.Begin (); i != generatorDevices.End (); ++i)
+    {
+      Ptr<WaveformGenerator> generator = (*i)->GetObject<NonCommunicatingNetDevice> ()->GetPhy ()->GetObject<WaveformGenerator> ();
+      Simulator::Schedule (MicroSeconds (offset->GetInteger (0, 999)), &WaveformGenerator::Start, generator);
+    }
+
+  SpectrumAnalyzerHelper spectrumAnalyzerHelper;
+  spectrumAnalyzerHelper.SetChannel (channel);
+  spectrumAnalyzerHelper.SetRxSpectrumModel (SpectrumModelIsm2400MhzRes1Mhz);
+  spectrumAnalyzerHelper.SetPhyAttribute ("Resolution", TimeValue (MilliSeconds (100)));
+  spectrumAnalyzerHelper.Install (analyzerNodes);
+
+  Simulator::Stop (duration);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+  std::cout << "MaxInterferenceDistance " << maxDistance << " m: "
+            << Simulator::GetEventCount () << " events in "
+            << elapsed << " ms" << std::endl;
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nGenerators = 50;
+  uint32_t nAnalyzers = 500;
+  double side = 5000;
+  double distance = 500;
+  Time duration = MilliSeconds (20);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nGenerators", "Number of waveform generators", nGenerators);
+  cmd.AddValue ("nAnalyzers", "Number of spectrum analyzers", nAnalyzers);
+  cmd.AddValue ("side", "Side of the square area (m)", side);
+  cmd.AddValue ("distance", "MaxInterferenceDistance of the culling run (m)", distance);
+  cmd.AddValue ("duration", "Simulated time of each run", duration);
+  cmd.Parse (argc, argv);
+
+  RunScenario (nGenerators, nAnalyzers, side, 0, duration);
+  RunScenario (nGenerators, nAnalyzers, side, distance, duration);
+  return 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <tuple>
 #include <iostream>
 #include <utility>
 #include <ns3/object.h>
@@ -29,7 +30,9 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/nstime.h>
 #include <ns3/mobility-model.h>
+#include <ns3/position-snapshot.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-propagation-loss-model.h>
@@ -79,7 +82,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_maxInterferenceDistance (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +94,8 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_rxMobilities.clear ();
+  m_rxIndices.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +106,19 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("MaxInterferenceDistance",
+                   "The distance (m) beyond which receivers are not passed the signals "
+                   "of a transmitter, found with a spatial index of the receivers. "
+                   "Zero passes the signals to all the receivers.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxInterferenceDistance),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("IndexRefreshInterval",
+                   "The interval between two updates of the positions of all the receivers "
+                   "in the spatial index; receivers changing course are updated anyway.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&MultiModelSpectrumChannel::m_indexRefreshInterval),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -116,6 +134,9 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 
   SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
 
+  // the receivers are indexed again on the next transmission
+  m_rxIndices.clear ();
+
   // remove a previous entry of this phy if it exists
   // we need to scan for all rxSpectrumModel values since we don't
   // know which spectrum model the phy had when it was previously added
@@ -171,7 +192,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
     }
 }
 
-TxSpectrumModelInfoMap_t::const_iterator
+TxSpectrumModelInfoMap_t::iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel)
 {
   NS_LOG_FUNCTION (this << txSpectrumModel);
@@ -213,6 +234,81 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
   return txInfoIterator;
 }
 
+Ptr<SpectrumValue>
+MultiModelSpectrumChannel::ConvertTxPsd (TxSpectrumModelInfo &txInfo, SpectrumModelUid_t rxSpectrumModelUid,
+                                         Ptr<const SpectrumValue> txPsd)
+{
+  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfo.m_spectrumConverterMap.find (rxSpectrumModelUid);
+  if (rxConverterIterator == txInfo.m_spectrumConverterMap.end ())
+    {
+      // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+      return 0;
+    }
+  std::pair<Ptr<SpectrumValue>, Ptr<SpectrumValue> > &converted = txInfo.m_convertedPsdMap[rxSpectrumModelUid];
+  if (converted.first != 0
+      && std::equal (txPsd->ConstValuesBegin (), txPsd->ConstValuesEnd (), converted.first->ConstValuesBegin ()))
+    {
+      NS_LOG_LOGIC ("reusing the conversion of the previous txPowerSpectrum");
+      return converted.second;
+    }
+  converted.first = Copy<SpectrumValue> (txPsd);
+  converted.second = rxConverterIterator->second.Convert (txPsd);
+  return converted.second;
+}
+
+void
+MultiModelSpectrumChannel::FindCandidates (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator,
+                                           const Vector &txPosition, std::vector<std::size_t> &candidates)
+{
+  NS_LOG_FUNCTION (this << txPosition);
+  const std::vector<Ptr<SpectrumPhy> > &rxPhys = rxInfoIterator->second.m_rxPhys;
+  std::map<SpectrumModelUid_t, RxIndex>::iterator indexIterator = m_rxIndices.find (rxInfoIterator->first);
+  if (indexIterator == m_rxIndices.end ())
+    {
+      indexIterator = m_rxIndices.emplace (std::piecewise_construct,
+                                           std::forward_as_tuple (rxInfoIterator->first),
+                                           std::forward_as_tuple ()).first;
+      RxIndex &rxIndex = indexIterator->second;
+      rxIndex.index.SetCellSize (m_maxInterferenceDistance);
+      rxIndex.index.SetRefreshInterval (m_indexRefreshInterval);
+      for (std::size_t i = 0; i < rxPhys.size (); ++i)
+        {
+          Ptr<MobilityModel> mobility = rxPhys[i]->GetMobility ();
+          if (mobility)
+            {
+              rxIndex.index.Add (mobility);
+              rxIndex.indexed.push_back (i);
+            }
+          else
+            {
+              rxIndex.unindexed.push_back (i);
+            }
+        }
+    }
+  RxIndex &rxIndex = indexIterator->second;
+
+  rxIndex.index.Query (txPosition, m_maxInterferenceDistance, m_inRange);
+  candidates.clear ();
+  std::vector<std::size_t>::const_iterator unindexed = rxIndex.unindexed.begin ();
+  for (std::vector<uint32_t>::const_iterator i = m_inRange.begin (); i != m_inRange.end (); ++i)
+    {
+      std::size_t rxPhyIndex = rxIndex.indexed[*i];
+      Ptr<MobilityModel> mobility = rxPhys[rxPhyIndex]->GetMobility ();
+      if (CalculateDistance (txPosition, PositionSnapshot::GetPosition (mobility)) > m_maxInterferenceDistance)
+        {
+          continue;
+        }
+      // keep the order of m_rxPhys
+      for (; unindexed != rxIndex.unindexed.end () && *unindexed < rxPhyIndex; ++unindexed)
+        {
+          candidates.push_back (*unindexed);
+        }
+      candidates.push_back (rxPhyIndex);
+    }
+  candidates.insert (candidates.end (), unindexed, rxIndex.unindexed.cend ());
+  NS_LOG_LOGIC (candidates.size () << " of " << rxPhys.size () << " receivers within " << m_maxInterferenceDistance << " m");
+}
+
 void
 MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 {
@@ -228,7 +324,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("txSpectrumModelUid " << txSpectrumModelUid);
 
   //
-  TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
+  TxSpectrumModelInfoMap_t::iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
 
   NS_LOG_LOGIC ("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
@@ -251,19 +347,42 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       else
         {
           NS_LOG_LOGIC ("converting txPowerSpectrum SpectrumModelUids " << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
+          convertedTxPowerSpectrum = ConvertTxPsd (txInfoIteratorerator->second, rxSpectrumModelUid, txParams->psd);
+          if (convertedTxPowerSpectrum == 0)
             {
-              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
               continue;
             }
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
         }
 
-      for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhys.end ();
-           ++rxPhyIterator)
+      // Only visit the receivers in range, if enabled
+      const std::vector<Ptr<SpectrumPhy> > &rxPhys = rxInfoIterator->second.m_rxPhys;
+      bool culling = m_maxInterferenceDistance > 0 && txMobility;
+      if (culling)
+        {
+          FindCandidates (rxInfoIterator, PositionSnapshot::GetPosition (txMobility), m_candidates);
+        }
+      std::size_t nCandidates = culling ? m_candidates.size () : rxPhys.size ();
+
+      // Evaluate the propagation loss to all the receivers of this model at once
+      m_rxMobilities.clear ();
+      if (txMobility && m_propagationLoss)
+        {
+          for (std::size_t candidate = 0; candidate < nCandidates; ++candidate)
+            {
+              auto rxPhyIterator = rxPhys.begin () + (culling ? m_candidates[candidate] : candidate);
+              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+              if ((*rxPhyIterator) != txParams->txPhy && receiverMobility)
+                {
+                  m_rxMobilities.push_back (receiverMobility);
+                }
+            }
+          m_propagationLoss->CalcRxPowers (0, txMobility, m_rxMobilities, m_propagationGainsDb);
+        }
+      std::size_t rxMobilityIndex = 0;
+
+      for (std::size_t candidate = 0; candidate < nCandidates; ++candidate)
         {
+          auto rxPhyIterator = rxPhys.begin () + (culling ? m_candidates[candidate] : candidate);
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
@@ -299,7 +418,8 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                     }
                   if (m_propagationLoss)
                     {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+                      NS_ASSERT (m_rxMobilities[rxMobilityIndex] == receiverMobility);
+                      propagationGainDb = m_propagationGainsDb[rxMobilityIndex++];
                       NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
                       pathLossDb -= propagationGainDb;
                     }                    
@@ -27,8 +27,10 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/spatial-grid-index.h>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -55,6 +57,11 @@ public:
 
   Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
   SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  /**
+   * For each Rx SpectrumModel, the last Tx PSD which was converted to
+   * it, and the result of the conversion.
+   */
+  std::map<SpectrumModelUid_t, std::pair<Ptr<SpectrumValue>, Ptr<SpectrumValue> > > m_convertedPsdMap;
 };
 
 
@@ -102,6 +109,16 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * The conversion of a Tx PSD to each Rx SpectrumModel is kept, and
+ * reused by the next transmissions with the same PSD values.
+ *
+ * When the MaxInterferenceDistance attribute is set, the signals are
+ * only passed to the receivers within that distance of the transmitter,
+ * which are found with a SpatialGridIndex of the receivers instead of
+ * visiting all of them.  Receivers without a MobilityModel always get
+ * the signals.  This trades the accuracy of the weak interference
+ * for speed in large scenarios.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -139,7 +156,31 @@ private:
    *
    * \return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
    */
-  TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+  TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+
+  /**
+   * Convert a Tx PSD to a Rx SpectrumModel, or reuse the previous
+   * conversion of the same PSD values.
+   *
+   * \param txInfo the Tx SpectrumModel info
+   * \param rxSpectrumModelUid the Rx SpectrumModel
+   * \param txPsd the Tx PSD
+   * \return the converted PSD, or a null pointer if the models are orthogonal
+   */
+  Ptr<SpectrumValue> ConvertTxPsd (TxSpectrumModelInfo &txInfo, SpectrumModelUid_t rxSpectrumModelUid,
+                                   Ptr<const SpectrumValue> txPsd);
+
+  /**
+   * Find the receivers of a Rx SpectrumModel within
+   * MaxInterferenceDistance of a transmitter.
+   *
+   * \param rxInfoIterator the Rx SpectrumModel info
+   * \param txPosition the position of the transmitter
+   * \param candidates the indices of the receivers in m_rxPhys, in
+   *        increasing order
+   */
+  void FindCandidates (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator,
+                       const Vector &txPosition, std::vector<std::size_t> &candidates);
 
   /**
    * Used internally to reschedule transmission after the propagation delay.
@@ -169,6 +210,31 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * Mobility models of the receivers of the current transmission, for
+   * one RX spectrum model at a time.
+   */
+  std::vector<Ptr<MobilityModel> > m_rxMobilities;
+
+  /**
+   * Propagation gain to each of m_rxMobilities (dB).
+   */
+  std::vector<double> m_propagationGainsDb;
+
+  /** The receivers of a Rx SpectrumModel, indexed by position. */
+  struct RxIndex
+  {
+    SpatialGridIndex index;             //!< the receivers with a MobilityModel
+    std::vector<std::size_t> indexed;   //!< the position in m_rxPhys of each indexed receiver
+    std::vector<std::size_t> unindexed; //!< the position in m_rxPhys of the other receivers
+  };
+
+  double m_maxInterferenceDistance;                  //!< the maximum distance of a receiver, or zero
+  Time m_indexRefreshInterval;                       //!< the refresh interval of the indices
+  std::map<SpectrumModelUid_t, RxIndex> m_rxIndices; //!< the index of each Rx SpectrumModel, built on use
+  std::vector<std::size_t> m_candidates;             //!< the receivers to consider for the current transmission
+  std::vector<uint32_t> m_inRange;                   //!< the indexed receivers which may be in range
+
 };
 
 
@@ -142,6 +142,17 @@ SpectrumChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
   m_propagationDelay = delay;
 }
 
+Time
+SpectrumChannel::GetLookahead (double distance) const
+{
+  NS_LOG_FUNCTION (this << distance);
+  if (m_propagationDelay == 0)
+    {
+      return Seconds (0);
+    }
+  return m_propagationDelay->GetMinimumDelay (distance);
+}
+
 Ptr<SpectrumPropagationLossModel>
 SpectrumChannel::GetSpectrumPropagationLossModel (void)
 {
@@ -89,6 +89,16 @@ public:
    */
   void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
 
+  /**
+   * Get the smallest propagation delay between nodes at least a given
+   * distance apart, to be used as the lookahead of a parallel
+   * simulation (see MultithreadedSimulatorImpl).
+   *
+   * \param distance the distance threshold, in meters.
+   * \returns the lookahead; zero if there is no propagation delay model.
+   */
+  Time GetLookahead (double distance) const;
+
   /**
    * Get the frequency-dependent propagation loss model.
    * \returns a pointer to the propagation loss model.
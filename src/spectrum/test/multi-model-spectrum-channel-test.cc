@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/test.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumChannelTest");
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-test
+ *
+ * A SpectrumPhy recording the signals it receives.
+ */
+class RecordingSpectrumPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Constructor
+   * \param rxSpectrumModel the Rx SpectrumModel
+   */
+  RecordingSpectrumPhy (Ptr<const SpectrumModel> rxSpectrumModel)
+    : m_rxSpectrumModel (rxSpectrumModel)
+  {
+  }
+
+  // inherited from SpectrumPhy
+  void SetDevice (Ptr<NetDevice> d)
+  {
+  }
+  Ptr<NetDevice> GetDevice () const
+  {
+    return 0;
+  }
+  void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  Ptr<MobilityModel> GetMobility () const
+  {
+    return m_mobility;
+  }
+  void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return m_rxSpectrumModel;
+  }
+  Ptr<AntennaModel> GetRxAntenna () const
+  {
+    return 0;
+  }
+  void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    m_powers.push_back (Integral (*params->psd));
+  }
+
+  std::vector<double> m_powers; //!< the power of each received signal (W)
+
+private:
+  Ptr<MobilityModel> m_mobility;              //!< the mobility model
+  Ptr<const SpectrumModel> m_rxSpectrumModel; //!< the Rx SpectrumModel
+};
+
+/**
+ * Scale a PSD in place.
+ * \param psd the PSD
+ * \param factor the scaling factor
+ */
+static void
+ScalePsd (Ptr<SpectrumValue> psd, double factor)
+{
+  *psd *= factor;
+}
+
+/**
+ * \ingroup spectrum-test
+ *
+ * Check that MultiModelSpectrumChannel gives the same signals to the
+ * receivers within MaxInterferenceDistance as without culling, and
+ * none to the others, and that reusing the converted PSDs does not
+ * change the received powers.
+ */
+class MultiModelSpectrumChannelCullingTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelCullingTestCase ();
+  virtual ~MultiModelSpectrumChannelCullingTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Transmit three signals to a line of receivers.
+   * \param maxDistance the MaxInterferenceDistance attribute
+   * \return the receivers, the last one without mobility
+   */
+  std::vector<Ptr<RecordingSpectrumPhy> > RunScenario (double maxDistance);
+};
+
+MultiModelSpectrumChannelCullingTestCase::MultiModelSpectrumChannelCullingTestCase ()
+  : TestCase ("Check MultiModelSpectrumChannel culling and PSD conversion reuse")
+{
+}
+
+MultiModelSpectrumChannelCullingTestCase::~MultiModelSpectrumChannelCullingTestCase ()
+{
+}
+
+std::vector<Ptr<RecordingSpectrumPhy> >
+MultiModelSpectrumChannelCullingTestCase::RunScenario (double maxDistance)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("MaxInterferenceDistance", DoubleValue (maxDistance));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  WifiSpectrumValue5MhzFactory factory;
+  Ptr<SpectrumValue> psd = factory.CreateTxPowerSpectralDensity (0.1, 6);
+  Ptr<RecordingSpectrumPhy> txPhy = Create<RecordingSpectrumPhy> (psd->GetSpectrumModel ());
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (300, 10, 0));
+  txPhy->SetMobility (txMobility);
+  channel->AddRx (txPhy);
+
+  // Receivers every 50 m, half of them on another SpectrumModel.
+  std::vector<Ptr<RecordingSpectrumPhy> > rxPhys;
+  for (uint32_t i = 0; i < 21; i++)
+    {
+      Ptr<const SpectrumModel> model = psd->GetSpectrumModel ();
+      if (i % 2)
+        {
+          model = SpectrumModelIsm2400MhzRes1Mhz;
+        }
+      Ptr<RecordingSpectrumPhy> phy = Create<RecordingSpectrumPhy> (model);
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (50.0 * i, 0, 0));
+      phy->SetMobility (mobility);
+      channel->AddRx (phy);
+      rxPhys.push_back (phy);
+    }
+  Ptr<RecordingSpectrumPhy> noMobility = Create<RecordingSpectrumPhy> (SpectrumModelIsm2400MhzRes1Mhz);
+  channel->AddRx (noMobility);
+  rxPhys.push_back (noMobility);
+
+  // The same PSD twice, then a stronger one.
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+      params->duration = MilliSeconds (1);
+      params->txPhy = txPhy;
+      params->psd = psd;
+      Simulator::Schedule (MilliSeconds (10 * i), &MultiModelSpectrumChannel::StartTx, channel, params);
+      if (i == 1)
+        {
+          Simulator::Schedule (MilliSeconds (10 * i + 1), &ScalePsd, psd, 2.0);
+        }
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return rxPhys;
+}
+
+void
+MultiModelSpectrumChannelCullingTestCase::DoRun (void)
+{
+  std::vector<Ptr<RecordingSpectrumPhy> > expected = RunScenario (0);
+  std::vector<Ptr<RecordingSpectrumPhy> > culled = RunScenario (420);
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (expected[i]->m_powers.size (), 3, "Receiver " << i << " should get every signal without culling");
+      NS_TEST_EXPECT_MSG_EQ_TOL (expected[i]->m_powers[1], expected[i]->m_powers[0], 1e-6 * expected[i]->m_powers[0],
+                                 "Receiver " << i << " should get the same power from the same PSD");
+      NS_TEST_EXPECT_MSG_EQ_TOL (expected[i]->m_powers[2], 2 * expected[i]->m_powers[0], 1e-6 * expected[i]->m_powers[0],
+                                 "Receiver " << i << " should get twice the power from the stronger PSD");
+      // The transmitter is at (300, 10), i.e., the receivers from 0 m
+      // (at 300.2 m) to 700 m (at 400.1 m) are in range.
+      bool inRange = i == expected.size () - 1 || i * 50.0 <= 700;
+      if (inRange)
+        {
+          NS_TEST_ASSERT_MSG_EQ (culled[i]->m_powers.size (), 3, "Receiver " << i << " is within range");
+          for (uint32_t j = 0; j < 3; j++)
+            {
+              NS_TEST_EXPECT_MSG_EQ (culled[i]->m_powers[j], expected[i]->m_powers[j], "Receiver " << i << " should get the same power with culling");
+            }
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_EQ (culled[i]->m_powers.size (), 0, "Receiver " << i << " is out of range");
+        }
+    }
+}
+
+/**
+ * \ingroup spectrum-test
+ *
+ * MultiModelSpectrumChannel test suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelCullingTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite; ///< the test suite
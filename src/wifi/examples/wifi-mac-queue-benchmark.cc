@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the wall clock time taken by the WifiMacQueue operations used
+ * by block ack and aggregation, on a deep queue holding the QoS Data
+ * frames of many receivers, as for an ad-hoc node relaying to many
+ * neighbors.
+ *
+ * Every millisecond, a transmission opportunity is given to each
+ * receiver in turn: the frames queued for it are counted, up to
+ * nAggregate of them are peeked one after the other and dequeued, and
+ * as many new frames are enqueued for random receivers, one out of
+ * retryInterval of them at the front of the queue as a retransmission.
+ * Frames older than maxDelay expire.
+ *
+ * ./waf --run "wifi-mac-queue-benchmark --queueSize=4000 --nReceivers=100"
+ */
+
+#include <iostream>
+#include <vector>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/system-wall-clock-ms.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiMacQueueBenchmark");
+
+/// The benchmark state
+struct Benchmark
+{
+  Ptr<WifiMacQueue> queue;                //!< the queue
+  std::vector<Mac48Address> receivers;    //!< the receivers
+  Ptr<UniformRandomVariable> random;      //!< picks the receivers of new frames
+  uint32_t nAggregate;                    //!< the frames dequeued per receiver and round
+  uint32_t retryInterval;                 //!< one new frame out of this many is pushed at the front
+  uint64_t nEnqueued;                     //!< the number of frames enqueued
+  uint64_t nDequeued;                     //!< the number of frames dequeued
+  uint64_t nCounted;                      //!< the sum of the frame counts
+
+  /**
+   * Enqueue a frame for a random receiver.
+   */
+  void Enqueue (void)
+  {
+    WifiMacHeader header;
+    header.SetType (WIFI_MAC_QOSDATA);
+    header.SetQosTid (0);
+    header.SetAddr1 (receivers[random->GetInteger (0, receivers.size () - 1)]);
+    Ptr<WifiMacQueueItem> item = Create<WifiMacQueueItem> (Create<Packet> (100), header);
+    if (retryInterval != 0 && nEnqueued % retryInterval == 0)
+      {
+        queue->PushFront (item);
+      }
+    else
+      {
+        queue->Enqueue (item);
+      }
+    nEnqueued++;
+  }
+
+  /**
+   * Give a transmission opportunity to each receiver.
+   */
+  void Round (void)
+  {
+    for (std::vector<Mac48Address>::const_iterator r = receivers.begin (); r != receivers.end (); ++r)
+      {
+        nCounted += queue->GetNPacketsByTidAndAddress (0, *r);
+        std::vector<Ptr<const WifiMacQueueItem> > aggregate;
+        WifiMacQueue::ConstIterator it = queue->PeekByTidAndAddress (0, *r);
+        while (it != queue->end () && aggregate.size () < nAggregate)
+          {
+            aggregate.push_back (*it);
+            it++;
+            it = queue->PeekByTidAndAddress (0, *r, it);
+          }
+        for (std::vector<Ptr<const WifiMacQueueItem> >::const_iterator i = aggregate.begin (); i != aggregate.end (); ++i)
+          {
+            queue->DequeueIfQueued (*i);
+            nDequeued++;
+            Enqueue ();
+          }
+      }
+  }
+};
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t queueSize = 2000;
+  uint32_t nReceivers = 50;
+  uint32_t nAggregate = 4;
+  uint32_t retryInterval = 10;
+  uint32_t nRounds = 200;
+  Time maxDelay = MilliSeconds (100);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("queueSize", "Number of frames kept in the queue", queueSize);
+  cmd.AddValue ("nReceivers", "Number of receivers of the frames", nReceivers);
+  cmd.AddValue ("nAggregate", "Maximum number of frames dequeued per receiver and round", nAggregate);
+  cmd.AddValue ("retryInterval", "One new frame out of this many is pushed at the front (0 for none)", retryInterval);
+  cmd.AddValue ("nRounds", "Number of rounds, one per millisecond", nRounds);
+  cmd.AddValue ("maxDelay", "Lifetime of the frames in the queue", maxDelay);
+  cmd.Parse (argc, argv);
+
+  Benchmark benchmark;
+  benchmark.queue = CreateObject<WifiMacQueue> (AC_BE);
+  benchmark.queue->SetMaxSize (QueueSize (QueueSizeUnit::PACKETS, queueSize));
+  benchmark.queue->SetMaxDelay (maxDelay);
+  for (uint32_t i = 0; i < nReceivers; i++)
+    {
+      benchmark.receivers.push_back (Mac48Address::Allocate ());
+    }
+  benchmark.random = CreateObject<UniformRandomVariable> ();
+  benchmark.random->SetStream (1);
+  benchmark.nAggregate = nAggregate;
+  benchmark.retryInterval = retryInterval;
+  benchmark.nEnqueued = 0;
+  benchmark.nDequeued = 0;
+  benchmark.nCounted = 0;
+
+  for (uint32_t i = 0; i < queueSize; i++)
+    {
+      benchmark.Enqueue ();
+    }
+  for (uint32_t i = 0; i < nRounds; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &Benchmark::Round, &benchmark);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  std::cout << "queueSize=" << queueSize << " nReceivers=" << nReceivers
+            << " rounds=" << nRounds << " enqueued=" << benchmark.nEnqueued
+            << " dequeued=" << benchmark.nDequeued << " counted=" << benchmark.nCounted
+            << " expired/dropped=" << benchmark.nEnqueued - benchmark.nDequeued - benchmark.queue->GetNPackets ()
+            << " wallclock=" << elapsed << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
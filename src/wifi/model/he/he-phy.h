@@ -93,7 +93,7 @@ public:
                            const WifiTxVector& txVector,
                            Time ppduDuration) override;
   Ptr<const WifiPsdu> GetAddressedPsduInPpdu (Ptr<const WifiPpdu> ppdu) const override;
-  void StartReceivePreamble (Ptr<WifiPpdu> ppdu,
+  void StartReceivePreamble (Ptr<const WifiPpdu> ppdu,
                              RxPowerWattPerChannelBand& rxPowersW,
                              Time rxDuration) override;
   void CancelAllEvents (void) override;
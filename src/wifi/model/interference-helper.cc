@@ -304,8 +304,10 @@ InterferenceHelper::AppendEvent (Ptr<Event> event, bool isStartOfdmaRxing)
           m_firstPowerPerBand.find (band)->second = previousPowerStart;
         }
       auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event), niIt);
+      // Inserting the end may move the start, so keep track of its rank
+      auto firstIndex = first - niIt->second.begin ();
       auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event), niIt);
-      for (auto i = first; i != last; ++i)
+      for (auto i = niIt->second.begin () + firstIndex; i != last; ++i)
         {
           i->second.AddPower (it.second);
         }
@@ -367,22 +369,23 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesPerB
   double noiseInterferenceW = firstPower_it->second;
   auto niIt = m_niChangesPerBand.find (band);
   NS_ASSERT (niIt != m_niChangesPerBand.end ());
-  auto it = niIt->second.find (event->GetStartTime ());
+  auto start = Find (event->GetStartTime (), niIt);
+  auto it = start;
   for (; it != niIt->second.end () && it->first < Simulator::Now (); ++it)
     {
       noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW (band);
     }
-  it = niIt->second.find (event->GetStartTime ());
+  it = start;
   NS_ASSERT (it != niIt->second.end ());
   for (; it != niIt->second.end () && it->second.GetEvent () != event; ++it);
-  NiChanges ni;
-  ni.emplace (event->GetStartTime (), NiChange (0, event));
-  while (++it != niIt->second.end () && it->second.GetEvent () != event)
-    {
-      ni.insert (*it);
-    }
-  ni.emplace (event->GetEndTime (), NiChange (0, event));
-  nis->insert ({band, ni});
+  NS_ASSERT (it != niIt->second.end ());
+  auto end = it;
+  while (++end != niIt->second.end () && end->second.GetEvent () != event);
+  NiChanges &ni = nis->insert ({band, NiChanges ()}).first->second;
+  ni.reserve ((end - it) + 1);
+  ni.emplace_back (event->GetStartTime (), NiChange (0, event));
+  ni.insert (ni.end (), it + 1, end);
+  ni.emplace_back (event->GetEndTime (), NiChange (0, event));
   NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
   return noiseInterferenceW;
 }
@@ -422,7 +425,7 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, uint16_t channe
 {
   NS_LOG_FUNCTION (this << channelWidth << band.first << band.second << staId << window.first << window.second);
   double psr = 1.0; /* Packet Success Rate */
-  auto niIt = nis->find (band)->second;
+  const auto & niIt = nis->find (band)->second;
   auto j = niIt.begin ();
   Time previous = j->first;
   WifiMode payloadMode = event->GetTxVector ().GetMode (staId);
@@ -472,7 +475,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChan
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
   double psr = 1.0; /* Packet Success Rate */
-  auto niIt = nis->find (band)->second;
+  const auto & niIt = nis->find (band)->second;
   auto j = niIt.begin ();
 
   NS_ASSERT (!phyHeaderSections.empty ());
@@ -524,7 +527,7 @@ InterferenceHelper::CalculatePhyHeaderPer (Ptr<const Event> event, NiChangesPerB
                                            WifiPpduField header) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second << header);
-  auto niIt = nis->find (band)->second;
+  const auto & niIt = nis->find (band)->second;
   auto phyEntity = WifiPhy::GetStaticPhyEntity (event->GetTxVector ().GetModulationClass ());
 
   PhyEntity::PhyHeaderSections sections;
@@ -612,7 +615,27 @@ InterferenceHelper::EraseEvents (void)
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition (Time moment, NiChangesPerBand::iterator niIt)
 {
-  return niIt->second.upper_bound (moment);
+  return std::upper_bound (niIt->second.begin (), niIt->second.end (), moment,
+                           [] (Time t, const NiChanges::value_type &change) { return t < change.first; });
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::GetFirstPosition (Time moment, NiChangesPerBand::iterator niIt)
+{
+  return std::lower_bound (niIt->second.begin (), niIt->second.end (), moment,
+                           [] (const NiChanges::value_type &change, Time t) { return change.first < t; });
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::Find (Time moment, NiChangesPerBand::const_iterator niIt) const
+{
+  auto it = std::lower_bound (niIt->second.begin (), niIt->second.end (), moment,
+                              [] (const NiChanges::value_type &change, Time t) { return change.first < t; });
+  if (it != niIt->second.end () && it->first != moment)
+    {
+      return niIt->second.end ();
+    }
+  return it;
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -650,6 +673,29 @@ InterferenceHelper::NotifyRxEnd (Time endTime)
       auto it = GetPreviousPosition (endTime, niIt);
       it--;
       m_firstPowerPerBand.find (niIt->first)->second = it->second.GetPower ();
+      //The signals which did not end yet may still be looked up from their start
+      Time moment = std::min (endTime, Simulator::Now ());
+      for (auto i = GetNextPosition (Simulator::Now (), niIt); i != niIt->second.end (); ++i)
+        {
+          if (i->second.GetEvent ())
+            {
+              moment = std::min (moment, i->second.GetEvent ()->GetStartTime ());
+            }
+        }
+      PruneNiChanges (moment, niIt);
+    }
+}
+
+void
+InterferenceHelper::PruneNiChanges (Time moment, NiChangesPerBand::iterator niIt)
+{
+  //Keep the first zero power noise event, and the two last NiChanges before
+  //moment, which are looked up by GetPreviousPosition and NotifyRxEnd
+  auto last = GetFirstPosition (moment, niIt);
+  if (last - niIt->second.begin () > 3)
+    {
+      NS_LOG_DEBUG ("Prune " << (last - niIt->second.begin ()) - 3 << " NI changes before " << moment);
+      niIt->second.erase (niIt->second.begin () + 1, last - 2);
     }
 }
 
@@ -22,6 +22,7 @@
 #define INTERFERENCE_HELPER_H
 
 #include "phy-entity.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -348,9 +349,12 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChange
+   * NiChange entries sorted by time, entries at the same time being kept
+   * in insertion order.  Each entry holds the total NI power from its time
+   * on, i.e., the running sum of the power changes up to it, so that the
+   * power at any time is found with a binary search.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
 
   /**
    * Map of NiChanges per band
@@ -444,6 +448,14 @@ private:
    * \returns an iterator to the list of NiChanges
    */
   NiChanges::iterator GetPreviousPosition (Time moment, NiChangesPerBand::iterator niIt);
+  /**
+   * Returns an iterator to the first NiChange that is not earlier than moment
+   *
+   * \param moment time to check from
+   * \param niIt iterator of the band to check
+   * \returns an iterator to the list of NiChanges
+   */
+  NiChanges::iterator GetFirstPosition (Time moment, NiChangesPerBand::iterator niIt);
 
   /**
    * Add NiChange to the list at the appropriate position and
@@ -455,6 +467,23 @@ private:
    * \returns the iterator of the new event
    */
   NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change, NiChangesPerBand::iterator niIt);
+  /**
+   * Returns an iterator to the first NiChange at moment, if any
+   *
+   * \param moment time to look for
+   * \param niIt iterator of the band to check
+   * \returns an iterator to the list of NiChanges, or its end if there is no NiChange at moment
+   */
+  NiChanges::const_iterator Find (Time moment, NiChangesPerBand::const_iterator niIt) const;
+  /**
+   * Remove the NiChanges which can no longer be read, that is all but the
+   * first one and the two last ones before the given time, so that the
+   * list only grows with the signals overlapping the current one.
+   *
+   * \param moment the earliest time which may still be looked up
+   * \param niIt iterator of the band to prune
+   */
+  void PruneNiChanges (Time moment, NiChangesPerBand::iterator niIt);
 };
 
 } //namespace ns3
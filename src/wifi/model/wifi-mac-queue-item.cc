@@ -42,7 +42,9 @@ WifiMacQueueItem::WifiMacQueueItem (Ptr<const Packet> p, const WifiMacHeader & h
   : m_packet (p),
     m_header (header),
     m_tstamp (tstamp),
-    m_queueAc (AC_UNDEF)
+    m_queueAc (AC_UNDEF),
+    m_prevSameTid (nullptr),
+    m_nextSameTid (nullptr)
 {
   if (header.IsQosData () && header.IsQosAmsdu ())
     {
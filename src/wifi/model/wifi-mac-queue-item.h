@@ -29,6 +29,7 @@
 #include "amsdu-subframe-header.h"
 #include "qos-utils.h"
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -211,6 +212,9 @@ private:
   ConstIterator m_queueIt;                      //!< Queue iterator pointing to this MPDU, if queued
   AcIndex m_queueAc;                            //!< AC associated with the queue this MPDU is stored into
   bool m_inFlight;                              //!< whether the MPDU is in flight
+  WifiMacQueueItem *m_prevSameTid;              //!< previous QoS Data frame queued with the same receiver and TID, if queued
+  WifiMacQueueItem *m_nextSameTid;              //!< next QoS Data frame queued with the same receiver and TID, if queued
+  std::multimap<Time, WifiMacQueueItem *>::iterator m_expiryIt; //!< position in the expiry index of the queue, if queued
 };
 
 /**
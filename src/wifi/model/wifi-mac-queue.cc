@@ -71,8 +71,30 @@ WifiMacQueue::WifiMacQueue (AcIndex ac)
 WifiMacQueue::~WifiMacQueue ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_nQueuedPackets.clear ();
-  m_nQueuedBytes.clear ();
+  m_tidQueues.clear ();
+  m_expiry.clear ();
+}
+
+void
+WifiMacQueue::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_tidQueues.clear ();
+  m_expiry.clear ();
+  Queue<WifiMacQueueItem>::DoDispose ();
+}
+
+/**
+ * \param item a queue item
+ * \param tid a TID
+ * \param dest a receiver address
+ * \return true if the item is a QoS Data frame with the given TID and receiver
+ */
+static bool
+IsQosDataFor (const WifiMacQueueItem *item, uint8_t tid, Mac48Address dest)
+{
+  return item->GetHeader ().IsQosData () && item->GetHeader ().GetAddr1 () == dest
+         && item->GetHeader ().GetQosTid () == tid;
 }
 
 static std::list<Ptr<WifiMacQueueItem>> g_emptyWifiMacQueue; //!< empty Wi-Fi MAC queue
@@ -121,20 +143,16 @@ WifiMacQueue::Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item)
       return DoEnqueue (pos, item);
     }
 
-  // the queue is full; scan the list in the attempt to remove stale packets
-  ConstIterator it = begin ();
+  // the queue is full; attempt to remove the oldest stale packet
   const Time now = Simulator::Now ();
-  while (it != end ())
+  if (!m_expiry.empty ())
     {
-      if (it == pos && TtlExceeded (it, now))
-        {
-          return DoEnqueue (it, item);
-        }
+      ConstIterator it = m_expiry.begin ()->second->m_queueIt;
+      bool atPos = (it == pos);
       if (TtlExceeded (it, now))
         {
-          return DoEnqueue (pos, item);
+          return DoEnqueue (atPos ? it : pos, item);
         }
-      it++;
     }
 
   // the queue is still full, remove the oldest item if the policy is drop oldest
@@ -251,25 +269,55 @@ WifiMacQueue::PeekByTid (uint8_t tid, ConstIterator pos) const
   return end ();
 }
 
+const WifiMacQueueItem *
+WifiMacQueue::FindByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
+{
+  auto tidQueue = m_tidQueues.find (WifiAddressTidPair (dest, tid));
+  if (tidQueue == m_tidQueues.end () || tidQueue->second.head == nullptr)
+    {
+      return nullptr;
+    }
+  if (pos == EMPTY)
+    {
+      return tidQueue->second.head;
+    }
+  if (pos == end ())
+    {
+      return nullptr;
+    }
+  if (IsQosDataFor (PeekPointer (*pos), tid, dest))
+    {
+      return PeekPointer (*pos);
+    }
+  // Callers usually resume a search right after the previous match
+  if (pos != begin () && IsQosDataFor (PeekPointer (*std::prev (pos)), tid, dest))
+    {
+      return PeekPointer (*std::prev (pos))->m_nextSameTid;
+    }
+  for (ConstIterator it = pos; it != end (); it++)
+    {
+      if (IsQosDataFor (PeekPointer (*it), tid, dest))
+        {
+          return PeekPointer (*it);
+        }
+    }
+  return nullptr;
+}
+
 WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << +tid << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
   const Time now = Simulator::Now ();
-  while (it != end ())
+  for (const WifiMacQueueItem *item = FindByTidAndAddress (tid, dest, pos);
+       item != nullptr; item = item->m_nextSameTid)
     {
       // skip packets that stayed in the queue for too long. They will be
       // actually removed from the queue by the next call to a non-const method
-      if (now <= (*it)->GetTimeStamp () + m_maxDelay)
+      if (now <= item->GetTimeStamp () + m_maxDelay)
         {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return it;
-            }
+          return item->m_queueIt;
         }
-      it++;
     }
   NS_LOG_DEBUG ("The queue is empty");
   return end ();
@@ -400,22 +448,8 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  const Time now = Simulator::Now ();
-
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it, now))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
-    }
+  RemoveExpired (Simulator::Now ());
+  uint32_t nPackets = GetNPackets (tid, dest);
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
@@ -424,34 +458,16 @@ bool
 WifiMacQueue::IsEmpty (void)
 {
   NS_LOG_FUNCTION (this);
-  const Time now = Simulator::Now ();
-
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it, now))
-        {
-          NS_LOG_DEBUG ("returns false");
-          return false;
-        }
-    }
-  NS_LOG_DEBUG ("returns true");
-  return true;
+  RemoveExpired (Simulator::Now ());
+  NS_LOG_DEBUG ("returns " << QueueBase::IsEmpty ());
+  return QueueBase::IsEmpty ();
 }
 
 uint32_t
 WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
-  const Time now = Simulator::Now ();
-
-  // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it, now))
-        {
-          it++;
-        }
-    }
+  RemoveExpired (Simulator::Now ());
   return QueueBase::GetNPackets ();
 }
 
@@ -459,65 +475,168 @@ uint32_t
 WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
-  const Time now = Simulator::Now ();
-
-  // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it, now))
-        {
-          it++;
-        }
-    }
+  RemoveExpired (Simulator::Now ());
   return QueueBase::GetNBytes ();
 }
 
 uint32_t
 WifiMacQueue::GetNPackets (uint8_t tid, Mac48Address dest) const
 {
-  WifiAddressTidPair addressTidPair (dest, tid);
-  auto it = m_nQueuedPackets.find (addressTidPair);
-  if (it == m_nQueuedPackets.end ())
+  auto it = m_tidQueues.find (WifiAddressTidPair (dest, tid));
+  if (it == m_tidQueues.end ())
     {
       return 0;
     }
-  return m_nQueuedPackets.at (addressTidPair);
+  return it->second.nPackets;
 }
 
 uint32_t
 WifiMacQueue::GetNBytes (uint8_t tid, Mac48Address dest) const
 {
-  WifiAddressTidPair addressTidPair (dest, tid);
-  auto it = m_nQueuedBytes.find (addressTidPair);
-  if (it == m_nQueuedBytes.end ())
+  auto it = m_tidQueues.find (WifiAddressTidPair (dest, tid));
+  if (it == m_tidQueues.end ())
     {
       return 0;
     }
-  return m_nQueuedBytes.at (addressTidPair);
+  return it->second.nBytes;
 }
 
-bool
-WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+void
+WifiMacQueue::RemoveExpired (const Time& now)
 {
-  Iterator ret;
-  if (Queue<WifiMacQueueItem>::DoEnqueue (pos, item, ret))
+  NS_LOG_FUNCTION (this << now);
+  while (!m_expiry.empty ())
+    {
+      ConstIterator it = m_expiry.begin ()->second->m_queueIt;
+      if (!TtlExceeded (it, now))
+        {
+          break;
+        }
+    }
+}
+
+WifiMacQueue::TidQueue *
+WifiMacQueue::GetTidQueue (const WifiMacQueueItem *item)
+{
+  if (!item->GetHeader ().IsQosData ())
+    {
+      return nullptr;
+    }
+  return &m_tidQueues[WifiAddressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ())];
+}
+
+void
+WifiMacQueue::AddToIndex (ConstIterator it)
+{
+  WifiMacQueueItem *item = PeekPointer (*it);
+  item->m_expiryIt = m_expiry.emplace (item->GetTimeStamp (), item);
+
+  TidQueue *tidQueue = GetTidQueue (item);
+  if (tidQueue == nullptr)
     {
-      // update statistics about queued packets
-      if (item->GetHeader ().IsQosData ())
+      return;
+    }
+  tidQueue->nPackets++;
+  tidQueue->nBytes += item->GetSize ();
+
+  // find the frame of the sublist which follows the item in the queue
+  uint8_t tid = item->GetHeader ().GetQosTid ();
+  Mac48Address dest = item->GetHeader ().GetAddr1 ();
+  WifiMacQueueItem *next = nullptr;
+  if (it == begin ())
+    {
+      next = tidQueue->head;
+    }
+  else if (std::next (it) != end ())
+    {
+      WifiMacQueueItem *prev = PeekPointer (*std::prev (it));
+      if (IsQosDataFor (prev, tid, dest))
         {
-          WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-          auto it = m_nQueuedPackets.find (addressTidPair);
-          if (it == m_nQueuedPackets.end ())
+          next = prev->m_nextSameTid;
+        }
+      else
+        {
+          for (ConstIterator i = std::next (it); i != end (); i++)
             {
-              m_nQueuedPackets[addressTidPair] = 0;
-              m_nQueuedBytes[addressTidPair] = 0;
+              if (IsQosDataFor (PeekPointer (*i), tid, dest))
+                {
+                  next = PeekPointer (*i);
+                  break;
+                }
             }
-          m_nQueuedPackets[addressTidPair]++;
-          m_nQueuedBytes[addressTidPair] += item->GetSize ();
         }
+    }
+
+  // link the item before it
+  item->m_nextSameTid = next;
+  item->m_prevSameTid = (next != nullptr ? next->m_prevSameTid : tidQueue->tail);
+  if (item->m_prevSameTid != nullptr)
+    {
+      item->m_prevSameTid->m_nextSameTid = item;
+    }
+  else
+    {
+      tidQueue->head = item;
+    }
+  if (next != nullptr)
+    {
+      next->m_prevSameTid = item;
+    }
+  else
+    {
+      tidQueue->tail = item;
+    }
+}
+
+void
+WifiMacQueue::RemoveFromIndex (WifiMacQueueItem *item)
+{
+  m_expiry.erase (item->m_expiryIt);
+
+  TidQueue *tidQueue = GetTidQueue (item);
+  if (tidQueue == nullptr)
+    {
+      return;
+    }
+  NS_ASSERT (tidQueue->nPackets >= 1);
+  NS_ASSERT (tidQueue->nBytes >= item->GetSize ());
+  tidQueue->nPackets--;
+  tidQueue->nBytes -= item->GetSize ();
+
+  if (item->m_prevSameTid != nullptr)
+    {
+      item->m_prevSameTid->m_nextSameTid = item->m_nextSameTid;
+    }
+  else
+    {
+      NS_ASSERT (tidQueue->head == item);
+      tidQueue->head = item->m_nextSameTid;
+    }
+  if (item->m_nextSameTid != nullptr)
+    {
+      item->m_nextSameTid->m_prevSameTid = item->m_prevSameTid;
+    }
+  else
+    {
+      NS_ASSERT (tidQueue->tail == item);
+      tidQueue->tail = item->m_prevSameTid;
+    }
+  item->m_prevSameTid = nullptr;
+  item->m_nextSameTid = nullptr;
+}
+
+bool
+WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  Iterator ret;
+  if (Queue<WifiMacQueueItem>::DoEnqueue (pos, item, ret))
+    {
       // set item's information about its position in the queue
       item->m_queueAc = m_ac;
       item->m_queueIt = ret;
+      // update the sublists, the expiry index and the statistics about
+      // queued packets
+      AddToIndex (ret);
       return true;
     }
   return false;
@@ -534,19 +653,9 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
       return nullptr;
     }
 
+  RemoveFromIndex (PeekPointer (*pos));
   Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoDequeue (pos);
 
-  if (item != 0 && item->GetHeader ().IsQosData ())
-    {
-      WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-      NS_ASSERT (m_nQueuedPackets.find (addressTidPair) != m_nQueuedPackets.end ());
-      NS_ASSERT (m_nQueuedPackets[addressTidPair] >= 1);
-      NS_ASSERT (m_nQueuedBytes[addressTidPair] >= item->GetSize ());
-
-      m_nQueuedPackets[addressTidPair]--;
-      m_nQueuedBytes[addressTidPair] -= item->GetSize ();
-    }
-
   if (item != 0)
     {
       NS_ASSERT (item->IsQueued ());
@@ -559,19 +668,9 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
 Ptr<WifiMacQueueItem>
 WifiMacQueue::DoRemove (ConstIterator pos)
 {
+  RemoveFromIndex (PeekPointer (*pos));
   Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoRemove (pos);
 
-  if (item != 0 && item->GetHeader ().IsQosData ())
-    {
-      WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-      NS_ASSERT (m_nQueuedPackets.find (addressTidPair) != m_nQueuedPackets.end ());
-      NS_ASSERT (m_nQueuedPackets[addressTidPair] >= 1);
-      NS_ASSERT (m_nQueuedBytes[addressTidPair] >= item->GetSize ());
-
-      m_nQueuedPackets[addressTidPair]--;
-      m_nQueuedBytes[addressTidPair] -= item->GetSize ();
-    }
-
   if (item != 0)
     {
       NS_ASSERT (item->IsQueued ());
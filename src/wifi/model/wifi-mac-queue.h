@@ -27,6 +27,7 @@
 #include "wifi-mac-queue-item.h"
 #include "ns3/queue.h"
 #include <unordered_map>
+#include <map>
 #include "qos-utils.h"
 
 namespace ns3 {
@@ -55,6 +56,12 @@ extern template class Queue<WifiMacQueueItem>;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * Besides the list of all the queued items, the QoS Data frames of each
+ * (receiver, TID) pair are linked in a sublist through the items
+ * themselves, and all the items are indexed by timestamp. Searches by
+ * receiver and TID thus only visit the frames of that pair, and expired
+ * items are found without scanning the queue.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -228,8 +235,9 @@ public:
   uint32_t GetNPacketsByAddress (Mac48Address dest);
   /**
    * Return the number of QoS packets having TID equal to <i>tid</i> and
-   * destination address equal to <i>dest</i>.  The complexity is linear in
-   * the size of the queue.
+   * destination address equal to <i>dest</i>, after removing the expired
+   * packets.  The complexity is constant in the average case, plus
+   * logarithmic in the size of the queue per expired packet.
    *
    * \param tid the given TID
    * \param dest the given destination
@@ -284,6 +292,13 @@ public:
    */
   uint32_t GetNBytes (void);
 
+  /**
+   * Remove all the items which have been in the queue for too long.
+   *
+   * \param now a copy of Simulator::Now()
+   */
+  void RemoveExpired (const Time& now);
+
   /**
    * Remove the item pointed to by the iterator <i>it</i> if it has been in the
    * queue for too long. If the item is removed, the iterator is updated to
@@ -298,7 +313,50 @@ public:
   static const ConstIterator EMPTY;         //!< Invalid iterator to signal an empty queue
 
 
+protected:
+  void DoDispose (void) override;
+
 private:
+  /// The QoS Data frames queued for a (receiver, TID) pair, in queue order
+  struct TidQueue
+  {
+    WifiMacQueueItem *head;  //!< the first frame
+    WifiMacQueueItem *tail;  //!< the last frame
+    uint32_t nPackets;       //!< the number of frames
+    uint32_t nBytes;         //!< the number of bytes
+  };
+
+  /**
+   * \param item a queued item
+   * \return the (receiver, TID) sublist of the item, if it is a QoS Data frame
+   */
+  TidQueue * GetTidQueue (const WifiMacQueueItem *item);
+  /**
+   * Return the first QoS Data frame having the receiver address equal to
+   * <i>dest</i> and TID equal to <i>tid</i>, starting from the given
+   * position in the queue.
+   *
+   * \param tid the given TID
+   * \param dest the given destination
+   * \param pos the position the search starts from, or EMPTY
+   * \return the frame, or a null pointer
+   */
+  const WifiMacQueueItem * FindByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const;
+  /**
+   * Add a newly queued item to the (receiver, TID) sublist and the
+   * expiry index.
+   *
+   * \param it the position of the item in the queue
+   */
+  void AddToIndex (ConstIterator it);
+  /**
+   * Remove an item about to leave the queue from the (receiver, TID)
+   * sublist and the expiry index.
+   *
+   * \param item the item
+   */
+  void RemoveFromIndex (WifiMacQueueItem *item);
+
   /**
    * Wrapper for the DoEnqueue method provided by the base class that additionally
    * sets the iterator field of the item and updates internal statistics, if
@@ -332,10 +390,10 @@ private:
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
   AcIndex m_ac;                             //!< the access category
 
-  /// Per (MAC address, TID) pair queued packets
-  std::unordered_map<WifiAddressTidPair, uint32_t, WifiAddressTidHash> m_nQueuedPackets;
-  /// Per (MAC address, TID) pair queued bytes
-  std::unordered_map<WifiAddressTidPair, uint32_t, WifiAddressTidHash> m_nQueuedBytes;
+  /// Per (MAC address, TID) pair queued QoS Data frames
+  std::unordered_map<WifiAddressTidPair, TidQueue, WifiAddressTidHash> m_tidQueues;
+  /// The queued items by timestamp
+  std::multimap<Time, WifiMacQueueItem *> m_expiry;
 
   /// Traced callback: fired when a packet is dropped due to lifetime expiration
   TracedCallback<Ptr<const WifiMacQueueItem> > m_traceExpired;
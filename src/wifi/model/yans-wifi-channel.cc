@@ -21,6 +21,8 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
@@ -31,6 +33,9 @@
 #include "wifi-utils.h"
 #include "wifi-ppdu.h"
 #include "wifi-psdu.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ns3 {
 
@@ -53,11 +58,33 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("EnableRangeCulling",
+                   "If true, only the PHYs which may be in range of the sender "
+                   "are visited when sending, found with a spatial index.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_rangeCulling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxRange",
+                   "The range (m) beyond which PHYs are culled when EnableRangeCulling "
+                   "is set.  If zero, it is derived from the propagation loss model "
+                   "and from the RX sensitivity of the PHYs, when possible.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("IndexRefreshInterval",
+                   "The interval between two refreshes of all the positions of the "
+                   "spatial index used by EnableRangeCulling.  Positions are also "
+                   "updated on course changes, so this only matters for mobility "
+                   "models changing velocity without notifying it.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&YansWifiChannel::m_indexRefreshInterval),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_rxThresholdDbm (std::numeric_limits<double>::infinity ())
 {
   NS_LOG_FUNCTION (this);
 }
@@ -68,6 +95,15 @@ YansWifiChannel::~YansWifiChannel ()
   m_phyList.clear ();
 }
 
+void
+YansWifiChannel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_index.Clear ();
+  m_ranges.clear ();
+  Channel::DoDispose ();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel (const Ptr<PropagationLossModel> loss)
 {
@@ -82,48 +118,121 @@ YansWifiChannel::SetPropagationDelayModel (const Ptr<PropagationDelayModel> dela
   m_delay = delay;
 }
 
+Time
+YansWifiChannel::GetLookahead (double distance) const
+{
+  NS_LOG_FUNCTION (this << distance);
+  if (m_delay == 0)
+    {
+      return Seconds (0);
+    }
+  return m_delay->GetMinimumDelay (distance);
+}
+
+void
+YansWifiChannel::UpdateIndex (void) const
+{
+  if (m_index.GetN () == m_phyList.size ())
+    {
+      return;
+    }
+  m_index.SetRefreshInterval (m_indexRefreshInterval);
+  for (std::size_t i = m_index.GetN (); i < m_phyList.size (); i++)
+    {
+      Ptr<YansWifiPhy> phy = m_phyList[i];
+      m_index.Add (phy->GetMobility ());
+      m_rxThresholdDbm = std::min (m_rxThresholdDbm, phy->GetRxSensitivity () - phy->GetRxGain ());
+    }
+  m_ranges.clear ();
+}
+
+double
+YansWifiChannel::GetCullingRange (double txPowerDbm) const
+{
+  UpdateIndex ();
+  double range = m_maxRange;
+  if (range == 0)
+    {
+      std::map<double, double>::const_iterator it = m_ranges.find (txPowerDbm);
+      if (it == m_ranges.end ())
+        {
+          range = m_loss->GetMaxRange (txPowerDbm, m_rxThresholdDbm);
+          NS_LOG_DEBUG ("culling range for txPower=" << txPowerDbm << "dbm: " << range << "m");
+          it = m_ranges.insert (std::make_pair (txPowerDbm, range)).first;
+        }
+      range = it->second;
+    }
+  if (m_index.GetCellSize () == 0 && !std::isinf (range))
+    {
+      m_index.SetCellSize (std::max (range, 1.0));
+    }
+  return range;
+}
+
 void
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const
 {
   NS_LOG_FUNCTION (this << sender << ppdu << txPowerDbm);
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  bool culling = false;
+  if (m_rangeCulling && m_loss != 0)
     {
-      if (sender != (*i))
+      double range = GetCullingRange (txPowerDbm);
+      if (!std::isinf (range))
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<WifiPpdu> copy = ppdu->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
-            {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-            }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm);
+          m_index.Query (senderMobility->GetPosition (), range, m_candidates);
+          culling = true;
         }
     }
+  std::size_t nCandidates = culling ? m_candidates.size () : m_phyList.size ();
+  m_receivers.clear ();
+  m_receiverMobilities.clear ();
+  for (std::size_t k = 0; k < nCandidates; k++)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[culling ? m_candidates[k] : k];
+      //For now don't account for inter channel interference nor channel bonding
+      if (sender != receiver && receiver->GetChannelNumber () == sender->GetChannelNumber ())
+        {
+          m_receivers.push_back (receiver);
+          m_receiverMobilities.push_back (receiver->GetMobility ());
+        }
+    }
+  if (m_receivers.empty ())
+    {
+      return;
+    }
+  m_loss->CalcRxPowers (txPowerDbm, senderMobility, m_receiverMobilities, m_rxPowersDbm);
+
+  for (std::size_t k = 0; k < m_receivers.size (); k++)
+    {
+      Ptr<MobilityModel> receiverMobility = m_receiverMobilities[k];
+      Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+      double rxPowerDbm = m_rxPowersDbm[k];
+      NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                    "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+      Ptr<NetDevice> dstNetDevice = m_receivers[k]->GetDevice ();
+      uint32_t dstNode;
+      if (dstNetDevice == 0)
+        {
+          dstNode = 0xffffffff;
+        }
+      else
+        {
+          dstNode = dstNetDevice->GetNode ()->GetId ();
+        }
+
+      Simulator::ScheduleWithContext (dstNode,
+                                      delay, &YansWifiChannel::Receive,
+                                      m_receivers[k], ppdu, rxPowerDbm);
+    }
+  // Do not hold references to the receivers until the next transmission.
+  m_receivers.clear ();
+  m_receiverMobilities.clear ();
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
 {
   NS_LOG_FUNCTION (phy << ppdu << rxPowerDbm);
   // Do no further processing if signal is too weak
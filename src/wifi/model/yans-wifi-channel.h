@@ -22,15 +22,18 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/spatial-grid-index.h"
+#include <map>
 
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
 class Packet;
-class Time;
 class WifiPpdu;
 
 /**
@@ -41,6 +44,17 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * With the EnableRangeCulling attribute, Send only visits the PHYs which
+ * may be within the range of the sender, found with a SpatialGridIndex of
+ * their mobility models.  The range is the MaxRange attribute if set, or
+ * else the distance at which the propagation loss model brings the TX
+ * power below the smallest RX sensitivity (minus RX gain) of the PHYs,
+ * if the loss model can bound it (see PropagationLossModel::GetMaxRange).
+ * Since such signals are dropped on reception anyway, culling does not
+ * change the results.  The RX sensitivities and gains are read when PHYs
+ * are added, so changing them later during the simulation requires
+ * setting MaxRange explicitly.
  */
 class YansWifiChannel : public Channel
 {
@@ -72,6 +86,15 @@ public:
    * \param delay the new propagation delay model.
    */
   void SetPropagationDelayModel (const Ptr<PropagationDelayModel> delay);
+  /**
+   * Get the smallest propagation delay between PHYs at least a given
+   * distance apart, to be used as the lookahead of a parallel
+   * simulation (see MultithreadedSimulatorImpl).
+   *
+   * \param distance the distance threshold, in meters
+   * \return the lookahead; zero if there is no propagation delay model
+   */
+  Time GetLookahead (double distance) const;
 
   /**
    * \param sender the PHY object from which the packet is originating.
@@ -108,15 +131,44 @@ private:
    * The method then calls the corresponding YansWifiPhy that the first
    * bit of the PPDU has arrived.
    *
+   * All the receivers share the PPDU sent, which is immutable once
+   * transmitted; the packets it carries are copied (on write) by the
+   * PHY when the PSDU is handed up.
+   *
    * \param receiver the device to which the packet is destined
    * \param ppdu the PPDU being sent
    * \param txPowerDbm the TX power associated to the packet being sent (dBm)
    */
-  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
+
+  void DoDispose (void) override;
+
+  /**
+   * Get the range beyond which no PHY can receive a transmission.
+   *
+   * \param txPowerDbm the TX power (dBm)
+   * \return the range (m), or infinity if it can not be bounded
+   */
+  double GetCullingRange (double txPowerDbm) const;
+  /**
+   * Add the PHYs connected since the last call to the spatial index.
+   */
+  void UpdateIndex (void) const;
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+
+  bool m_rangeCulling;                 //!< Whether only the PHYs in range are visited
+  double m_maxRange;                   //!< Culling range set by the user (m), zero if derived
+  Time m_indexRefreshInterval;         //!< Interval between two refreshes of the spatial index
+  mutable SpatialGridIndex m_index;    //!< Mobility models of the PHYs, with the same indices
+  mutable double m_rxThresholdDbm;     //!< Smallest RX sensitivity minus RX gain of the PHYs (dBm)
+  mutable std::map<double, double> m_ranges; //!< Culling range for each TX power seen (m)
+  mutable std::vector<uint32_t> m_candidates; //!< PHYs in range of the current transmission
+  mutable std::vector<Ptr<YansWifiPhy> > m_receivers; //!< Receivers of the current transmission
+  mutable std::vector<Ptr<MobilityModel> > m_receiverMobilities; //!< Mobility models of the receivers
+  mutable std::vector<double> m_rxPowersDbm; //!< RX power at each receiver (dBm)
 };
 
 } //namespace ns3
@@ -107,6 +107,162 @@ WifiMacQueueDropOldestTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the lookups by receiver and TID.
+ *
+ * This test checks that the frames returned by PeekByTidAndAddress and
+ * counted by GetNPacketsByTidAndAddress are the ones found by scanning the
+ * queue, after frames of several receivers and TIDs are enqueued, pushed
+ * at the front, inserted, dequeued and expired.
+ */
+class WifiMacQueueTidAddressTest : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  WifiMacQueueTidAddressTest ();
+
+  void DoRun () override;
+
+private:
+  /**
+   * Create a QoS Data frame.
+   * \param tid the TID
+   * \param dest the receiver
+   * \return the frame
+   */
+  Ptr<WifiMacQueueItem> CreateItem (uint8_t tid, Mac48Address dest);
+  /**
+   * Check the lookups of every receiver and TID against a scan of the queue.
+   */
+  void CheckLookups ();
+  /**
+   * Enqueue frames after the first ones.
+   */
+  void EnqueueLater ();
+  /**
+   * Check that only the frames enqueued later are left.
+   */
+  void CheckExpired ();
+
+  Ptr<WifiMacQueue> m_queue;              ///< the queue
+  std::vector<Mac48Address> m_receivers;  ///< the receivers
+};
+
+WifiMacQueueTidAddressTest::WifiMacQueueTidAddressTest ()
+  : TestCase ("Test the lookups by receiver and TID")
+{
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueueTidAddressTest::CreateItem (uint8_t tid, Mac48Address dest)
+{
+  WifiMacHeader header;
+  header.SetType (WIFI_MAC_QOSDATA);
+  header.SetQosTid (tid);
+  header.SetAddr1 (dest);
+  return Create<WifiMacQueueItem> (Create<Packet> (10 + tid), header);
+}
+
+void
+WifiMacQueueTidAddressTest::CheckLookups ()
+{
+  for (uint8_t tid = 0; tid < 2; tid++)
+    {
+      for (const auto& dest : m_receivers)
+        {
+          std::vector<Ptr<const WifiMacQueueItem>> expected;
+          for (auto it = m_queue->begin (); it != m_queue->end (); it++)
+            {
+              if ((*it)->GetHeader ().IsQosData () && (*it)->GetHeader ().GetAddr1 () == dest
+                  && (*it)->GetHeader ().GetQosTid () == tid)
+                {
+                  expected.push_back (*it);
+                }
+            }
+          NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (tid, dest), expected.size (),
+                                 "Unexpected number of frames for " << dest << " TID " << +tid);
+          std::size_t i = 0;
+          for (auto it = m_queue->PeekByTidAndAddress (tid, dest); it != m_queue->end ();
+               it = m_queue->PeekByTidAndAddress (tid, dest, ++it), i++)
+            {
+              NS_TEST_ASSERT_MSG_LT (i, expected.size (), "Too many frames for " << dest << " TID " << +tid);
+              NS_TEST_EXPECT_MSG_EQ (*it, expected[i], "Unexpected frame for " << dest << " TID " << +tid);
+            }
+          NS_TEST_EXPECT_MSG_EQ (i, expected.size (), "Missing frames for " << dest << " TID " << +tid);
+          // resume the search from every position of the queue
+          for (auto pos = m_queue->begin (); pos != m_queue->end (); pos++)
+            {
+              auto expectedIt = pos;
+              while (expectedIt != m_queue->end ()
+                     && !((*expectedIt)->GetHeader ().GetAddr1 () == dest
+                          && (*expectedIt)->GetHeader ().GetQosTid () == tid))
+                {
+                  expectedIt++;
+                }
+              NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByTidAndAddress (tid, dest, pos) == expectedIt), true,
+                                     "Unexpected frame when resuming the search for " << dest);
+            }
+        }
+    }
+}
+
+void
+WifiMacQueueTidAddressTest::EnqueueLater ()
+{
+  m_queue->Enqueue (CreateItem (0, m_receivers[0]));
+  m_queue->PushFront (CreateItem (0, m_receivers[1]));
+}
+
+void
+WifiMacQueueTidAddressTest::CheckExpired ()
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_receivers[0]), 1,
+                         "The expired frames should have been removed");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 2, "Unexpected number of frames");
+  CheckLookups ();
+}
+
+void
+WifiMacQueueTidAddressTest::DoRun ()
+{
+  m_queue = CreateObject<WifiMacQueue> (AC_BE);
+  m_queue->SetMaxSize (QueueSize ("100p"));
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      m_receivers.push_back (Mac48Address::Allocate ());
+    }
+
+  // frames enqueued at time 0, pushed at the front and inserted in the middle
+  for (uint32_t i = 0; i < 12; i++)
+    {
+      m_queue->Enqueue (CreateItem (i % 2, m_receivers[i % 3]));
+    }
+  m_queue->PushFront (CreateItem (0, m_receivers[2]));
+  m_queue->PushFront (CreateItem (1, m_receivers[0]));
+  m_queue->Insert (std::next (m_queue->begin (), 5), CreateItem (0, m_receivers[1]));
+  m_queue->Insert (std::next (m_queue->begin (), 9), CreateItem (1, m_receivers[2]));
+  CheckLookups ();
+
+  // dequeue frames at both ends and in the middle
+  m_queue->DequeueIfQueued (*m_queue->begin ());
+  m_queue->DequeueIfQueued (*std::prev (m_queue->end ()));
+  m_queue->DequeueIfQueued (*std::next (m_queue->begin (), 4));
+  m_queue->Remove (std::next (m_queue->begin (), 6));
+  CheckLookups ();
+
+  // frames enqueued later survive the expiration of the first ones
+  Simulator::Schedule (MilliSeconds (5), &WifiMacQueueTidAddressTest::EnqueueLater, this);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueTidAddressTest::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -123,6 +279,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
   : TestSuite ("wifi-mac-queue", UNIT)
 {
   AddTestCase (new WifiMacQueueDropOldestTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueTidAddressTest, TestCase::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
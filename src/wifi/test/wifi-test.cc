@@ -49,6 +49,8 @@
 #include "ns3/wifi-psdu.h"
 #include "ns3/vht-phy.h"
 #include "ns3/waypoint-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/boolean.h"
 #include "ns3/frame-exchange-manager.h"
 #include "ns3/wifi-default-protection-manager.h"
 #include "ns3/wifi-default-ack-manager.h"
@@ -3148,6 +3150,142 @@ HeRuMcsDataRateTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "Data rate verification for RUs above 52-tone RU (included) failed");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that culling the PHYs out of range in YansWifiChannel does
+ * not change which PHYs receive the frames, with static and moving nodes.
+ */
+class YansWifiChannelRangeCullingTest : public TestCase
+{
+public:
+  YansWifiChannelRangeCullingTest ();
+
+  void DoRun (void) override;
+
+private:
+  /**
+   * Run the scenario.
+   * \param culling whether range culling is enabled
+   * \return the number of frames received by each node
+   */
+  std::vector<uint32_t> RunScenario (bool culling);
+  /**
+   * Broadcast one packet, and schedule the next one.
+   * \param dev the device
+   */
+  void SendOnePacket (Ptr<WifiNetDevice> dev);
+  /**
+   * Notify a successful reception.
+   * \param context the node index
+   * \param p the packet
+   */
+  void NotifyRxEnd (std::string context, Ptr<const Packet> p);
+
+  std::vector<uint32_t> m_received; ///< number of frames received by each node
+};
+
+YansWifiChannelRangeCullingTest::YansWifiChannelRangeCullingTest ()
+  : TestCase ("Test YansWifiChannel range culling")
+{
+}
+
+void
+YansWifiChannelRangeCullingTest::SendOnePacket (Ptr<WifiNetDevice> dev)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  dev->Send (p, dev->GetBroadcast (), 1);
+  Simulator::Schedule (MilliSeconds (50), &YansWifiChannelRangeCullingTest::SendOnePacket, this, dev);
+}
+
+void
+YansWifiChannelRangeCullingTest::NotifyRxEnd (std::string context, Ptr<const Packet> p)
+{
+  m_received[std::stoul (context)]++;
+}
+
+std::vector<uint32_t>
+YansWifiChannelRangeCullingTest::RunScenario (bool culling)
+{
+  const uint32_t nNodes = 30;
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default ();
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("EnableRangeCulling", BooleanValue (culling));
+  // Refresh rarely, so that queries rely on course changes and on the
+  // speed bound to find the moving nodes.
+  channel->SetAttribute ("IndexRefreshInterval", TimeValue (Seconds (100)));
+
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 100);
+
+  // Half of the nodes stand still, the other half cross the area.
+  // Positions are spread over a 1500 m x 300 m area, the same in both runs.
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      positionAlloc->Add (Vector ((i * 557) % 1500, (i * 97) % 300, 0));
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (nodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<ConstantVelocityMobilityModel> model = nodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ();
+      double speed = (i % 2 == 0) ? 0 : 30;
+      model->SetVelocity (Vector ((i % 4 == 1) ? speed : -speed, 0, 0));
+      if (i % 3 == 0)
+        {
+          // A course change, which the index must notice.
+          Simulator::Schedule (Seconds (1), &ConstantVelocityMobilityModel::SetVelocity, model, Vector (0, 40, 0));
+        }
+    }
+
+  m_received.assign (nNodes, 0);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice> (devices.Get (i));
+      dev->GetPhy ()->TraceConnect ("PhyRxEnd", std::to_string (i), MakeCallback (&YansWifiChannelRangeCullingTest::NotifyRxEnd, this));
+      Simulator::Schedule (MilliSeconds (100 + 7 * i), &YansWifiChannelRangeCullingTest::SendOnePacket, this, dev);
+    }
+
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_received;
+}
+
+void
+YansWifiChannelRangeCullingTest::DoRun (void)
+{
+  std::vector<uint32_t> expected = RunScenario (false);
+  std::vector<uint32_t> received = RunScenario (true);
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (received[i], expected[i], "Node " << i << " received a different number of frames with culling");
+      total += expected[i];
+    }
+  // Nodes should neither all be in range nor all be out of range.
+  NS_TEST_EXPECT_MSG_GT (total, 0, "Frames should be received");
+  NS_TEST_EXPECT_MSG_LT (total, 58 * expected.size () * (expected.size () - 1), "Some nodes should be out of range");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3180,6 +3318,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new IdealRateManagerChannelWidthTest, TestCase::QUICK);
   AddTestCase (new IdealRateManagerMimoTest, TestCase::QUICK);
   AddTestCase (new HeRuMcsDataRateTestCase, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelRangeCullingTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -328,6 +328,37 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+benchPacketTags (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  BenchTag<1> ttl;
+  BenchTag<4> flowId;
+  BenchTag<8> timestamp;
+  BenchTag<32> txVector;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // A packet going down the stack, then relayed by a node
+      Ptr<Packet> p = Create<Packet> (500);
+      p->AddPacketTag (flowId);
+      p->AddPacketTag (timestamp);
+      p->AddHeader (udp);
+      p->AddPacketTag (ttl);
+      p->AddHeader (ipv4);
+      p->RemovePacketTag (ttl);
+      p->AddPacketTag (txVector);
+      Ptr<Packet> q = p->Copy ();
+      q->RemovePacketTag (txVector);
+      q->ReplacePacketTag (flowId);
+      q->RemoveHeader (ipv4);
+      q->AddPacketTag (ttl);
+      q->AddHeader (ipv4);
+      q->RemoveAllPacketTags ();
+    }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -385,6 +416,7 @@ int main (int argc, char *argv[])
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  runBench (&benchPacketTags, n, minIterations, "Benchmark packet tags");
 
   return 0;
 }
@@ -200,11 +200,128 @@ GetRandomStream (std::string filename)
 
 
 
+/// One scheduler operation read from an event trace
+struct TraceRecord
+{
+  EventTrace::Operation op;  ///< operation
+  Scheduler::EventKey key;   ///< key of the event
+};
+
+/**
+ * Load an event trace recorded with DefaultSimulatorImpl::EventTraceFile
+ * \param filename the trace file name
+ * \returns the recorded operations
+ */
+std::vector<TraceRecord>
+LoadTrace (std::string filename)
+{
+  std::vector<TraceRecord> trace;
+  EventTrace reader;
+  if (!reader.OpenRead (filename))
+    {
+      NS_FATAL_ERROR ("Cannot read event trace " << filename);
+    }
+  TraceRecord record;
+  while (reader.Read (record.op, record.key))
+    {
+      trace.push_back (record);
+    }
+  LOGME ("found " << trace.size () << " scheduler operations in " << filename);
+  return trace;
+}
+
+/**
+ * Replay an event trace against one scheduler, and print the timing
+ * \param trace the recorded operations
+ * \param factory the scheduler factory
+ */
+void
+ReplayTrace (const std::vector<TraceRecord> &trace, ObjectFactory factory)
+{
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+  uint64_t mismatches = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (std::vector<TraceRecord>::const_iterator i = trace.begin (); i != trace.end (); ++i)
+    {
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key = i->key;
+      switch (i->op)
+        {
+        case EventTrace::INSERT:
+          scheduler->Insert (ev);
+          break;
+        case EventTrace::REMOVE_NEXT:
+          if (scheduler->RemoveNext ().key.m_uid != ev.key.m_uid)
+            {
+              ++mismatches;
+            }
+          break;
+        case EventTrace::REMOVE:
+          scheduler->Remove (ev);
+          break;
+        }
+    }
+  double simu = time.End ();
+  simu /= 1000;
+
+  LOG (std::left << std::setw (3 * g_fwidth) << factory.GetTypeId ().GetName () <<
+       std::left << std::setw (g_fwidth) << simu <<
+       std::left << std::setw (g_fwidth) << (trace.size () / simu) <<
+       std::left << std::setw (g_fwidth) << (simu / trace.size ()) <<
+       std::left << std::setw (g_fwidth) << mismatches);
+}
+
+/**
+ * Replay an event trace against every scheduler
+ * \param filename the trace file name
+ * \param runs number of replays for each scheduler
+ */
+void
+ReplayAll (std::string filename, uint32_t runs)
+{
+  std::vector<TraceRecord> trace = LoadTrace (filename);
+  std::string schedulers[] = {
+    "ns3::CalendarScheduler",
+    "ns3::HeapScheduler",
+    "ns3::LadderScheduler",
+    "ns3::ListScheduler",
+    "ns3::MapScheduler",
+    "ns3::PriorityQueueScheduler"
+  };
+
+  LOG ("");
+  LOG (std::left << std::setw (3 * g_fwidth) << "Scheduler" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (op/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/op)" <<
+       std::left << std::setw (g_fwidth) << "Mismatches");
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (3 * g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' '));
+  for (uint32_t i = 0; i < sizeof (schedulers) / sizeof (schedulers[0]); ++i)
+    {
+      ObjectFactory factory (schedulers[i]);
+      for (uint32_t j = 0; j < runs; ++j)
+        {
+          ReplayTrace (trace, factory);
+        }
+    }
+  LOG ("");
+}
+
+
 int main (int argc, char *argv[])
 {
 
   bool schedCal           = false;
   bool schedHeap          = false;
+  bool schedLadder        = false;
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
@@ -213,7 +330,9 @@ int main (int argc, char *argv[])
   uint32_t total = 1000000;
   uint32_t runs  =       1;
   std::string filename = "";
+  std::string replay = "";
   bool calRev = false;
+  bool pool = false;
 
   CommandLine cmd (__FILE__);
   cmd.Usage ("Benchmark the simulator scheduler.\n"
@@ -223,10 +342,16 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "\n"
+             "Alternatively, --replay=\"<filename>\" replays against every\n"
+             "scheduler the event list operations recorded from a real\n"
+             "simulation with --ns3::DefaultSimulatorImpl::EventTraceFile.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("calrev", "reverse ordering in the CalendarScheduler", calRev);
+  cmd.AddValue ("pool",  "allocate events from the event pool", pool);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
@@ -235,11 +360,21 @@ int main (int argc, char *argv[])
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
   cmd.AddValue ("file",  "file of relative event times",  filename);
+  cmd.AddValue ("replay", "event trace to replay against every scheduler", replay);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
+  if (replay != "")
+    {
+      LOGME (std::setprecision (g_fwidth - 6));
+      ReplayAll (replay, runs);
+      return 0;
+    }
+
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventPool", BooleanValue (pool));
+
   ObjectFactory factory ("ns3::MapScheduler");
   if (schedCal)
     {
@@ -250,6 +385,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::HeapScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderScheduler");
+    }
   if (schedList)
     {
       factory.SetTypeId ("ns3::ListScheduler");
@@ -270,6 +409,7 @@ int main (int argc, char *argv[])
       order = ": insertion order: " + std::string (calRev ? "reverse" : "normal");
     }
   LOGME ("scheduler: " << factory.GetTypeId ().GetName () << order);
+  LOGME ("event pool: " << (pool ? "enabled" : "disabled"));
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the time taken to set up an ad hoc wifi
+// network of 'n' nodes, from the creation of the nodes to the entry in
+// Simulator::Run, phase by phase.
+// Sample usage:  ./waf --run 'bench-startup --n=10000 --routing=maqr'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/maqr-module.h"
+#include "ns3/gpsr-module.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+using namespace ns3;
+
+/// Wall clock timer of the phases of the setup
+class PhaseTimer
+{
+public:
+  PhaseTimer ()
+    : m_total (0)
+  {
+    m_clock.Start ();
+  }
+  /**
+   * Print the time elapsed since the end of the previous phase.
+   * \param name the name of the phase which just ended
+   */
+  void End (std::string name)
+  {
+    int64_t elapsed = m_clock.End ();
+    m_total += elapsed;
+    std::cout << std::left << std::setw (24) << name
+              << std::right << std::setw (10) << elapsed << " ms" << std::endl;
+    m_clock.Start ();
+  }
+  /**
+   * \returns the sum of the times of all the phases, in ms
+   */
+  int64_t GetTotal (void) const
+  {
+    return m_total;
+  }
+private:
+  SystemWallClockMs m_clock; //!< the clock of the current phase
+  int64_t m_total;           //!< the sum of the times of the ended phases
+};
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000;
+  std::string routing = "maqr";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.AddValue ("routing", "routing protocol: maqr, gpsr or static", routing);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Setting up " << n << " nodes with " << routing << " routing" << std::endl;
+  PhaseTimer timer;
+
+  NodeContainer nodes;
+  nodes.Create (n);
+  timer.End ("nodes");
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (100.0),
+                                 "DeltaY", DoubleValue (100.0),
+                                 "GridWidth", UintegerValue (100));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  timer.End ("mobility");
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211b);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("DsssRate11Mbps"),
+                                "ControlMode", StringValue ("DsssRate11Mbps"));
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss ("ns3::FriisPropagationLossModel");
+  YansWifiPhyHelper wifiPhy;
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiMacHelper wifiMac;
+  wifiMac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (wifiPhy, wifiMac, nodes);
+  timer.End ("wifi");
+
+  InternetStackHelper internet;
+  MaqrHelper maqr;
+  GpsrHelper gpsr;
+  if (routing == "maqr")
+    {
+      internet.SetRoutingHelper (maqr);
+    }
+  else if (routing == "gpsr")
+    {
+      internet.SetRoutingHelper (gpsr);
+    }
+  else if (routing != "static")
+    {
+      NS_FATAL_ERROR ("No such routing protocol: " << routing);
+    }
+  internet.Install (nodes);
+  timer.End ("internet");
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.0.0.0");
+  address.Assign (devices);
+  if (routing == "gpsr")
+    {
+      gpsr.Install ();
+    }
+  timer.End ("addresses");
+
+  // Stop at the first event after the initialization of the nodes
+  Simulator::Stop (NanoSeconds (1));
+  Simulator::Run ();
+  timer.End ("run entry");
+
+  Simulator::Destroy ();
+  timer.End ("destroy");
+
+  std::cout << std::left << std::setw (24) << "total"
+            << std::right << std::setw (10) << timer.GetTotal () << " ms" << std::endl;
+  return 0;
+}